@@ -0,0 +1,36 @@
+/**
+  ******************************************************************************
+  * @file           : audio.h
+  * @brief          : Audio clips streamed to FM receivers as FSK bitstreams.
+  ******************************************************************************
+  */
+
+#ifndef __AUDIO_H
+#define __AUDIO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+// A stretch of a clip: delta-sigma bitstream, sent repeat times in a row
+typedef struct {
+    const uint8_t *data; // first bit in the MSB
+    uint16_t bytes;
+    uint16_t repeat;
+} AudioSegment;
+
+typedef struct {
+    const AudioSegment *segments;
+    uint16_t count;
+    uint32_t bitrate;
+} AudioClip;
+
+void Audio_Play(const AudioClip *clip, int8_t powerdBm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AUDIO_H */
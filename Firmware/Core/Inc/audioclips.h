@@ -0,0 +1,30 @@
+/**
+  ******************************************************************************
+  * @file           : audioclips.h
+  * @brief          : Audio clips as delta-sigma FSK bitstreams.
+  ******************************************************************************
+  * Generated by Tools/audio_encode.py, do not edit.
+  */
+
+#ifndef __AUDIOCLIPS_H
+#define __AUDIOCLIPS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "audio.h"
+
+// Bitrate all the clips were encoded at
+#define AUDIOCLIPS_BITRATE 48000
+
+extern const AudioClip audioClipChord;
+extern const AudioClip audioClipDtmf;
+extern const AudioClip audioClipSweep;
+extern const AudioClip audioClipJingle;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AUDIOCLIPS_H */
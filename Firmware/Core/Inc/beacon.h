@@ -0,0 +1,70 @@
+/**
+  ******************************************************************************
+  * @file           : beacon.h
+  * @brief          : Beacon schedule derived from beacon_config.h.
+  ******************************************************************************
+  */
+
+#ifndef __BEACON_H
+#define __BEACON_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "beacon_config.h"
+#include "config.h"
+#include "rfmath.h"
+#include "morse.h"
+#include <stdbool.h>
+
+// Time taken by each beep ladder, without the gap after its last beep
+#define BEACON_FSK_SPAN (BEACON_FSK_ENABLED ? BEACON_FSK_LENGTH * BEACON_FSK_COUNT + BEACON_FSK_GAP * (BEACON_FSK_COUNT - 1) : 0)
+#define BEACON_CW_SPAN (BEACON_CW_ENABLED ? BEACON_CW_LENGTH * BEACON_CW_COUNT + BEACON_CW_GAP * (BEACON_CW_COUNT - 1) : 0)
+
+// Silence after each ladder, split in two when both ladders are sent
+#define BEACON_GAP_TOTAL (BEACON_PERIOD - BEACON_FSK_SPAN - BEACON_CW_SPAN)
+#define BEACON_GAP (BEACON_FSK_ENABLED && BEACON_CW_ENABLED ? BEACON_GAP_TOTAL / 2 : BEACON_GAP_TOTAL)
+
+// Beacon cycles per callsign period
+#define BEACON_LOOP_COUNTER (BEACON_CALLSIGN_PERIOD * 1000 / BEACON_PERIOD)
+
+#define BEACON_RF_FREQ RF_FREQ_WORD(BEACON_CENTER_FREQ, BEACON_FREQ_CORRECTION)
+
+// One beacon cycle as a radio script, see radioscript.h
+extern const uint8_t beaconCycle[];
+
+// What main() runs: beaconCycle, or a copy rebuilt for the runtime settings
+typedef struct {
+    const uint8_t *cycle;
+    uint32_t rfFreq;      // center frequency word, for the callsign
+    uint32_t gap;         // ms
+    uint32_t loopCounter; // beacon cycles per callsign period
+    const uint8_t *callsign; // compiled by Morse_Compile()
+    MorseTiming morse;
+} BeaconSchedule;
+
+extern BeaconSchedule beacon;
+
+typedef enum {
+    BEACON_PHASE_CALLSIGN, // callsign and the gap after it
+    BEACON_PHASE_CYCLES,   // beacon cycles until the next callsign
+} BeaconPhase;
+
+// Where main()'s loop is, kept through resets by Boot_SavePosition()
+typedef struct {
+    BeaconPhase phase;
+    uint32_t cycle;  // next cycle of the callsign period
+    uint32_t cycles; // cycles sent since power-on
+} BeaconPosition;
+
+bool Beacon_Check(const BeaconConfig *cfg);
+void Beacon_Apply(const BeaconConfig *cfg);
+void Beacon_SetPowerCap(int32_t dBm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BEACON_H */
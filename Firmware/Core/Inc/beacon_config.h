@@ -0,0 +1,79 @@
+/**
+  ******************************************************************************
+  * @file           : beacon_config.h
+  * @brief          : Beacon settings.
+  ******************************************************************************
+  * Everything here is a compile-time constant. beacon.c turns the settings
+  * into the beacon schedule table in flash and refuses to build if they do
+  * not make sense (beeps longer than the period, wrong number of custom
+  * tones, powers out of range, ...).
+  */
+
+#ifndef __BEACON_CONFIG_H
+#define __BEACON_CONFIG_H
+
+// ==========================================
+//      START CHANGING SETTINGS HERE
+// ==========================================
+
+// Frequency setting in Hz
+// Can be a "standard" frequency from main.c, e.g. LPD433 channel 20 = 433550000
+#define BEACON_CENTER_FREQ 433225000
+
+// max power in dBm, valid values between -17 and 22;
+// If using coin cell batteries, values above 16 dBm are not recommended without testing due to current limitations.
+// Alternatively use external LiPo power
+#define BEACON_MAX_POWER 10
+
+#define BEACON_FREQ_CORRECTION -4601 // For tuning frequency, in ppb (parts per billion)
+
+#define BEACON_CALLSIGN_ENABLED 0
+#define BEACON_CALLSIGN "nocall"
+
+#define BEACON_CALLSIGN_PERIOD 300 // seconds
+#define BEACON_MORSE_WPM 17 // callsign speed in words per minute (PARIS), 17 WPM is a 70 ms dit
+#define BEACON_MORSE_FARNSWORTH_WPM 17 // lower than BEACON_MORSE_WPM to space the characters out (Farnsworth timing)
+#define BEACON_MORSE_PACKET 0 // if 1, send the callsign from the radio packet buffer: crystal timed, but the carrier stays on between elements
+#define BEACON_AUDIO_ENABLED 0 // if 1, play an audio clip after the callsign (FM receivers)
+#define BEACON_AUDIO_CLIP audioClipJingle // from audioclips.c, made by Tools/audio_encode.py
+#define BEACON_WSPR_ENABLED 0 // if 1, send the WSPR message of wsprmessage.c (Tools/wspr_encode.py) every callsign period, 110.6 s long
+#define BEACON_WSPR_FREQ 432301500 // Hertz, center of the WSPR signal; 70 cm WSPR is 432.300 MHz USB dial + 1400..1600 Hz
+
+// Continuous Wave (CW) settings
+#define BEACON_CW_ENABLED 0
+#define BEACON_CW_COUNT 4
+#define BEACON_CW_HIGH2LOW 1 //if 1, start with highest power beep, decrease from there
+#define BEACON_CW_OFFSET 150 //Hertz
+#define BEACON_CW_LENGTH 20 //milliseconds
+#define BEACON_CW_GAP 20 //milliseconds
+#define BEACON_CW_CHIRP_SPAN 0 //Hertz, if not 0 every CW beep sweeps this far up (down if negative) from its frequency
+#define BEACON_CW_CHIRP_STEP_US 1000 //microseconds per frequency step of the sweep, see the 'h' console command for what the radio keeps up with
+
+// Frequency-shift keying (FSK) settings. Can be heard with FM receivers
+#define BEACON_FSK_ENABLED 1
+#define BEACON_FSK_COUNT 3
+#define BEACON_FSK_HIGH2LOW 0 //if 1, start with highest power beep, decrease from there. When 1, it maximizes the power of the highest power beep, but makes it harder to read a visible signal indicator on later beeps.
+#define BEACON_FSK_LENGTH 250 //milliseconds
+#define BEACON_FSK_GAP 50 //milliseconds
+#define BEACON_FSK_CUSTOM_TONES 0
+#define BEACON_FSK_CUSTOM_FREQUENCIES 320, 400, 480 // Must have BEACON_FSK_COUNT entries!
+
+// Supply measured late in the strongest beep. Below SAG_LOW the top of the power ladders is lowered,
+// above SAG_HIGH it is raised again up to BEACON_MAX_POWER. Keeps coin cells out of brownout resets.
+#define BEACON_SAG_LOW_MV 2100
+#define BEACON_SAG_HIGH_MV 2300
+
+#define BEACON_PERIOD 2000 //milliseconds
+#define BEACON_STARTUP_WAIT 5000 // initial start after power-on, with the LED on. Also the longest wait after other resets.
+#define BEACON_BOOT_MIN_MV 2700 // after a brownout or other reset, start as soon as the supply has recovered to this and stopped rising
+
+// ==========================================
+//      STOP CHANGING SETTINGS HERE
+// ==========================================
+
+// Host builds of Tools/beacon_sim.py #undef and redefine settings in a header of their own
+#ifdef BEACON_CONFIG_OVERRIDE
+#include BEACON_CONFIG_OVERRIDE
+#endif
+
+#endif /* __BEACON_CONFIG_H */
@@ -0,0 +1,42 @@
+/**
+  ******************************************************************************
+  * @file           : boot.h
+  * @brief          : Reset cause and the wait for the supply before beaconing.
+  ******************************************************************************
+  */
+
+#ifndef __BOOT_H
+#define __BOOT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "beacon.h"
+#include <stdbool.h>
+
+typedef struct {
+    uint32_t resetFlags; // RCC_CSR bits 31..24
+    bool warm;           // RAM survived the reset, not a power-on
+    uint32_t waitMs;     // in Boot_WaitForSupply()
+    uint32_t supplyMv;   // when the wait ended, 0 if not measured
+    bool resumed;        // the beacon loop continued where it was
+} BootInfo;
+
+extern BootInfo bootInfo;
+
+void Boot_Init(void);
+void Boot_WaitForSupply(void);
+bool Boot_Resume(BeaconPosition *position);
+void Boot_SavePosition(const BeaconPosition *position);
+bool Boot_ResumePowerCap(int32_t *dBm);
+void Boot_SavePowerCap(int32_t dBm);
+uint32_t Boot_FirstBeepMs(void);
+void Boot_Dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BOOT_H */
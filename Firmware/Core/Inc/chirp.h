@@ -0,0 +1,39 @@
+/**
+  ******************************************************************************
+  * @file           : chirp.h
+  * @brief          : Carrier swept through a table of frequency steps in one transmission.
+  ******************************************************************************
+  */
+
+#ifndef __CHIRP_H
+#define __CHIRP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdbool.h>
+
+// Step timing of the chirps since reset, from the TIM16 interrupt
+typedef struct {
+    uint32_t chirps;
+    uint32_t steps;       // frequency words sent
+    uint32_t overruns;    // steps still on the SPI when the next one was due
+    uint32_t maxCycles;   // longest step, core cycles
+    uint32_t totalCycles;
+} ChirpStats;
+
+extern ChirpStats chirpStats;
+
+void Chirp_Init(void);
+void Chirp_Build(int32_t *table, uint16_t count, int32_t spanHz, uint32_t stepUs);
+void Chirp_Tx(uint32_t rfFreq, uint32_t lengthMs);
+void Chirp_Dump(void);
+void Chirp_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CHIRP_H */
@@ -0,0 +1,26 @@
+/**
+  ******************************************************************************
+  * @file           : clock.h
+  * @brief          : MSI idle clock with on-demand HSE.
+  ******************************************************************************
+  */
+
+#ifndef __CLOCK_H
+#define __CLOCK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+void Clock_Init(void);
+void Clock_RequestHSE(void);
+void Clock_ReleaseHSE(void);
+void Clock_RestoreAfterStop(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CLOCK_H */
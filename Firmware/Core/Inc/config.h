@@ -0,0 +1,68 @@
+/**
+  ******************************************************************************
+  * @file           : config.h
+  * @brief          : Runtime settings stored in the emulated EEPROM.
+  ******************************************************************************
+  */
+
+#ifndef __CONFIG_H
+#define __CONFIG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "beacon_config.h"
+#include <stdbool.h>
+
+// Bump when fields are added. New fields go at the end of BeaconConfig, so
+// a record written by an older version loads with them at their default.
+#define CONFIG_VERSION 2
+
+#define CONFIG_CALLSIGN_SIZE 16 // including the terminating NUL
+
+// Settings that can be changed without reflashing. Every field is one or
+// more 32 bit words, stored as consecutive EEPROM variables.
+typedef struct {
+    uint32_t centerFreq;     // Hz
+    int32_t freqCorrection;  // ppb
+    int32_t maxPower;        // dBm
+    uint32_t period;         // ms
+    uint32_t callsignEnabled;
+    uint32_t callsignPeriod; // s
+    char callsign[CONFIG_CALLSIGN_SIZE];
+    uint32_t morseWpm;           // character speed, version 2
+    uint32_t morseFarnsworthWpm; // overall speed, at most morseWpm
+} BeaconConfig;
+
+#define CONFIG_WORDS (sizeof(BeaconConfig) / 4)
+
+typedef enum {
+    CONFIG_OK,          // loaded from the EEPROM
+    CONFIG_NO_EEPROM,   // EEPROM emulation unavailable, defaults
+    CONFIG_BLANK,       // nothing stored yet, defaults
+    CONFIG_BAD_VERSION, // written by a newer firmware, defaults
+    CONFIG_BAD_CRC,     // torn or corrupted record, defaults
+    CONFIG_INVALID,     // out of range values, defaults
+} ConfigStatus;
+
+extern BeaconConfig config;
+extern ConfigStatus configStatus;
+extern uint32_t configInitUs; // EE_Init() at boot, includes any page recovery
+extern uint32_t configLoadUs; // reading and checking the record
+
+void Config_Defaults(BeaconConfig *cfg);
+bool Config_Check(const BeaconConfig *cfg);
+ConfigStatus Config_Load(void);
+bool Config_Save(void);
+void Config_Dump(void);
+void Config_Set(void);
+void Config_Write(void);
+void Config_Reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CONFIG_H */
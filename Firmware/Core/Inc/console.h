@@ -0,0 +1,28 @@
+/**
+  ******************************************************************************
+  * @file           : console.h
+  * @brief          : Single-key command console on USART2.
+  ******************************************************************************
+  */
+
+#ifndef __CONSOLE_H
+#define __CONSOLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdbool.h>
+
+void Console_Init(void);
+void Console_Poll(void);
+void Console_Printf(const char *format, ...);
+bool Console_ReadLine(char *buf, uint16_t size);
+void Console_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CONSOLE_H */
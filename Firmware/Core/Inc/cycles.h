@@ -0,0 +1,27 @@
+/**
+  ******************************************************************************
+  * @file           : cycles.h
+  * @brief          : Core cycle counter for timing code on the target.
+  ******************************************************************************
+  */
+
+#ifndef __CYCLES_H
+#define __CYCLES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+// Read the counter with DWT->CYCCNT after Cycles_Enable(). It only counts
+// while the core is clocked, not in Sleep or Stop2.
+void Cycles_Enable(void);
+uint32_t Cycles_ToUs(uint32_t cycles);
+uint32_t Cycles_ToMs(uint32_t cycles);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CYCLES_H */
@@ -0,0 +1,55 @@
+/**
+  ******************************************************************************
+  * @file           : energy.h
+  * @brief          : Time-in-state ledger and charge estimate.
+  ******************************************************************************
+  */
+
+#ifndef __ENERGY_H
+#define __ENERGY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "radio.h"
+#include <stdbool.h>
+
+// Range of the per-dBm TX counters, the range of SetOutputPower()
+#define ENERGY_TX_MIN_DBM (-17)
+#define ENERGY_TX_MAX_DBM 22
+#define ENERGY_TX_LEVELS (ENERGY_TX_MAX_DBM - ENERGY_TX_MIN_DBM + 1)
+
+typedef struct {
+    uint32_t startTick;                      // HAL tick of the last reset
+    uint32_t cpuStopMs;                      // in Stop2, the rest of the uptime is Run
+    uint32_t ledMs;
+    uint32_t radioMs[RADIO_POWER_STATES];    // radio idle states
+    uint32_t txMs[ENERGY_TX_LEVELS];         // transmitting, per output dBm
+} EnergyLedger;
+
+// Typical currents in uA. Calibrate against a bench measurement of the board.
+typedef struct {
+    uint32_t cpuRun;
+    uint32_t cpuStop;
+    uint32_t led;
+    uint32_t radio[RADIO_POWER_STATES];
+} EnergyCurrents;
+
+extern EnergyLedger energyLedger;
+extern EnergyCurrents energyCurrents;
+
+void Energy_Reset(void);
+void Energy_AddStop(uint32_t ms);
+void Energy_Led(bool on);
+void Energy_Radio(RadioPowerState state);
+void Energy_RadioTx(int8_t powerdBm);
+uint32_t Energy_TxCurrent(int8_t powerdBm);
+void Energy_Dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ENERGY_H */
@@ -0,0 +1,47 @@
+/**
+  ******************************************************************************
+  * @file           : flashwork.h
+  * @brief          : Flash erases deferred to radio idle windows.
+  ******************************************************************************
+  */
+
+#ifndef __FLASHWORK_H
+#define __FLASHWORK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdbool.h>
+
+typedef enum {
+    FLASHWORK_EE_CLEANUP, // erase the pages left by an EEPROM page transfer
+    FLASHWORK_LOG_ERASE,  // erase the oldest flight log page
+    FLASHWORK_JOBS
+} FlashWorkJob;
+
+typedef struct {
+    uint32_t runs;
+    uint32_t lastMs;
+    uint32_t maxPageMs;   // slowest page erase seen, sizes the windows
+    uint32_t deferred;    // idle windows too short for the pending work
+    uint32_t errors;
+} FlashWorkStats;
+
+extern FlashWorkStats flashWorkStats;
+
+void FlashWork_Init(void);
+void FlashWork_Unlock(void);
+void FlashWork_Lock(void);
+void FlashWork_Request(FlashWorkJob job);
+bool FlashWork_Pending(FlashWorkJob job);
+void FlashWork_RunUntil(uint32_t tick);
+void FlashWork_Flush(void);
+void FlashWork_Dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FLASHWORK_H */
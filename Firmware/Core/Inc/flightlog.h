@@ -0,0 +1,54 @@
+/**
+  ******************************************************************************
+  * @file           : flightlog.h
+  * @brief          : Ring log of beacon and power events in flash.
+  ******************************************************************************
+  */
+
+#ifndef __FLIGHTLOG_H
+#define __FLIGHTLOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdbool.h>
+
+// Record types, kept in sync with Tools/flightlog_decode.py
+typedef enum {
+    FLIGHTLOG_PAGE = 0x01, // first record of a page, value = page sequence number
+    FLIGHTLOG_BOOT,        // value = boot number
+    FLIGHTLOG_RESET,       // value = reset flags, RCC_CSR bits 31..24
+    FLIGHTLOG_CONFIG,      // value = ConfigStatus
+    FLIGHTLOG_CYCLES,      // value = beacon cycles since power-on
+    FLIGHTLOG_SUPPLY,      // value = mV
+    FLIGHTLOG_LATE,        // value = worst beep start delay since boot, ms
+    FLIGHTLOG_DROPPED,     // value = records lost to a full RAM buffer
+    FLIGHTLOG_STARTUP,     // value = startup wait, ms; logged when the supply is up
+    FLIGHTLOG_FIRST_BEEP,  // value = ms from reset to the first beep
+    FLIGHTLOG_RESUME,      // value = cycle the beacon loop continued with, 0 for the callsign
+    FLIGHTLOG_POWER_CAP,   // value = new top of the power ladders, dBm as int8_t
+} FlightLogType;
+
+typedef struct {
+    uint32_t written;  // records programmed since boot
+    uint32_t dropped;
+    uint32_t errors;   // failed programs, the slot is skipped
+} FlightLogStats;
+
+extern FlightLogStats flightLogStats;
+
+void FlightLog_Init(void);
+void FlightLog_Add(FlightLogType type, uint32_t value);
+void FlightLog_Checkpoint(uint32_t cycles);
+void FlightLog_Commit(void);
+bool FlightLog_StartErase(void);
+void FlightLog_EraseDone(void);
+void FlightLog_Dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FLIGHTLOG_H */
@@ -0,0 +1,32 @@
+/**
+  ******************************************************************************
+  * @file           : lowpower.h
+  * @brief          : Tickless Stop2 delays timed by LPTIM1.
+  ******************************************************************************
+  */
+
+#ifndef __LOWPOWER_H
+#define __LOWPOWER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdbool.h>
+
+void LowPower_Init(void);
+bool LowPower_CalibrateLsi(void);
+uint32_t LowPower_LsiHz(void);
+uint32_t LowPower_Sleep(uint32_t ms);
+void LowPower_Delay(uint32_t ms);
+void LowPower_SleepUntil(uint32_t tick);
+void LowPower_RequestRun(void);
+void LowPower_ReleaseRun(void);
+void LowPower_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LOWPOWER_H */
@@ -0,0 +1,47 @@
+/**
+  ******************************************************************************
+  * @file           : morse.h
+  * @brief          : Callsign compiled into a key-down / key-up timing stream.
+  ******************************************************************************
+  */
+
+#ifndef __MORSE_H
+#define __MORSE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdbool.h>
+
+// Stream bytes: a run kind and its length in units, MORSE_END terminates
+#define MORSE_END        0x00
+#define MORSE_KEY_UP     0x00 // | dit units, between the elements of a character
+#define MORSE_SPACE      0x40 // | spacing units, between characters (3) and words (7)
+#define MORSE_KEY_DOWN   0x80 // | dit units, a dit (1) or a dah (3)
+#define MORSE_KIND_MASK  0xC0
+#define MORSE_UNITS_MASK 0x3F
+
+// Worst case stream size for a text of len characters: 7 elements with the
+// gaps between them and the space after, plus MORSE_END
+#define MORSE_STREAM_SIZE(len) (14 * (len) + 1)
+
+typedef struct {
+    uint32_t ditMs;   // element unit, 1200 / WPM
+    uint32_t spaceMs; // character and word spacing unit, longer for Farnsworth
+} MorseTiming;
+
+extern const uint8_t morse_chars[];
+
+MorseTiming Morse_Timing(uint32_t wpm, uint32_t farnsworthWpm);
+bool Morse_Compile(const char *text, uint8_t *stream, uint16_t size);
+uint32_t Morse_DurationMs(const uint8_t *stream, const MorseTiming *timing);
+void Morse_Play(const uint8_t *stream, const MorseTiming *timing, int8_t powerdBm, bool useCw);
+void Morse_PlayPacket(const uint8_t *stream, const MorseTiming *timing, int8_t powerdBm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MORSE_H */
@@ -0,0 +1,39 @@
+/**
+  ******************************************************************************
+  * @file           : powerctl.h
+  * @brief          : Power ladder cap following the supply under TX load.
+  ******************************************************************************
+  */
+
+#ifndef __POWERCTL_H
+#define __POWERCTL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdbool.h>
+
+typedef struct {
+    int32_t capDbm;    // top of the power ladders, 22 when not limited
+    uint32_t lastMv;   // supply late in the last strongest beep, 0 if not measured
+    uint32_t minMv;
+    uint32_t samples;
+    uint32_t lowered;
+    uint32_t raised;
+} PowerCtl;
+
+extern PowerCtl powerCtl;
+
+void PowerCtl_Init(void);
+bool PowerCtl_WantSample(int8_t dBm, uint32_t lengthMs);
+void PowerCtl_TxSample(int8_t dBm, uint32_t mv);
+void PowerCtl_Update(void);
+void PowerCtl_Dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __POWERCTL_H */
@@ -0,0 +1,141 @@
+/**
+  ******************************************************************************
+  * @file           : radio.h
+  * @brief          : SUBGHZ radio commands with a shadow copy of the radio state.
+  ******************************************************************************
+  */
+
+#ifndef __RADIO_H
+#define __RADIO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "rfmath.h"
+#include <stdbool.h>
+
+typedef struct {
+    uint32_t issued;          // commands sent over the SUBGHZ SPI
+    uint32_t suppressed;      // commands skipped because the radio already had the values
+    uint32_t bytesIssued;     // opcode + parameter bytes sent
+    uint32_t bytesSuppressed; // opcode + parameter bytes not sent
+} RadioStats;
+
+// Radio regulator for SetRegulatorMode(), 0x00 LDO or 0x01 SMPS. The SMPS
+// needs an inductor on VLXSMPS, which the beacon boards leave unconnected.
+#ifndef RADIO_REGULATOR_MODE
+#define RADIO_REGULATOR_MODE 0x00
+#endif
+
+// Define RADIO_USE_LP_PA on boards that have RFO_LP matched and connected to
+// let SetOutputPower() use the low power PA up to 15 dBm. The beacon boards
+// only use RFO_HP.
+
+// SetPaConfig optimal settings from the reference manual, as constant
+// expressions of the wanted output power. With them the PA gives the row's
+// nominal power at RADIO_PA_REF and about 1 dB less per step below it. The
+// row picked is the lowest-current one that reaches the power. The +10 dBm
+// LP row is specified at a SetTxParams power of 13, the other LP rows at 14.
+#ifdef RADIO_USE_LP_PA
+#define RADIO_PA_LP(dBm) ((dBm) <= 15)
+#define RADIO_PA_NOMINAL(dBm) ((dBm) <= 10 ? 10 : (dBm) <= 14 ? 14 : (dBm) <= 15 ? 15 : \
+                               (dBm) <= 17 ? 17 : (dBm) <= 20 ? 20 : 22)
+#else
+#define RADIO_PA_LP(dBm) 0
+#define RADIO_PA_NOMINAL(dBm) ((dBm) <= 14 ? 14 : (dBm) <= 17 ? 17 : (dBm) <= 20 ? 20 : 22)
+#endif
+#define RADIO_PA_DUTY(dBm) (RADIO_PA_LP(dBm) ? \
+    (RADIO_PA_NOMINAL(dBm) == 10 ? 0x01 : RADIO_PA_NOMINAL(dBm) == 14 ? 0x04 : 0x06) : \
+    (RADIO_PA_NOMINAL(dBm) <= 17 ? 0x02 : RADIO_PA_NOMINAL(dBm) == 20 ? 0x03 : 0x04))
+#define RADIO_PA_HPMAX(dBm) (RADIO_PA_LP(dBm) ? 0x00 : \
+    (RADIO_PA_NOMINAL(dBm) == 14 ? 0x02 : RADIO_PA_NOMINAL(dBm) == 17 ? 0x03 : \
+     RADIO_PA_NOMINAL(dBm) == 20 ? 0x05 : 0x07))
+#define RADIO_PA_REF(dBm) (RADIO_PA_LP(dBm) ? (RADIO_PA_NOMINAL(dBm) == 10 ? 13 : 14) : 22) // SetTxParams power giving the nominal power
+#define RADIO_PA_MIN(dBm) (RADIO_PA_LP(dBm) ? -17 : -9)  // lowest SetTxParams power of the PA
+#define RADIO_TX_POWER_RAW(dBm) (RADIO_PA_REF(dBm) - (RADIO_PA_NOMINAL(dBm) - (dBm)))
+#define RADIO_TX_POWER(dBm) (RADIO_TX_POWER_RAW(dBm) < RADIO_PA_MIN(dBm) ? RADIO_PA_MIN(dBm) : \
+                             RADIO_TX_POWER_RAW(dBm) > RADIO_PA_REF(dBm) ? RADIO_PA_REF(dBm) : RADIO_TX_POWER_RAW(dBm))
+
+// Parameter bytes of SetPaConfig (0x95) and SetTxParams (0x8E, 40 us ramp)
+#define RADIO_PA_CONFIG_PARAMS(dBm) RADIO_PA_DUTY(dBm), RADIO_PA_HPMAX(dBm), RADIO_PA_LP(dBm), 0x01
+#define RADIO_TX_PARAMS(dBm) (uint8_t) (RADIO_TX_POWER(dBm)), 0x02
+
+// Big endian parameter bytes of 24 and 32 bit radio words
+#define RADIO_BYTES24(word) (uint8_t) (((word) >> 16) & 0xFF), (uint8_t) (((word) >> 8) & 0xFF), (uint8_t) ((word) & 0xFF)
+#define RADIO_BYTES32(word) (uint8_t) (((word) >> 24) & 0xFF), RADIO_BYTES24(word)
+
+// Parameter bytes of SetModulationParams (0x8B) in FSK mode
+#define RADIO_FSK_MOD_PARAMS(bitrate, pulseshape, bandwidth, freqDevHz) \
+    RADIO_BYTES24(FSK_BITRATE_WORD(bitrate)), (pulseshape), (bandwidth), RADIO_BYTES24(FSK_FDEV_WORD(freqDevHz))
+
+// Radio idle states, from the fastest to wake up to the lowest current
+typedef enum {
+    RADIO_STDBY_XOSC = 0, // crystal running, ready to transmit
+    RADIO_STDBY_RC,       // crystal off
+    RADIO_SLEEP,          // warm start, configuration retained
+    RADIO_POWER_STATES
+} RadioPowerState;
+
+typedef struct {
+    uint32_t lastUs; // last wake-up to STDBY_XOSC, used to plan the next one
+    uint32_t maxUs;
+    uint32_t count;
+} RadioWakeCost;
+
+// How late Radio_Delay() returned, i.e. how late the next beep started
+typedef struct {
+    uint32_t count;
+    uint32_t lateCount;
+    uint32_t maxLateMs;
+    uint32_t firstTxTick; // HAL tick of the first transmission since reset
+} RadioTiming;
+
+extern RadioStats radioStats;
+extern volatile bool radioTxDone;
+extern RadioWakeCost radioWakeCost[RADIO_POWER_STATES];
+extern uint32_t radioIdleMs[RADIO_POWER_STATES];
+extern RadioTiming radioTiming;
+
+HAL_StatusTypeDef Radio_ExecSetCmd(uint8_t opcode, uint8_t *params, uint16_t size);
+void Radio_InvalidateShadow();
+void Radio_ResetStats();
+
+void SetStandbyXOSC();
+void SetStandbyRC();
+void SetSleep(uint8_t config);
+void SetPacketTypeLora();
+void SetPacketTypeFSK();
+void SetRfFreq(uint32_t rfFreq);
+void SetPaLowPower();
+void SetPa22dB();
+void SetTxPower(int8_t powerdBm);
+void SetRegulatorMode(uint8_t mode);
+void SetOutputPower(int8_t powerdBm);
+void SetContinuousWave();
+void SetTxInfinitePreamble();
+void SetTx(uint32_t timeout);
+void SetRx(uint32_t timeout);
+void SetTxRxFallbackMode(uint8_t mode);
+void SetDioIrqParams(uint16_t irqMask, uint16_t dio1Mask, uint16_t dio2Mask, uint16_t dio3Mask);
+void SetModulationParamsLora(const uint8_t params[4]);
+void SetModulationParamsFSK(uint32_t bitrate, uint8_t pulseshape, uint8_t bandwidth, uint32_t freq_dev);
+void SetPacketParamsLora(uint16_t preamble_length, bool header_fixed, uint8_t payload_length, bool crc_enabled, bool invert_iq);
+void SetPacketParamsFSK(uint16_t preamble_length, uint8_t payload_length);
+void SetBufferBaseAddress(uint8_t txBase, uint8_t rxBase);
+void WriteBuffer(uint8_t offset, const uint8_t *data, uint8_t len);
+void TimedTx(uint32_t lengthMs);
+void Radio_StartTx(uint32_t lengthMs);
+void Radio_StartCw(uint32_t lengthMs);
+void Radio_SampleTxSupply(uint32_t lengthMs);
+void Radio_SleepTx(void);
+void Radio_WaitTx(void);
+void Radio_Delay(uint32_t ms);
+RadioPowerState Radio_IdleStateFor(uint32_t ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RADIO_H */
@@ -0,0 +1,54 @@
+/**
+  ******************************************************************************
+  * @file           : radiopacket.h
+  * @brief          : Tone sequences clocked out of the radio buffer as FSK packets.
+  ******************************************************************************
+  */
+
+#ifndef __RADIOPACKET_H
+#define __RADIOPACKET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdbool.h>
+
+// Each half of the radio buffer holds one packet
+#define RADIOPACKET_HALF_SIZE 128
+#define RADIOPACKET_PREAMBLE_BITS 8
+
+// A stream packet fills the whole buffer. The SUBGHZ SPI (125 kHz) writes
+// a buffer half in about 9 ms, which must fit into the time the radio
+// sends one.
+#define RADIOPACKET_STREAM_SIZE 255
+#define RADIOPACKET_STREAM_MAX_BITRATE 80000
+
+// A stretch of a message in bits: a square wave tone, or silence (a steady
+// carrier, quiet on an FM receiver)
+typedef struct {
+    uint32_t bits;
+    uint16_t halfPeriod; // bits per half period of the tone, 0 for silence
+} RadioPacketRun;
+
+// Returns the next run of a message, false at its end
+typedef bool (*RadioPacketSource)(void *context, RadioPacketRun *run);
+
+// Copies up to len bytes of a bitstream to data, returns how many, 0 at its end
+typedef uint16_t (*RadioPacketFill)(void *context, uint8_t *data, uint16_t len);
+
+typedef struct {
+    uint16_t toneHz; // 0 for silence
+    uint16_t ms;
+} RadioPacketTone;
+
+void RadioPacket_Send(uint32_t bitrate, int8_t powerdBm, RadioPacketSource source, void *context);
+void RadioPacket_Stream(uint32_t bitrate, int8_t powerdBm, RadioPacketFill fill, void *context);
+void RadioPacket_SendTones(const RadioPacketTone *tones, uint16_t count, uint32_t bitrate, int8_t powerdBm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RADIOPACKET_H */
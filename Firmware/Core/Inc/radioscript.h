@@ -0,0 +1,59 @@
+/**
+  ******************************************************************************
+  * @file           : radioscript.h
+  * @brief          : Prerecorded radio command sequences replayed as a table walk.
+  ******************************************************************************
+  */
+
+#ifndef __RADIOSCRIPT_H
+#define __RADIOSCRIPT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdbool.h>
+
+// Step codes, each followed by its arguments
+#define RSCRIPT_END     0x00 // end of script
+#define RSCRIPT_CMD     0x01 // opcode, size, params[size]: SUBGHZ command, waits for BUSY
+#define RSCRIPT_TX      0x02 // ms (2 bytes, LE): SetTx with timeout, sleep until the radio IRQ
+#define RSCRIPT_DELAY   0x03 // ms (2 bytes, LE): sleep
+#define RSCRIPT_LED_ON  0x04
+#define RSCRIPT_LED_OFF 0x05
+#define RSCRIPT_CHIRP   0x06 // rfFreq (4 bytes, BE), ms (2 bytes, LE): CW transmission swept by Chirp_Tx()
+
+// Steps as initializer bytes, for scripts written as const tables
+#define RSCRIPT_STEP_CMD(opcode, size, ...) RSCRIPT_CMD, (opcode), (size), __VA_ARGS__
+#define RSCRIPT_STEP_TX(ms) RSCRIPT_TX, (uint8_t) ((ms) & 0xFF), (uint8_t) (((ms) >> 8) & 0xFF)
+#define RSCRIPT_STEP_DELAY(ms) RSCRIPT_DELAY, (uint8_t) ((ms) & 0xFF), (uint8_t) (((ms) >> 8) & 0xFF)
+#define RSCRIPT_STEP_CHIRP(rfFreq, ms) RSCRIPT_CHIRP, RADIO_BYTES32(rfFreq), (uint8_t) ((ms) & 0xFF), (uint8_t) (((ms) >> 8) & 0xFF)
+
+typedef struct {
+    uint8_t *buf;
+    uint16_t size;
+    uint16_t capacity;
+    bool overflow;
+} RadioScript;
+
+// Script that radio commands, TimedTx, Radio_Delay and the LED are recorded
+// into instead of being executed, NULL when not recording.
+extern RadioScript *radioRecorder;
+
+void RadioScript_Init(RadioScript *script, uint8_t *buf, uint16_t capacity);
+void RadioScript_Record(RadioScript *script);
+void RadioScript_Stop();
+void RadioScript_AppendCmd(RadioScript *script, uint8_t opcode, const uint8_t *params, uint16_t size);
+void RadioScript_AppendTx(RadioScript *script, uint32_t lengthMs);
+void RadioScript_AppendDelay(RadioScript *script, uint32_t ms);
+void RadioScript_AppendChirp(RadioScript *script, uint32_t rfFreq, uint32_t lengthMs);
+void RadioScript_AppendLed(RadioScript *script, bool on);
+void RadioScript_Run(const RadioScript *script);
+void RadioScript_RunSteps(const uint8_t *steps);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RADIOSCRIPT_H */
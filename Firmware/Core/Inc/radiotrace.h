@@ -0,0 +1,61 @@
+/**
+  ******************************************************************************
+  * @file           : radiotrace.h
+  * @brief          : Timestamped trace of SUBGHZ commands, LED and delays.
+  ******************************************************************************
+  */
+
+#ifndef __RADIOTRACE_H
+#define __RADIOTRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdbool.h>
+
+// Build with RADIO_TRACE defined to record every SUBGHZ command sent, every
+// LED change, delay, end of transmission and radio script step into a RAM
+// ring, timestamped with the HAL tick (which keeps counting across Stop2).
+// The console 't' command prints and clears it.
+#ifdef RADIO_TRACE
+
+#define RADIO_TRACE_LEN 128 // events, a power of two
+
+#define RTRACE_CMD    0x01 // opcode, size, params: command sent to the radio
+#define RTRACE_LED    0x02 // value 1 on, 0 off
+#define RTRACE_DELAY  0x03 // value ms, opcode the radio idle state
+#define RTRACE_TX_END 0x04 // radio IRQ or safety timeout ended a transmission
+#define RTRACE_STEP   0x05 // opcode the RSCRIPT_ step code, value its awake core time in us.
+                           // The cycle counter stops while the core sleeps, so a
+                           // waiting step shows only the time around the waits.
+
+typedef struct {
+    uint32_t tick;
+    uint8_t kind;
+    uint8_t opcode;
+    uint8_t size;
+    uint8_t params[9];
+    uint32_t value;
+} RadioTraceEvent;
+
+extern RadioTraceEvent radioTrace[RADIO_TRACE_LEN];
+extern uint32_t radioTraceCount; // total events, the ring keeps the last RADIO_TRACE_LEN
+
+void RadioTrace_Cmd(uint8_t opcode, const uint8_t *params, uint16_t size);
+void RadioTrace_Event(uint8_t kind, uint8_t opcode, uint32_t value);
+void RadioTrace_Dump(void);
+
+#define RADIO_TRACE_CMD(opcode, params, size) RadioTrace_Cmd(opcode, params, size)
+#define RADIO_TRACE_EVENT(kind, opcode, value) RadioTrace_Event(kind, opcode, value)
+#else
+#define RADIO_TRACE_CMD(opcode, params, size) ((void) 0)
+#define RADIO_TRACE_EVENT(kind, opcode, value) ((void) 0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RADIOTRACE_H */
@@ -0,0 +1,34 @@
+/**
+  ******************************************************************************
+  * @file           : rfmath.h
+  * @brief          : Integer conversions to SUBGHZ radio register words.
+  ******************************************************************************
+  */
+
+#ifndef __RFMATH_H
+#define __RFMATH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// Constant-expression forms, usable in static initializers and _Static_assert.
+// word = Hz * (1e9 + ppb) / 1e9 * 2^14 / 15625, split so nothing overflows 64 bits
+#define RF_FREQ_DIVISOR (15625ULL * 1000000000ULL)
+#define RF_FREQ_SCALED(hz, ppb) ((uint64_t) (hz) * (uint64_t) (1000000000LL + (ppb)))
+#define RF_FREQ_WORD(hz, ppb) ((uint32_t) ((RF_FREQ_SCALED(hz, ppb) / RF_FREQ_DIVISOR) * 16384U + \
+                                          ((RF_FREQ_SCALED(hz, ppb) % RF_FREQ_DIVISOR) * 16384U) / RF_FREQ_DIVISOR))
+#define FSK_BITRATE_WORD(bitrate) ((uint32_t) (1024000000UL / (bitrate)))
+#define FSK_FDEV_WORD(hz) ((uint32_t) (((uint64_t) (hz) * 16384U) / 15625U))
+
+uint32_t ComputeRfFreq(uint32_t frequencyHz, int32_t correctionPpb);
+uint32_t ComputeFSKBitrate(uint32_t bitrate);
+uint32_t ComputeFSKFdev(uint32_t freqDevHz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RFMATH_H */
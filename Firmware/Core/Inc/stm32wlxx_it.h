@@ -56,6 +56,12 @@ void DebugMon_Handler(void);
 void PendSV_Handler(void);
 void SysTick_Handler(void);
 /* USER CODE BEGIN EFP */
+void LPTIM1_IRQHandler(void);
+void SUBGHZ_Radio_IRQHandler(void);
+void EXTI3_IRQHandler(void);
+void FLASH_IRQHandler(void);
+void TIM16_IRQHandler(void);
+void TIM17_IRQHandler(void);
 
 /* USER CODE END EFP */
 
@@ -0,0 +1,24 @@
+/**
+  ******************************************************************************
+  * @file           : supply.h
+  * @brief          : Supply voltage measurement.
+  ******************************************************************************
+  */
+
+#ifndef __SUPPLY_H
+#define __SUPPLY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+
+void Supply_Init(void);
+uint32_t Supply_MeasureMv(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SUPPLY_H */
@@ -0,0 +1,38 @@
+/**
+  ******************************************************************************
+  * @file           : wspr.h
+  * @brief          : WSPR weak-signal transmissions from a frequency word table.
+  ******************************************************************************
+  */
+
+#ifndef __WSPR_H
+#define __WSPR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdbool.h>
+
+// 162 symbols of 8192 / 12000 s, each sent as WSPR_SUBSTEPS frequency words
+// (Tools/wspr_encode.py must use the same numbers)
+#define WSPR_SYMBOLS 162
+#define WSPR_SUBSTEPS 16
+#define WSPR_LENGTH_MS (WSPR_SYMBOLS * 8192 * 1000 / 12000)
+
+typedef struct {
+    const char *text;    // "K1ABC FN42 10"
+    const int8_t *words; // WSPR_SYMBOLS * WSPR_SUBSTEPS offsets from the signal center
+    int8_t powerdBm;     // sent at the power the message reports
+} WsprMessage;
+
+void Wspr_Init(void);
+void Wspr_Send(const WsprMessage *message, uint32_t rfFreq);
+void Wspr_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __WSPR_H */
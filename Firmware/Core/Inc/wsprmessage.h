@@ -0,0 +1,24 @@
+/**
+  ******************************************************************************
+  * @file           : wsprmessage.h
+  * @brief          : WSPR message as radio frequency words.
+  ******************************************************************************
+  * Generated by Tools/wspr_encode.py, do not edit.
+  */
+
+#ifndef __WSPRMESSAGE_H
+#define __WSPRMESSAGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "wspr.h"
+
+extern const WsprMessage wsprMessage;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __WSPRMESSAGE_H */
@@ -0,0 +1,55 @@
+/**
+  ******************************************************************************
+  * @file           : audio.c
+  * @brief          : Audio clips streamed to FM receivers as FSK bitstreams.
+  ******************************************************************************
+  * An FM receiver hears the average of the FSK bits, so a delta-sigma
+  * bitstream at a high bitrate plays back as the waveform it was encoded
+  * from. Tools/audio_encode.py does the encoding and writes the clips to
+  * audioclips.c; periodic sounds are stored as one loop with a repeat
+  * count. Here the bytes are only copied into the radio buffer.
+  */
+
+#include "audio.h"
+#include "audioclips.h"
+#include "radiopacket.h"
+#include <string.h>
+
+_Static_assert(AUDIOCLIPS_BITRATE <= RADIOPACKET_STREAM_MAX_BITRATE,
+               "the clips are encoded faster than RadioPacket_Stream() can send");
+
+typedef struct {
+    const AudioClip *clip;
+    uint16_t segment;
+    uint16_t repeat; // of the segment, already sent
+    uint16_t offset; // into the current repeat
+} AudioReader;
+
+static uint16_t Audio_Fill(void *context, uint8_t *data, uint16_t len) {
+    AudioReader *r = context;
+    uint16_t done = 0;
+    while (done < len && r->segment < r->clip->count) {
+        const AudioSegment *segment = &r->clip->segments[r->segment];
+        uint16_t n = segment->bytes - r->offset;
+        if (n > len - done) {
+            n = len - done;
+        }
+        memcpy(data + done, segment->data + r->offset, n);
+        done += n;
+        r->offset += n;
+        if (r->offset == segment->bytes) {
+            r->offset = 0;
+            if (++r->repeat >= segment->repeat) {
+                r->repeat = 0;
+                r->segment++;
+            }
+        }
+    }
+    return done;
+}
+
+// Plays clip at powerdBm. The radio must be in STDBY_XOSC on the frequency.
+void Audio_Play(const AudioClip *clip, int8_t powerdBm) {
+    AudioReader reader = {clip};
+    RadioPacket_Stream(clip->bitrate, powerdBm, Audio_Fill, &reader);
+}
@@ -0,0 +1,378 @@
+/**
+  ******************************************************************************
+  * @file           : audioclips.c
+  * @brief          : Audio clips as delta-sigma FSK bitstreams.
+  ******************************************************************************
+  * Generated by Tools/audio_encode.py, do not edit. Regenerate with
+  *     python3 Tools/audio_encode.py --write
+  */
+
+#include "audioclips.h"
+
+static const uint8_t audioData0[345] = {
+    0x9A, 0xAD, 0x6D, 0x73, 0xAB, 0x4C, 0xA8, 0xA4, 0x92, 0x65, 0x56, 0x79, 0xB6, 0x73, 0x32, 0xA5,
+    0x4A, 0x9A, 0xB3, 0x9C, 0xE5, 0x53, 0x12, 0x49, 0x29, 0x9B, 0x5E, 0xBE, 0xDB, 0x65, 0x30, 0x50,
+    0x48, 0x62, 0xB3, 0xAE, 0xDD, 0xD6, 0xD5, 0x54, 0xA4, 0xA5, 0x29, 0x54, 0xCC, 0xB3, 0x33, 0x56,
+    0x73, 0x9C, 0xD6, 0x6A, 0x63, 0x18, 0xA5, 0x2A, 0xAA, 0xD5, 0xCB, 0x96, 0x99, 0x55, 0x2C, 0xB3,
+    0x59, 0xD5, 0x65, 0x8A, 0x48, 0xA2, 0xA5, 0x67, 0xAF, 0x7A, 0xF6, 0x66, 0x24, 0x42, 0x12, 0x4A,
+    0x75, 0xB7, 0x7A, 0xED, 0x56, 0x4C, 0x4C, 0x32, 0x95, 0x4D, 0x55, 0x65, 0x96, 0x66, 0xAB, 0x55,
+    0xAD, 0x39, 0x54, 0xC6, 0x4A, 0x93, 0x4B, 0x35, 0x9A, 0xB3, 0x53, 0x53, 0x53, 0x96, 0x73, 0x95,
+    0x95, 0x45, 0x14, 0x4A, 0x55, 0x9E, 0x7E, 0xBE, 0xB6, 0x68, 0xA1, 0x10, 0x86, 0x1A, 0xB6, 0xDD,
+    0xDD, 0xB5, 0x65, 0x29, 0x28, 0xA9, 0x4D, 0x56, 0x6A, 0xAC, 0xAA, 0x9A, 0x66, 0x73, 0x3A, 0xCD,
+    0x65, 0x52, 0xA5, 0x19, 0x52, 0xB2, 0xD3, 0x9A, 0xAD, 0x36, 0x5A, 0x73, 0x55, 0x99, 0x52, 0x94,
+    0x31, 0x29, 0x65, 0xB7, 0x6F, 0x6F, 0x39, 0x94, 0x50, 0x24, 0x25, 0x2A, 0xDB, 0x77, 0x76, 0xB6,
+    0x53, 0x12, 0x92, 0x63, 0x55, 0x6A, 0xCE, 0x38, 0xCC, 0x65, 0x34, 0xE5, 0xCE, 0xB3, 0xAA, 0xA6,
+    0x31, 0x46, 0x31, 0x99, 0x9C, 0xB6, 0x73, 0x66, 0xCC, 0xE5, 0x66, 0x63, 0x46, 0x29, 0x25, 0x1A,
+    0x6A, 0xDD, 0xBB, 0xBA, 0xD5, 0x4A, 0x14, 0x0A, 0x18, 0xCD, 0x6E, 0xBE, 0x7A, 0xD3, 0x49, 0x86,
+    0x29, 0x55, 0x56, 0xB5, 0x9A, 0x69, 0x49, 0x8C, 0x6A, 0x75, 0x75, 0xCF, 0x35, 0x4C, 0x61, 0x49,
+    0x25, 0x33, 0x4E, 0xB5, 0xB5, 0xAD, 0x59, 0xA6, 0x99, 0x52, 0x63, 0x13, 0x13, 0x2A, 0xCD, 0xAF,
+    0x5E, 0x7A, 0xCB, 0x18, 0x50, 0x51, 0x26, 0x56, 0xD7, 0x9F, 0x39, 0xCA, 0xA3, 0x14, 0xA6, 0x39,
+    0x73, 0x5A, 0xB3, 0x19, 0x45, 0x26, 0x35, 0x6B, 0xAE, 0xEB, 0x66, 0xA4, 0xA2, 0x24, 0x92, 0x99,
+    0xB3, 0xCE, 0xD7, 0x56, 0xAC, 0xAA, 0x63, 0x26, 0x29, 0x8A, 0x95, 0x4D, 0x5A, 0xDB, 0x9E, 0xB5,
+    0xA6, 0x4A, 0x24, 0x8A, 0x32, 0xAB, 0x9D, 0xB6, 0xCE, 0x66, 0x31, 0x8A, 0x99, 0x6A, 0xB9, 0xB3,
+    0x54, 0xA5, 0x12, 0x8C, 0xAB, 0x5D, 0x7B, 0xAE, 0xB4, 0xC5, 0x12, 0x0C, 0x19, 0x4E, 0x6D, 0xBB,
+    0x6D, 0x73, 0x4C, 0xC6, 0x32, 0x52, 0xA5, 0x2C, 0x66,
+};
+
+static const uint8_t audioData1[348] = {
+    0x9A, 0xB3, 0xB3, 0xCD, 0x9A, 0xA5, 0x18, 0x52, 0x95, 0x5A, 0xBA, 0xB9, 0xB1, 0xA5, 0x49, 0xA6,
+    0x6D, 0x5A, 0xCC, 0xC5, 0x22, 0x8C, 0x6A, 0xDD, 0xBB, 0xD6, 0xAA, 0x44, 0x84, 0x46, 0x33, 0xAD,
+    0xDB, 0xB6, 0xAB, 0x19, 0x29, 0x4A, 0x54, 0xCB, 0x2A, 0xCB, 0x56, 0xAD, 0xAB, 0x55, 0x54, 0x98,
+    0x64, 0xA9, 0xAB, 0x56, 0xCD, 0x65, 0x54, 0xB1, 0xAA, 0xD6, 0x73, 0x4C, 0xA2, 0x89, 0x46, 0x6A,
+    0xF5, 0xF6, 0xEA, 0xCA, 0x22, 0x11, 0x14, 0xCD, 0xAF, 0x9F, 0x5B, 0x2C, 0x94, 0xA2, 0xA5, 0x4D,
+    0x34, 0xD5, 0x56, 0x59, 0xB3, 0x5A, 0xAD, 0x32, 0xA5, 0x26, 0x32, 0xCB, 0x56, 0x6C, 0xB4, 0xCC,
+    0xAC, 0xCD, 0x9A, 0xD3, 0x4A, 0x89, 0x24, 0xA6, 0x6B, 0xBB, 0xBB, 0xAC, 0xC8, 0x90, 0x44, 0x8C,
+    0xB5, 0xDD, 0xBD, 0x6C, 0xCA, 0x51, 0x4A, 0x54, 0xD5, 0x56, 0x69, 0xA6, 0x65, 0x9C, 0xB5, 0x9C,
+    0xB3, 0x29, 0x51, 0x94, 0xCB, 0x34, 0xE6, 0xAA, 0xCB, 0x4E, 0x59, 0xCC, 0xD3, 0x29, 0x24, 0x8C,
+    0x65, 0xB5, 0xEE, 0xEE, 0x74, 0xA4, 0x24, 0x11, 0x8A, 0xDA, 0xF7, 0x6D, 0xB3, 0x26, 0x18, 0xA5,
+    0x4D, 0x56, 0x72, 0xB2, 0xA9, 0x63, 0x56, 0x73, 0x6A, 0xD5, 0x32, 0x94, 0x95, 0x29, 0xAB, 0x35,
+    0x6A, 0xCD, 0x66, 0xB2, 0xD4, 0xD2, 0x93, 0x09, 0x86, 0x9A, 0xD7, 0xBB, 0xAF, 0x2A, 0x8A, 0x08,
+    0x89, 0x4D, 0x5E, 0x7E, 0xB6, 0xAA, 0x94, 0x8C, 0x55, 0x35, 0x6B, 0x35, 0x53, 0x19, 0x32, 0xCB,
+    0x9B, 0x6B, 0x66, 0x64, 0xA4, 0xA2, 0xA5, 0x56, 0xAB, 0x9C, 0xDA, 0xAC, 0xD3, 0x8C, 0xAA, 0x30,
+    0xC9, 0x2A, 0xAB, 0x9F, 0x3E, 0xB9, 0xA9, 0x28, 0x24, 0x31, 0x55, 0xB7, 0x6E, 0xD6, 0xA6, 0x49,
+    0x46, 0x4D, 0x59, 0xCD, 0x99, 0x62, 0x94, 0xA6, 0x6A, 0xEB, 0x75, 0xAC, 0xA9, 0x24, 0x61, 0x4C,
+    0xCD, 0x6D, 0x73, 0xAC, 0xD5, 0x95, 0x32, 0x94, 0xA3, 0x25, 0x2C, 0xCE, 0xD7, 0x75, 0xD5, 0x93,
+    0x0A, 0x12, 0x31, 0x9B, 0x5D, 0xB6, 0xD6, 0x55, 0x14, 0xA5, 0x55, 0x9D, 0x56, 0xAA, 0x52, 0x51,
+    0x55, 0x57, 0x5E, 0x7C, 0xD5, 0x31, 0x22, 0x45, 0x26, 0xAB, 0x9E, 0xB6, 0xD5, 0x99, 0x94, 0xC5,
+    0x4A, 0x52, 0xA5, 0x53, 0x9C, 0xEB, 0xB6, 0x75, 0x2A, 0x45, 0x0A, 0x4C, 0xB5, 0x76, 0xBA, 0xCD,
+    0x31, 0x8C, 0x65, 0x5A, 0xB5, 0xAC, 0xAA, 0x30, 0xC3, 0x32, 0xDA, 0xF7, 0x5E, 0x66, 0x49, 0x10,
+    0xA2, 0x56, 0x6B, 0xB6, 0xEB, 0x9A, 0xA6, 0x52, 0x63, 0x18, 0xCC, 0x69,
+};
+
+static const uint8_t audioData2[310] = {
+    0x66, 0xCE, 0x76, 0x78, 0xE5, 0x25, 0x14, 0x65, 0x5A, 0xBA, 0xD6, 0x66, 0x32, 0x65, 0x9A, 0xD5,
+    0xAA, 0x94, 0x51, 0x4A, 0xAE, 0xBD, 0xDB, 0x58, 0xA4, 0x12, 0x25, 0x59, 0xEB, 0xD7, 0x56, 0x64,
+    0xA5, 0x26, 0x34, 0xAB, 0x1C, 0xCD, 0x6A, 0xE6, 0xB3, 0x31, 0x8A, 0x4A, 0xA6, 0xCD, 0x6C, 0xD4,
+    0xD2, 0xA6, 0x9B, 0x36, 0x72, 0xA5, 0x14, 0x4A, 0x9C, 0xEF, 0x6E, 0xD9, 0x89, 0x20, 0x4A, 0x35,
+    0x76, 0xEE, 0xB9, 0xA5, 0x46, 0x1A, 0x34, 0xCC, 0xD3, 0x55, 0x59, 0xAC, 0xE6, 0xAA, 0xA5, 0x29,
+    0x52, 0xAC, 0xD6, 0x6A, 0xCA, 0xAA, 0xAC, 0xCE, 0xAA, 0xC6, 0x28, 0x94, 0x66, 0xD7, 0xBB, 0x79,
+    0x98, 0x48, 0x42, 0x8C, 0xEB, 0x7C, 0xF9, 0x9A, 0x31, 0x49, 0x8C, 0xCD, 0x59, 0x66, 0x56, 0x59,
+    0xAB, 0x66, 0x9C, 0x63, 0x29, 0x4B, 0x2C, 0xD5, 0x66, 0xB1, 0xD3, 0x56, 0x6B, 0x29, 0x8A, 0x25,
+    0x1A, 0x75, 0xDD, 0xEB, 0x99, 0x24, 0x12, 0x15, 0x39, 0xED, 0xE7, 0xA6, 0x8C, 0x4A, 0x54, 0xCD,
+    0x66, 0xAC, 0x66, 0x35, 0x55, 0xAD, 0x9B, 0x2A, 0x94, 0xA4, 0xC6, 0xAA, 0xCE, 0x67, 0x35, 0x5A,
+    0x72, 0xAA, 0x61, 0x8A, 0x31, 0xAB, 0x77, 0x6F, 0x39, 0x50, 0xA0, 0x51, 0x55, 0xB7, 0x75, 0xE6,
+    0x54, 0x92, 0x93, 0x4D, 0x6A, 0xB4, 0xC6, 0x8C, 0xAC, 0xD6, 0xBA, 0xCD, 0x51, 0x91, 0x4A, 0x65,
+    0x67, 0x56, 0xB5, 0x9A, 0xB2, 0xB1, 0x94, 0x92, 0x92, 0xAC, 0xDD, 0xBB, 0x73, 0x52, 0x84, 0x44,
+    0xA5, 0x9E, 0xBD, 0x73, 0x94, 0xA4, 0x95, 0x4D, 0x67, 0x4E, 0x4C, 0x94, 0xA6, 0x6B, 0x6D, 0xB5,
+    0x99, 0x45, 0x14, 0x54, 0xCD, 0xAD, 0x75, 0x9C, 0xCC, 0xCA, 0x63, 0x15, 0x18, 0xCC, 0xE6, 0xED,
+    0xD6, 0xCC, 0x61, 0x42, 0x4A, 0xAB, 0x75, 0xDA, 0xD3, 0x25, 0x26, 0x35, 0x5B, 0x39, 0x95, 0x28,
+    0xA5, 0x55, 0xB7, 0x5D, 0xAC, 0x68, 0x49, 0x14, 0x9C, 0xBA, 0xEB, 0x6C, 0xD5, 0x32, 0x94, 0xA8,
+    0xC9, 0x94, 0xE6, 0xBA, 0xEB, 0x9A, 0x94, 0x92, 0x25, 0x33, 0x5B, 0x9E, 0x6B, 0x19, 0x49, 0x95,
+    0x5A, 0xD6, 0x6A, 0x4A, 0x28, 0xCC, 0xDB, 0xB7, 0x6D, 0x32, 0x44, 0x48, 0x99, 0x9D, 0xB6, 0xEB,
+    0x59, 0x52, 0xA3, 0x26, 0x32, 0x9A,
+};
+
+static const uint8_t audioData3[134] = {
+    0x79, 0xE6, 0xAA, 0x95, 0x55, 0x8E, 0x19, 0x29, 0x9B, 0x76, 0xF3, 0x45, 0x04, 0x4A, 0xB7, 0x6F,
+    0x3A, 0x54, 0x4A, 0x96, 0x59, 0x99, 0x55, 0x6B, 0x5E, 0x66, 0x48, 0x48, 0xAA, 0xEF, 0x77, 0x32,
+    0x50, 0x52, 0x67, 0x39, 0xD3, 0x53, 0x56, 0x6B, 0x2A, 0x28, 0xA3, 0x39, 0xFB, 0x6D, 0x48, 0x88,
+    0x53, 0x3A, 0xF5, 0xCC, 0xC6, 0x54, 0xCC, 0xCA, 0x93, 0x27, 0x37, 0x75, 0xCC, 0x50, 0x44, 0xA7,
+    0x6F, 0x75, 0xAA, 0x28, 0xA3, 0x53, 0x96, 0x9A, 0x67, 0x35, 0xD5, 0x62, 0x84, 0x8A, 0xCE, 0xF7,
+    0x73, 0x45, 0x04, 0xA5, 0x6B, 0x9D, 0x66, 0x56, 0x39, 0xA6, 0x92, 0x91, 0x8E, 0x76, 0xF9, 0xE2,
+    0x90, 0x45, 0x2B, 0x76, 0xED, 0x54, 0xC3, 0x47, 0x1A, 0xA6, 0x4C, 0xCD, 0xB6, 0xDA, 0xA8, 0x84,
+    0x51, 0xB5, 0xFA, 0xEC, 0xA4, 0x51, 0x2B, 0x2E, 0x6A, 0xAB, 0x2D, 0x5B, 0x35, 0x24, 0x86, 0x2B,
+    0x6F, 0x77, 0x53, 0x04, 0x89, 0x35,
+};
+
+static const uint8_t audioData4[16] = {
+    0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0x99,
+};
+
+static const uint8_t audioData5[69] = {
+    0x79, 0xCC, 0xD5, 0x6E, 0xB9, 0x89, 0x08, 0x99, 0xB3, 0x9A, 0x66, 0xB7, 0xAE, 0x98, 0x48, 0x52,
+    0xD3, 0x95, 0x33, 0x3D, 0xBD, 0x69, 0x24, 0x2A, 0x66, 0x65, 0x29, 0x6D, 0xDE, 0xD9, 0x49, 0x25,
+    0x34, 0xC9, 0x45, 0x4E, 0xEE, 0xF4, 0xD1, 0x8A, 0x9A, 0xA3, 0x09, 0x4B, 0x76, 0xFA, 0xA9, 0x8D,
+    0x35, 0x52, 0x44, 0x4B, 0x3B, 0xBA, 0xD5, 0x4D, 0x56, 0xA9, 0x42, 0x14, 0xB6, 0xDB, 0x9A, 0xAA,
+    0xD6, 0xD3, 0x21, 0x11, 0x35,
+};
+
+static const uint8_t audioData6[1500] = {
+    0x9B, 0x5D, 0xEE, 0xF7, 0xAF, 0x59, 0xA4, 0xA2, 0x11, 0x04, 0x86, 0x1A, 0xAD, 0xB7, 0xBB, 0xED,
+    0xEB, 0x59, 0x51, 0x41, 0x20, 0x85, 0x13, 0x1C, 0xEB, 0xDB, 0xF6, 0xF5, 0xD5, 0x52, 0x85, 0x02,
+    0x21, 0x44, 0xCB, 0x5B, 0xBB, 0xDE, 0xEE, 0xB3, 0x8A, 0x44, 0x41, 0x21, 0x18, 0xCD, 0x73, 0xF7,
+    0x77, 0xB6, 0xD3, 0x28, 0x88, 0x82, 0x24, 0x63, 0x3A, 0xED, 0xF7, 0xB7, 0x9C, 0xCA, 0x44, 0x44,
+    0x0C, 0x18, 0xD6, 0xBB, 0x7D, 0xDE, 0xBC, 0xAC, 0x48, 0x90, 0x24, 0x2A, 0x39, 0xCF, 0xCF, 0xF3,
+    0xE6, 0xB1, 0x48, 0x82, 0x41, 0x49, 0x5A, 0xDD, 0xDF, 0x6F, 0x5A, 0xA6, 0x0C, 0x04, 0x85, 0x25,
+    0xAB, 0xBD, 0xBF, 0x5D, 0x9C, 0x4A, 0x11, 0x08, 0x52, 0x67, 0x3D, 0xDE, 0xF6, 0xD9, 0xA4, 0x88,
+    0x44, 0x24, 0xA6, 0xBA, 0xF7, 0xDB, 0xCE, 0x98, 0x92, 0x08, 0x48, 0xC6, 0xB7, 0x5F, 0xD7, 0xB5,
+    0x98, 0x91, 0x08, 0x85, 0x2A, 0xBA, 0xFB, 0xDB, 0xD5, 0x62, 0x88, 0x42, 0x24, 0xAB, 0x5D, 0xEE,
+    0xF6, 0xD6, 0x31, 0x10, 0x88, 0x53, 0x2D, 0xBD, 0xBF, 0x5D, 0x55, 0x11, 0x10, 0x88, 0xCC, 0xDD,
+    0xBE, 0xEE, 0xB5, 0x49, 0x08, 0x83, 0x0B, 0x36, 0xDF, 0x7A, 0xF5, 0x4C, 0x28, 0x11, 0x23, 0x35,
+    0xBB, 0xDE, 0xE7, 0x8C, 0x50, 0x44, 0x25, 0x4D, 0xB7, 0xBD, 0xDA, 0xD3, 0x05, 0x02, 0x83, 0x53,
+    0xD7, 0xBD, 0xE7, 0x4C, 0x48, 0x42, 0x25, 0x4E, 0xDB, 0xF5, 0xEC, 0xCA, 0x22, 0x0A, 0x0E, 0x3A,
+    0xF7, 0xBB, 0x73, 0x25, 0x02, 0x42, 0x8D, 0x9E, 0xDF, 0x76, 0xB2, 0x89, 0x04, 0x85, 0x56, 0xDD,
+    0xEE, 0xEB, 0x28, 0xA0, 0x30, 0x55, 0x6D, 0xEE, 0xF5, 0xCA, 0x85, 0x02, 0x46, 0x3B, 0x5F, 0xB7,
+    0x9C, 0xA2, 0x42, 0x12, 0x56, 0xBB, 0xBE, 0xD7, 0x26, 0x05, 0x03, 0x15, 0xAE, 0xFB, 0x79, 0xC6,
+    0x21, 0x11, 0x19, 0x6E, 0xBF, 0xAE, 0xA9, 0x81, 0x40, 0xA9, 0x6D, 0xDE, 0xF5, 0xAA, 0x24, 0x11,
+    0x45, 0x9E, 0xDF, 0x6E, 0xA9, 0x22, 0x0A, 0x16, 0x76, 0xF7, 0x79, 0xA6, 0x08, 0x88, 0x99, 0xCF,
+    0xDD, 0xD6, 0x98, 0x24, 0x14, 0x6A, 0xDF, 0x6F, 0x5A, 0x89, 0x08, 0x89, 0xAB, 0xBD, 0xEB, 0xA9,
+    0x22, 0x0A, 0x1A, 0xB7, 0x7D, 0xB6, 0x94, 0x24, 0x12, 0x9C, 0xF7, 0xBB, 0x66, 0x28, 0x12, 0x2A,
+    0xB7, 0x77, 0xD5, 0x94, 0x22, 0x14, 0x6C, 0xFD, 0x7E, 0x59, 0x21, 0x11, 0x27, 0x3D, 0xBF, 0x39,
+    0x89, 0x04, 0x8A, 0xAE, 0xEF, 0x75, 0x94, 0x42, 0x14, 0xAB, 0xBB, 0xDD, 0x58, 0x90, 0x88, 0xAB,
+    0x5F, 0x7A, 0xE5, 0x24, 0x11, 0x2A, 0xDD, 0xEE, 0xD6, 0x28, 0x24, 0x2A, 0xDB, 0xBE, 0xB9, 0x48,
+    0x48, 0x2C, 0xBB, 0x7D, 0xCE, 0x48, 0x84, 0x52, 0xBB, 0x7E, 0x79, 0x48, 0x84, 0x4A, 0xDB, 0xBD,
+    0xCE, 0x44, 0x81, 0x8A, 0xDB, 0xED, 0xD8, 0xC2, 0x41, 0x2C, 0xED, 0xF9, 0xE5, 0x11, 0x09, 0x2D,
+    0x77, 0xBB, 0x54, 0x84, 0x44, 0xB5, 0xBF, 0x5D, 0x52, 0x11, 0x13, 0x37, 0x7B, 0xB5, 0x30, 0x24,
+    0x33, 0x5E, 0xEE, 0xD5, 0x0A, 0x03, 0x4D, 0xBB, 0xEB, 0x52, 0x21, 0x13, 0x3B, 0x7B, 0xCD, 0x24,
+    0x22, 0x33, 0x9F, 0xCF, 0x8C, 0x44, 0x24, 0xD6, 0xF7, 0x75, 0x28, 0x24, 0x4C, 0xF6, 0xFB, 0x34,
+    0x44, 0x24, 0xD6, 0xFB, 0x75, 0x24, 0x22, 0x33, 0xB7, 0xBC, 0xCC, 0x12, 0x13, 0x5B, 0xBE, 0x78,
+    0x90, 0x90, 0xCE, 0xDE, 0xED, 0x28, 0x82, 0x8D, 0x6F, 0xB7, 0x4A, 0x41, 0x14, 0xE7, 0xEB, 0xD4,
+    0x88, 0x85, 0x56, 0xEF, 0xAD, 0x18, 0x0C, 0x2E, 0x7E, 0xDC, 0xC8, 0x84, 0x55, 0x77, 0x7B, 0x31,
+    0x20, 0x94, 0xEE, 0xEF, 0x32, 0x42, 0x15, 0x5D, 0xBE, 0xCC, 0x48, 0x25, 0x5B, 0x7D, 0xB3, 0x08,
+    0x49, 0x3B, 0x7B, 0xAC, 0x90, 0x89, 0x3A, 0xFB, 0x73, 0x10, 0x90, 0xD9, 0xFB, 0xAB, 0x11, 0x06,
+    0x3A, 0xFB, 0x72, 0x91, 0x06, 0x3A, 0xFC, 0xF8, 0x50, 0x49, 0x57, 0xBB, 0xCA, 0x88, 0x45, 0x5B,
+    0xDD, 0xB2, 0x44, 0x18, 0xED, 0xEE, 0xB1, 0x40, 0xA5, 0x6F, 0x77, 0x29, 0x08, 0x95, 0xB7, 0xDA,
+    0xC4, 0x42, 0x63, 0xEE, 0xEB, 0x12, 0x0A, 0x3B, 0x77, 0xB2, 0x50, 0x26, 0x3E, 0xDE, 0xAA, 0x20,
+    0xA5, 0x7A, 0xFC, 0xA8, 0x44, 0x56, 0xDE, 0xEB, 0x0A, 0x06, 0x5B, 0xBD, 0xAA, 0x24, 0x16, 0x6F,
+    0x79, 0xC5, 0x02, 0x65, 0xED, 0xF2, 0x90, 0x89, 0x6B, 0xDD, 0xAA, 0x20, 0xA5, 0xB7, 0xDA, 0xA2,
+    0x41, 0x5A, 0xFB, 0xAA, 0x44, 0x19, 0x76, 0xFA, 0xA8, 0x28, 0x3A, 0xF6, 0xF2, 0x48, 0x29, 0x6F,
+    0x6F, 0x24, 0x82, 0x96, 0xF7, 0x6A, 0x48, 0x26, 0x6F, 0x76, 0xA4, 0x42, 0x97, 0x77, 0xA9, 0x81,
+    0x45, 0xAF, 0xD9, 0xC1, 0x21, 0x9B, 0xBD, 0xA9, 0x11, 0x16, 0xBE, 0xDA, 0x89, 0x05, 0x9F, 0x5F,
+    0x24, 0x44, 0x67, 0x77, 0xA9, 0x41, 0x26, 0x7D, 0xDA, 0x8A, 0x06, 0x6D, 0xF5, 0xA4, 0x82, 0x9A,
+    0xFC, 0xF1, 0x21, 0x19, 0xDD, 0xEA, 0x50, 0x29, 0xAF, 0xB6, 0x94, 0x11, 0x9D, 0xDD, 0xA8, 0x84,
+    0x9A, 0xF7, 0xA6, 0x21, 0x26, 0xBE, 0xE6, 0x84, 0x46, 0x7B, 0xB6, 0x92, 0x06, 0x6E, 0xF6, 0x64,
+    0x22, 0x6B, 0xDD, 0xA5, 0x02, 0x9B, 0x7B, 0xA6, 0x08, 0xA7, 0x5F, 0x9A, 0x21, 0x29, 0xDE, 0xE6,
+    0x44, 0x29, 0xBD, 0xDA, 0x48, 0x46, 0xB7, 0xD6, 0x89, 0x06, 0x77, 0xB6, 0x8A, 0x06, 0xAF, 0x76,
+    0x61, 0x11, 0xAE, 0xF6, 0x92, 0x11, 0xAE, 0xEE, 0x94, 0x0C, 0x6D, 0xF6, 0x62, 0x12, 0x9E, 0xF5,
+    0xA1, 0x41, 0x6E, 0xEE, 0x94, 0x0A, 0x9F, 0x6E, 0x92, 0x0C, 0x6E, 0xF9, 0x91, 0x11, 0xAF, 0xB6,
+    0x50, 0x91, 0xB7, 0xB6, 0x88, 0x4A, 0xBB, 0xBA, 0x44, 0x49, 0xDD, 0xD9, 0x81, 0x46, 0xDF, 0x59,
+    0x21, 0x27, 0x6F, 0x98, 0xA0, 0x6B, 0x7B, 0x98, 0x48, 0x6B, 0xDE, 0x62, 0x41, 0xAE, 0xEE, 0x91,
+    0x0A, 0xB7, 0x7A, 0x48, 0x49, 0xDD, 0xD9, 0x41, 0x46, 0xF7, 0x58, 0xA0, 0x67, 0xDB, 0x98, 0x22,
+    0xAD, 0xF5, 0x91, 0x0A, 0xBB, 0x7A, 0x44, 0x31, 0xED, 0xE9, 0x10, 0xC7, 0xB7, 0xA4, 0x42, 0xAE,
+    0xED, 0x91, 0x0A, 0xB7, 0xD9, 0x42, 0x47, 0x5F, 0x98, 0x88, 0xAB, 0xDD, 0x92, 0x12, 0xB7, 0xB5,
+    0x84, 0x47, 0x3F, 0x95, 0x10, 0x9D, 0xBD, 0x92, 0x22, 0x7A, 0xFA, 0x44, 0x47, 0x5F, 0x64, 0x90,
+    0x6D, 0xDD, 0x91, 0x12, 0xBB, 0xB9, 0x41, 0x47, 0x7B, 0x58, 0x24, 0xAE, 0xF6, 0x48, 0x4A, 0xDF,
+    0x39, 0x08, 0xC7, 0xED, 0x91, 0x0C, 0x7D, 0xD6, 0x12, 0x1D, 0x7C, 0xE4, 0x12, 0xCF, 0xB9, 0x42,
+    0x2B, 0x77, 0x94, 0x24, 0xAF, 0x79, 0x44, 0x31, 0xFA, 0xE4, 0x44, 0xAF, 0x75, 0x48, 0x2B, 0x6F,
+    0x63, 0x01, 0xCE, 0xF9, 0x44, 0x4A, 0xF7, 0x58, 0x24, 0xAF, 0xAE, 0x42, 0x4A, 0xFB, 0x62, 0x41,
+    0xCF, 0xD5, 0x41, 0x2D, 0x7D, 0x52, 0x12, 0xBD, 0xD5, 0x10, 0xCB, 0xED, 0x50, 0x8A, 0xED, 0xE4,
+    0x84, 0xCE, 0xF5, 0x44, 0x4A, 0xFB, 0x62, 0x22, 0xBB, 0xB9, 0x11, 0x2D, 0xDD, 0x50, 0x8A, 0xEE,
+    0xE4, 0x44, 0xB7, 0x75, 0x41, 0x4B, 0xBD, 0x51, 0x0C, 0xBE, 0xE3, 0x04, 0xB6, 0xF5, 0x81, 0x4B,
+    0xBB, 0x52, 0x0A, 0xDE, 0xD5, 0x03, 0x2F, 0x75, 0x42, 0x2B, 0xBD, 0x51, 0x0B, 0x3F, 0x62, 0x82,
+    0xCF, 0xCE, 0x11, 0x33, 0xED, 0x48, 0x4C, 0xF7, 0x61, 0x41, 0xDD, 0xD4, 0x88, 0xB6, 0xF6, 0x21,
+    0x4B, 0xDD, 0x50, 0x4C, 0xF7, 0x52, 0x22, 0xDB, 0xE3, 0x04, 0xCF, 0x75, 0x40, 0xCD, 0xDD, 0x48,
+    0x4B, 0x7B, 0x52, 0x0B, 0x3F, 0x54, 0x43, 0x37, 0xD5, 0x08, 0xCF, 0x6E, 0x21, 0x4B, 0xED, 0x44,
+    0x53, 0x7B, 0x51, 0x0B, 0x5F, 0x62, 0x22, 0xDD, 0xD4, 0x83, 0x37, 0xB5, 0x10, 0xCE, 0xF5, 0x22,
+    0x2D, 0xDE, 0x28, 0x33, 0x7D, 0x50, 0x53, 0x77, 0x51, 0x13, 0x5F, 0x52, 0x23, 0x3E, 0xD3, 0x01,
+    0xDB, 0xD4, 0x85, 0x37, 0xB4, 0xA0, 0xAF, 0x75, 0x12, 0x2E, 0xED, 0x24, 0x2D, 0xDD, 0x44, 0x33,
+    0xBD, 0x48, 0x4D, 0x7D, 0x30, 0x8B, 0x7B, 0x50, 0x8C, 0xFA, 0xE0, 0x93, 0x6F, 0x51, 0x22, 0xEF,
+    0x34, 0x12, 0xEE, 0xD2, 0x41, 0xEE, 0xD2, 0x42, 0xDD, 0xE2, 0x42, 0xDD, 0xD4, 0x42, 0xDD, 0xD4,
+    0x42, 0xDD, 0xD4, 0x42, 0xDD, 0xD4, 0x24, 0xDD, 0xD4, 0x24, 0xDD, 0xD4, 0x24, 0xDD, 0xD4, 0x24,
+    0xDD, 0xE2, 0x23, 0x5E, 0xCC, 0x23, 0x3F, 0x52, 0x14, 0xEE, 0xD2, 0x13, 0x6F, 0x4A, 0x0C, 0xF7,
+    0x50, 0x93, 0x7B, 0x30, 0x8D, 0x7B, 0x48, 0x8B, 0xBD, 0x30, 0x2D, 0xBE, 0x24, 0x2E, 0xDD, 0x22,
+    0x35, 0xF5, 0x11, 0x37, 0x74, 0x90, 0xCF, 0xCD, 0x04, 0xDB, 0xCC, 0x82, 0xDE, 0xB4, 0x14, 0xEF,
+    0x32, 0x0D, 0x6F, 0x88, 0x8D, 0x7D, 0x30, 0x2D, 0xDD, 0x24, 0x2E, 0xED, 0x11, 0x37, 0xAD, 0x05,
+    0x3B, 0xCC, 0x82, 0xEB, 0xE2, 0x14, 0xF6, 0xD0, 0x93, 0xBB, 0x44, 0x4D, 0xEB, 0x41, 0x36, 0xF4,
+    0xA0, 0x7D, 0x78, 0x28, 0xDD, 0xD2, 0x14, 0xF7, 0x48, 0x93, 0xBC, 0xC4, 0x35, 0xF3, 0x20, 0xCF,
+    0xCC, 0x84, 0xDD, 0xD2, 0x23, 0x6F, 0x49, 0x0B, 0xDB, 0x28, 0x1F, 0x6C, 0xA0, 0xCF, 0xD4, 0x43,
+    0x5E, 0xD1, 0x14, 0xFC, 0xC8, 0x35, 0xEB, 0x21, 0x3A, 0xF8, 0x45, 0x5D, 0xD1, 0x23, 0x77, 0x48,
+    0x4E, 0xBE, 0x11, 0x4F, 0xB4, 0x48, 0xDE, 0xB2, 0x0D, 0x7B, 0x44, 0x4E, 0xDE, 0x09, 0x3B, 0xB4,
+    0x24, 0xEF, 0x48, 0x93, 0xDB, 0x41, 0x4F, 0x74, 0x85, 0x3E, 0xCC, 0x0C, 0xFC, 0xC8, 0x35, 0xF3,
+    0x09, 0x3D, 0xB2, 0x42, 0xFA, 0xC8, 0x4E, 0xDD, 0x10, 0xDB, 0xB2, 0x43, 0x6F, 0x48, 0x55, 0xDD,
+    0x11, 0x4F, 0xD4, 0x24, 0xF6, 0xC8, 0x8D, 0xEB, 0x20, 0xD7, 0xD2, 0x24, 0xF7, 0x44, 0x8D, 0xF3,
+    0x09, 0x3D, 0xCC, 0x13, 0xAF, 0x82, 0x55, 0xF8, 0x48, 0xEB, 0xE0, 0x95, 0x7E, 0x12, 0x3A, 0xF8,
+    0x25, 0x5F, 0x84, 0x8D, 0xEC, 0xA0, 0xBD, 0xCC, 0x0D, 0x7C, 0xC2, 0x37, 0x74, 0x44, 0xF5, 0xE0,
+    0x35, 0xEB, 0x10, 0xDD, 0xB2, 0x0D, 0xBB, 0x22, 0x3B, 0x74, 0x24, 0xFA, 0xC4, 0x55, 0xF4, 0x85,
+    0x5E, 0xC9, 0x0D, 0xDD, 0x10, 0xDB, 0xD1, 0x23, 0xBB, 0x22, 0x3B, 0x74, 0x23, 0x7A, 0xC4, 0x37,
+    0x72, 0x83, 0x6F, 0x44, 0x8E, 0xEC, 0x85, 0x5F, 0x30, 0x55, 0xEC, 0x89, 0x5D, 0xD0, 0x93, 0xEC,
+    0x90, 0xE7, 0xE1, 0x0D, 0xDC, 0xA0, 0xDB, 0xD1, 0x15, 0x7E, 0x0A, 0x3D, 0xB1, 0x15, 0xBC, 0xC0,
+    0xD7, 0xE0, 0xA3, 0xDB, 0x11, 0x5B, 0xCC, 0x0D, 0x7E, 0x0A, 0x3D, 0xB1, 0x15, 0xBD, 0x10, 0xDD,
+    0xCA, 0x0D, 0xDC, 0x90, 0xEB, 0xE0, 0x55, 0xEB, 0x06, 0x3F, 0x30, 0x55, 0xF2, 0x85, 0x6F, 0x28,
+    0x39, 0xF8, 0x25, 0x77, 0x24, 0x37, 0xB2, 0x23, 0xBB, 0x21, 0x57, 0xD1, 0x15, 0xBD, 0x10, 0xDE,
+    0xB0, 0x8E, 0xEC, 0x49, 0x5F, 0x44, 0x56, 0xF4, 0x25, 0x7B, 0x21, 0x5B, 0xB1, 0x23, 0xDC, 0x90,
+    0xED, 0xC8, 0x8E, 0xF2, 0x83, 0x9F, 0x82, 0x3B, 0x74, 0x13, 0xDB, 0x11,
+};
+
+static const uint8_t audioData7[1500] = {
+    0x5E, 0xB0, 0x56, 0xF2, 0x85, 0x77, 0x24, 0x3B, 0xB1, 0x25, 0xBC, 0xA0, 0xEB, 0xE0, 0x56, 0xEB,
+    0x05, 0x5F, 0x82, 0x8F, 0xAC, 0x25, 0x7C, 0xC1, 0x57, 0xD2, 0x0E, 0x7E, 0x09, 0x6B, 0xE0, 0x55,
+    0xF3, 0x05, 0x5F, 0x48, 0x4F, 0x72, 0x83, 0xAF, 0x44, 0x3B, 0x72, 0x43, 0xBA, 0xC1, 0x5B, 0xB2,
+    0x15, 0xBC, 0xC0, 0xDB, 0xD1, 0x15, 0xDC, 0xA0, 0xDD, 0xD0, 0x95, 0xEB, 0x09, 0x5E, 0xC9, 0x0E,
+    0xDD, 0x05, 0x6D, 0xD0, 0x8E, 0xEC, 0x88, 0xEE, 0xC8, 0x95, 0xF3, 0x05, 0x5F, 0x30, 0x56, 0xEB,
+    0x08, 0xEE, 0xC8, 0x8E, 0xEC, 0x89, 0x5E, 0xC9, 0x0D, 0xEC, 0x90, 0xED, 0xCA, 0x0D, 0xDC, 0xA0,
+    0xDD, 0xCC, 0x0B, 0xDC, 0xC0, 0xDB, 0xCC, 0x13, 0xBC, 0xC1, 0x57, 0xB4, 0x23, 0xB7, 0x28, 0x37,
+    0x72, 0x84, 0xF6, 0xC8, 0x8E, 0xEC, 0x89, 0x5E, 0xC9, 0x0E, 0xBD, 0x11, 0x5B, 0xD2, 0x15, 0x7C,
+    0xC2, 0x3A, 0xF8, 0x28, 0xF6, 0xC8, 0x55, 0xF4, 0x89, 0x5D, 0xD1, 0x13, 0xDC, 0xC1, 0x3B, 0xB2,
+    0x43, 0x9F, 0x84, 0x8E, 0xED, 0x06, 0x3E, 0xB2, 0x0D, 0xBC, 0xC1, 0x57, 0xB2, 0x83, 0x6F, 0x48,
+    0x8D, 0xEC, 0xC0, 0x7E, 0xB2, 0x23, 0xAF, 0x84, 0x4E, 0xF4, 0x89, 0x3E, 0xCC, 0x0D, 0x7D, 0x24,
+    0x37, 0x73, 0x03, 0x6D, 0xD1, 0x13, 0xDB, 0x24, 0x37, 0x73, 0x03, 0x5F, 0x31, 0x13, 0xDB, 0x24,
+    0x37, 0x73, 0x03, 0x5F, 0x31, 0x13, 0xD7, 0x81, 0x8E, 0xF5, 0x05, 0x3E, 0xCC, 0x0D, 0x7B, 0x44,
+    0x55, 0xF3, 0x10, 0xDB, 0xD2, 0x43, 0x6F, 0x48, 0x93, 0xEB, 0x40, 0xD7, 0xB3, 0x03, 0x5E, 0xCC,
+    0x0C, 0xFD, 0x44, 0x4E, 0xED, 0x10, 0xDB, 0xB4, 0x43, 0x5F, 0x50, 0x95, 0x7D, 0x42, 0x55, 0xF4,
+    0xA0, 0xD7, 0xD2, 0x82, 0xEF, 0x4A, 0x0B, 0xBC, 0xC8, 0x33, 0xF5, 0x11, 0x4F, 0xD4, 0x45, 0x5E,
+    0xB4, 0x0D, 0x77, 0x48, 0x8D, 0xDD, 0x22, 0x36, 0xF5, 0x09, 0x3B, 0xD2, 0x83, 0x5E, 0xD2, 0x0D,
+    0x7B, 0x30, 0x4D, 0xDD, 0x24, 0x2F, 0x6D, 0x10, 0xD7, 0xCD, 0x02, 0xEB, 0xE2, 0x23, 0x6F, 0x4A,
+    0x0B, 0xBB, 0x48, 0x35, 0xDD, 0x24, 0x2F, 0x6D, 0x10, 0xD7, 0xB4, 0x85, 0x3D, 0xD4, 0x24, 0xEE,
+    0xD2, 0x13, 0x77, 0x49, 0x0D, 0x7D, 0x30, 0x33, 0xEB, 0x42, 0x4E, 0xED, 0x21, 0x37, 0x74, 0xA0,
+    0x7C, 0xF9, 0x04, 0xDB, 0xD4, 0x43, 0x5D, 0xE2, 0x23, 0x5F, 0x52, 0x13, 0x6F, 0x51, 0x13, 0x7A,
+    0xE0, 0x53, 0xBB, 0x48, 0x53, 0xBD, 0x44, 0x53, 0xEB, 0x44, 0x33, 0xF3, 0x42, 0x35, 0xF3, 0x41,
+    0x4E, 0xF4, 0xC0, 0xCF, 0x73, 0x40, 0xB6, 0xF8, 0xA0, 0xB7, 0xAE, 0x08, 0xD7, 0x75, 0x10, 0xBA,
+    0xF9, 0x08, 0xD7, 0xB4, 0x90, 0xBB, 0x78, 0x89, 0x37, 0xB5, 0x08, 0xD7, 0x78, 0x90, 0xBA, 0xF9,
+    0x09, 0x37, 0xAE, 0x09, 0x37, 0x75, 0x11, 0x36, 0xF5, 0x21, 0x2F, 0x73, 0x40, 0xCE, 0xF5, 0x22,
+    0x33, 0xF5, 0x42, 0x33, 0xED, 0x44, 0x33, 0xDD, 0x48, 0x4D, 0x7D, 0x50, 0x4D, 0x7B, 0x50, 0x93,
+    0x77, 0x51, 0x22, 0xEF, 0x52, 0x23, 0x3F, 0x38, 0x24, 0xDB, 0xD4, 0x88, 0xB7, 0xD4, 0xA0, 0x79,
+    0xFA, 0x11, 0x4D, 0xF5, 0x42, 0x33, 0xDD, 0x84, 0x53, 0x7D, 0x4A, 0x0A, 0xF7, 0x52, 0x22, 0xDE,
+    0xD4, 0x82, 0xD7, 0xE3, 0x09, 0x2F, 0xAE, 0x21, 0x2E, 0xDE, 0x44, 0x33, 0xBD, 0x49, 0x0B, 0x76,
+    0xE2, 0x22, 0xDD, 0xE3, 0x03, 0x37, 0xB6, 0x0A, 0x2D, 0xF5, 0x44, 0x33, 0xBD, 0x4A, 0x07, 0x6F,
+    0x62, 0x24, 0xBD, 0xD4, 0x90, 0xB6, 0xF6, 0x22, 0x2D, 0xBE, 0x48, 0x8C, 0xF7, 0x54, 0x14, 0xDB,
+    0xD8, 0x88, 0xCE, 0xF6, 0x24, 0x2D, 0x7E, 0x4A, 0x07, 0x6E, 0xE4, 0x43, 0x37, 0xB9, 0x11, 0x33,
+    0xEE, 0x48, 0x4B, 0x77, 0x62, 0x22, 0xDB, 0xD5, 0x10, 0xB5, 0xF5, 0x48, 0x32, 0xFB, 0x62, 0x22,
+    0xBD, 0xD5, 0x10, 0xB3, 0xF5, 0x84, 0x8A, 0xFA, 0xE4, 0x22, 0xD7, 0xD5, 0x21, 0x2D, 0xDD, 0x89,
+    0x07, 0x6E, 0xE3, 0x03, 0x2F, 0x76, 0x28, 0x1D, 0x7B, 0x92, 0x13, 0x3B, 0xD8, 0xC0, 0x73, 0xED,
+    0x60, 0x52, 0xDF, 0x55, 0x04, 0xB5, 0xF6, 0x48, 0x32, 0xF7, 0x58, 0x24, 0xB7, 0x79, 0x42, 0x4B,
+    0x7B, 0x54, 0x23, 0x2F, 0xD6, 0x22, 0x2C, 0xFD, 0x92, 0x22, 0xBB, 0xB9, 0x41, 0x2C, 0xFE, 0x54,
+    0x12, 0xCF, 0xE5, 0x41, 0x47, 0xBB, 0x94, 0x22, 0xB7, 0xB9, 0x42, 0x2C, 0xFB, 0x62, 0x82, 0xAF,
+    0xAE, 0x48, 0x31, 0xF7, 0x64, 0x84, 0xB3, 0xF9, 0x50, 0x8A, 0xDE, 0xD8, 0xC0, 0x6D, 0xBD, 0x92,
+    0x12, 0xCF, 0xD9, 0x42, 0x47, 0x77, 0x94, 0x84, 0xAE, 0xEE, 0x50, 0x8A, 0xDD, 0xD9, 0x21, 0x2B,
+    0x7D, 0x64, 0x24, 0x76, 0xF9, 0x88, 0x4A, 0xDE, 0xD9, 0x20, 0xAB, 0xBD, 0x62, 0x81, 0xB5, 0xFA,
+    0x50, 0x4A, 0xDD, 0xD9, 0x40, 0xC7, 0xB7, 0x98, 0x44, 0xAD, 0xEE, 0x61, 0x11, 0xCF, 0xE5, 0x84,
+    0x2A, 0xEE, 0xE6, 0x09, 0x2B, 0x7D, 0x64, 0x82, 0xAD, 0xF5, 0x91, 0x12, 0xB7, 0xB9, 0x84, 0x4A,
+    0xDD, 0xE6, 0x22, 0x1B, 0x6F, 0xA5, 0x08, 0xAB, 0xBD, 0x98, 0x23, 0x1E, 0xEE, 0x61, 0x12, 0xAF,
+    0xB6, 0x88, 0x8A, 0xBB, 0xD9, 0x82, 0x4A, 0xBF, 0x59, 0x41, 0x2A, 0xEF, 0x69, 0x10, 0xAB, 0x7B,
+    0x65, 0x08, 0x9D, 0x7D, 0x98, 0x82, 0xAB, 0xDE, 0x64, 0x42, 0x9E, 0xDE, 0x94, 0x22, 0x73, 0xF9,
+    0x94, 0x12, 0x75, 0xF9, 0x92, 0x12, 0x76, 0xF6, 0x92, 0x0A, 0xAF, 0x76, 0x61, 0x11, 0xB6, 0xF9,
+    0x92, 0x0A, 0xAF, 0x75, 0xA1, 0x12, 0x75, 0xFA, 0x62, 0x12, 0x73, 0xFA, 0x64, 0x12, 0x73, 0xF5,
+    0xA4, 0x22, 0x9D, 0xED, 0xA4, 0x44, 0x6B, 0xDB, 0xA8, 0x84, 0xA7, 0xBB, 0x69, 0x10, 0xA7, 0x6F,
+    0x9A, 0x21, 0x26, 0xDF, 0x5A, 0x44, 0x29, 0xBD, 0xDA, 0x50, 0x4A, 0x77, 0xB6, 0x92, 0x11, 0xAD,
+    0xF5, 0xA4, 0x42, 0x9B, 0xDB, 0xA9, 0x08, 0x9A, 0xF7, 0x69, 0x81, 0x26, 0xBD, 0xDA, 0x89, 0x05,
+    0xAF, 0x79, 0xC1, 0x80, 0xED, 0xBE, 0x70, 0x88, 0x9A, 0xEF, 0x9A, 0x44, 0x26, 0x7B, 0xDA, 0x91,
+    0x11, 0x9D, 0xF5, 0xA8, 0x84, 0x67, 0x77, 0x6A, 0x42, 0x26, 0x7D, 0xBA, 0xA1, 0x0A, 0x6D, 0xDE,
+    0xA6, 0x04, 0x9A, 0xDF, 0x6A, 0x84, 0x49, 0x77, 0x76, 0xA8, 0x22, 0x97, 0xB7, 0xAA, 0x41, 0x45,
+    0xB7, 0xDA, 0x98, 0x0A, 0x5C, 0xFE, 0xAA, 0x21, 0x19, 0xBB, 0xDA, 0xA2, 0x11, 0x9B, 0xBD, 0xAA,
+    0x21, 0x25, 0xBB, 0xBC, 0x98, 0x0A, 0x67, 0xBB, 0xAA, 0x42, 0x26, 0x77, 0x7A, 0xA4, 0x82, 0x66,
+    0xEF, 0x9C, 0x60, 0x29, 0x6D, 0xEE, 0xAA, 0x08, 0xA5, 0xBD, 0xDA, 0xC1, 0x41, 0x5A, 0xFB, 0xAA,
+    0x84, 0x46, 0x5E, 0xEF, 0x29, 0x10, 0x96, 0x7D, 0xBC, 0xA4, 0x22, 0x66, 0xEF, 0x9C, 0x90, 0x89,
+    0x5B, 0xDD, 0xB2, 0x42, 0x19, 0x6E, 0xF9, 0xC9, 0x10, 0x95, 0xBB, 0xBC, 0xA8, 0x42, 0x95, 0xDE,
+    0xEC, 0xA2, 0x12, 0x3A, 0xF7, 0x72, 0xA0, 0x89, 0x5B, 0x7D, 0x72, 0x88, 0x49, 0x5B, 0xDD, 0xB2,
+    0x82, 0x45, 0x5D, 0xED, 0xCC, 0x24, 0x15, 0x6D, 0xEE, 0xCC, 0x22, 0x15, 0x6D, 0xF6, 0xCA, 0x41,
+    0x23, 0x9E, 0xEE, 0xCC, 0x22, 0x18, 0xED, 0xEE, 0xCC, 0x24, 0x18, 0xEB, 0xED, 0xD2, 0x48, 0x25,
+    0x5B, 0xBE, 0x74, 0x88, 0x85, 0x57, 0xB7, 0xB3, 0x12, 0x06, 0x39, 0xF6, 0xF3, 0x24, 0x22, 0x4E,
+    0x7E, 0xDD, 0x29, 0x04, 0x55, 0x77, 0x7A, 0xD2, 0x21, 0x14, 0xEB, 0xEE, 0xCC, 0x88, 0x45, 0x57,
+    0x6F, 0xCD, 0x22, 0x21, 0x53, 0xDB, 0xEB, 0x49, 0x10, 0x63, 0x5E, 0xF5, 0xE2, 0x84, 0x83, 0x56,
+    0xF7, 0xAD, 0x42, 0x81, 0x4D, 0x7B, 0x7D, 0x34, 0x21, 0x23, 0x57, 0xBD, 0xB5, 0x22, 0x11, 0x4D,
+    0xBB, 0xDB, 0x52, 0x21, 0x14, 0xDB, 0x7E, 0x78, 0xC2, 0x12, 0x33, 0xB7, 0xBC, 0xD4, 0x42, 0x24,
+    0xCF, 0x77, 0xAD, 0x48, 0x82, 0x8C, 0xED, 0xF5, 0xE4, 0xA0, 0x89, 0x33, 0xBD, 0xBD, 0x61, 0x81,
+    0x24, 0xB6, 0xF7, 0xAD, 0x86, 0x04, 0x8B, 0x3D, 0xBE, 0xB9, 0x24, 0x22, 0x33, 0x5F, 0x6F, 0x55,
+    0x12, 0x06, 0x2B, 0xAF, 0xDB, 0x54, 0x90, 0x44, 0xCD, 0x7D, 0xDD, 0x54, 0x84, 0x24, 0xCD, 0xBD,
+    0xED, 0x54, 0x48, 0x14, 0xB3, 0xDD, 0xED, 0x93, 0x01, 0x81, 0xCD, 0xBD, 0xED, 0x58, 0x48, 0x24,
+    0xAD, 0xB7, 0xEB, 0x95, 0x08, 0x85, 0x2B, 0x6F, 0xBB, 0x65, 0x21, 0x11, 0x2B, 0x3E, 0xF6, 0xD9,
+    0x48, 0x24, 0x31, 0xD7, 0xBB, 0xD6, 0x52, 0x10, 0x92, 0xAD, 0xED, 0xF5, 0x98, 0x50, 0x28, 0x72,
+    0xEF, 0xAF, 0xA6, 0x28, 0x22, 0x2A, 0xB7, 0xB7, 0xD6, 0x92, 0x41, 0x22, 0x9D, 0x7B, 0xBD, 0x69,
+    0x42, 0x12, 0x29, 0xCF, 0xBD, 0xB6, 0x94, 0x42, 0x22, 0x9B, 0x76, 0xFD, 0x66, 0x84, 0x82, 0x4A,
+    0x73, 0xF5, 0xF9, 0xA6, 0x0A, 0x05, 0x1A, 0xB7, 0xDB, 0xDA, 0x64, 0x82, 0x24, 0x67, 0x3F, 0x5F,
+    0x9A, 0x92, 0x20, 0x91, 0x9B, 0x6F, 0xBB, 0x6A, 0x60, 0x90, 0x4A, 0x67, 0xB7, 0xBD, 0x6A, 0x8A,
+    0x03, 0x06, 0x5B, 0x7B, 0x7E, 0x6A, 0x8A, 0x08, 0x51, 0x67, 0x6F, 0xB7, 0xAA, 0x94, 0x11, 0x0C,
+    0x3A, 0xDE, 0xDF, 0x9B, 0x18, 0x48, 0x18, 0x39, 0xB7, 0xBB, 0xDA, 0xAA, 0x14, 0x06, 0x15, 0x6B,
+    0xDE, 0xED, 0xCA, 0x90, 0x90, 0x49, 0x56, 0xEB, 0xFA, 0xEB, 0x28, 0x90, 0x48, 0x55, 0x9E, 0xBF,
+    0x9F, 0x32, 0x91, 0x08, 0x89, 0x55, 0xD7, 0xEE, 0xDC, 0xCA, 0x22, 0x11, 0x23, 0x5A, 0xFA, 0xFE,
+    0x6D, 0x28, 0x90, 0x24, 0x93, 0x67, 0xDD, 0xED, 0xCD, 0x24, 0x44, 0x12, 0x54, 0xED, 0xDE, 0xEE,
+    0xD3, 0x24, 0x44, 0x0C, 0x34, 0xEB, 0xDE, 0xEE, 0xB5, 0x28, 0x84, 0x22, 0x8C, 0xDB, 0x7B, 0xDD,
+    0xB5, 0x31, 0x20, 0x88, 0x94, 0xB6, 0xDE, 0xEF, 0x6D, 0x54, 0x88, 0x48, 0x18, 0xCB, 0x9F, 0x6F,
+    0xBA, 0xD8, 0xC8, 0x84, 0x24, 0x32, 0xCF, 0x3F, 0xB7, 0x75, 0x63, 0x09, 0x04, 0x48, 0xAB, 0x5B,
+    0xDD, 0xEE, 0xD6, 0x52, 0x42, 0x20, 0xA3, 0x1C, 0xEE, 0xEF, 0xB7, 0x59, 0x8A, 0x21, 0x10, 0x8C,
+    0x9C, 0xF3, 0xFB, 0xB7, 0x5A, 0x54, 0x22, 0x10, 0xA2, 0x6A, 0xDD, 0xDE, 0xF5, 0xE9, 0xA4, 0x88,
+    0x84, 0x24, 0xA6, 0xB6, 0xEF, 0x7B, 0xB6, 0xA6, 0x44, 0x84, 0x14, 0x29, 0x6B, 0x5F, 0x77, 0xBA,
+    0xF1, 0xC3, 0x09, 0x02, 0x43, 0x16, 0x6D, 0xBD, 0xDF, 0x6D, 0xAC, 0x94, 0x42, 0x21, 0x12, 0x65,
+    0x73, 0xED, 0xF7, 0x76, 0xAC, 0x98, 0x28, 0x11, 0x14, 0x55, 0x6B, 0xBB, 0xDE, 0xED, 0xCB, 0x29,
+    0x11, 0x08, 0x44, 0xA3, 0x56, 0xDD, 0xEE, 0xF7, 0x6B, 0x4C, 0x91, 0x10, 0x84, 0x49, 0x4D, 0x5D,
+    0x7B, 0xDE, 0xEE, 0x78, 0xD2, 0x48, 0x28, 0x0A, 0x18, 0xB3, 0x5D, 0xDB, 0xF6, 0xF6, 0xCE, 0x52,
+    0x85, 0x02, 0x22, 0x24, 0xCA, 0xD7, 0x9F, 0xDB, 0xDD, 0xB5, 0x98, 0xC2, 0x44, 0x10, 0x91, 0x4A,
+    0xAB, 0xAF, 0x77, 0xBD, 0xBC, 0xE9, 0x98, 0x50, 0x90, 0x24, 0x24, 0xA9,
+};
+
+static const uint8_t audioData8[92] = {
+    0xBA, 0xF3, 0xE6, 0xB3, 0x8D, 0x4A, 0x99, 0x4D, 0x4D, 0x56, 0x6C, 0xD9, 0xCD, 0x66, 0xB2, 0xA9,
+    0x93, 0x14, 0xA5, 0x32, 0xAC, 0xED, 0x6E, 0xB5, 0x54, 0x8C, 0x04, 0x84, 0x51, 0xA6, 0xD6, 0xEE,
+    0x7D, 0x5B, 0x4E, 0x34, 0xC6, 0x95, 0x4D, 0x35, 0x5A, 0xAD, 0x6A, 0xD5, 0x9A, 0xB2, 0x99, 0x8A,
+    0x52, 0x62, 0xCA, 0xB5, 0xAE, 0xDA, 0xD5, 0x51, 0x42, 0x20, 0x90, 0xC9, 0x9C, 0xED, 0xBB, 0x6D,
+    0xAC, 0xD5, 0x52, 0xA9, 0x55, 0x34, 0xD5, 0x9B, 0x35, 0xAC, 0xD9, 0xAA, 0xC7, 0x15, 0x29, 0x31,
+    0x33, 0x1C, 0xD7, 0x3C, 0xF3, 0x58, 0xC4, 0x84, 0x41, 0x24, 0xA6, 0xAD,
+};
+
+static const uint8_t audioData9[82] = {
+    0x73, 0xB6, 0xEE, 0xBB, 0x5D, 0x9D, 0x59, 0xCA, 0xB2, 0xB3, 0x32, 0xA6, 0xA7, 0x1A, 0x66, 0x6A,
+    0xD4, 0xE5, 0x59, 0xB2, 0xC6, 0x48, 0x90, 0x88, 0x22, 0x89, 0x8E, 0x67, 0x6B, 0xB7, 0x6E, 0xBA,
+    0xDA, 0xD6, 0x6C, 0xAB, 0x2C, 0xCC, 0xA9, 0xA7, 0x1C, 0x65, 0x9A, 0xB3, 0x55, 0x59, 0x9C, 0xB2,
+    0x92, 0x44, 0x81, 0x40, 0x94, 0x95, 0x66, 0xB7, 0x3E, 0xBB, 0x6D, 0xB6, 0x75, 0x9A, 0xCA, 0xB2,
+    0xCC, 0xCA, 0x69, 0xC7, 0x19, 0x96, 0xAB, 0x55, 0x55, 0x9A, 0xB2, 0xA5, 0x14, 0x12, 0x05, 0x05,
+    0x29, 0x55,
+};
+
+static const uint8_t audioData10[23] = {
+    0xCF, 0x5B, 0x35, 0x34, 0xCA, 0xCB, 0x2D, 0x55, 0x9A, 0xB5, 0x66, 0x69, 0x8C, 0x52, 0x99, 0x9E,
+    0x76, 0xD5, 0x48, 0x90, 0x24, 0xA5, 0xAD,
+};
+
+static const uint8_t audioData11[102] = {
+    0x9B, 0x3A, 0xEE, 0xDE, 0xEF, 0x7B, 0xBD, 0x7C, 0xF3, 0x69, 0xCA, 0x94, 0x92, 0x42, 0x82, 0x20,
+    0x90, 0x28, 0x49, 0x49, 0x9A, 0x75, 0xB7, 0x5F, 0x77, 0x7B, 0xDD, 0xDD, 0xCF, 0x56, 0xAA, 0xA9,
+    0x30, 0x94, 0x14, 0x10, 0x88, 0x42, 0x24, 0x92, 0x99, 0xAB, 0x5C, 0xFB, 0x77, 0xBB, 0xEE, 0xDF,
+    0x3E, 0x75, 0x6A, 0xC6, 0x92, 0x50, 0xA1, 0x10, 0x88, 0x22, 0x12, 0x28, 0xAA, 0x66, 0xCE, 0xDB,
+    0xBB, 0xBD, 0xDF, 0x6F, 0x76, 0xDB, 0x59, 0xCA, 0x98, 0xC2, 0x89, 0x08, 0x88, 0x12, 0x09, 0x12,
+    0x51, 0xA6, 0x73, 0x9E, 0xBD, 0xDD, 0xEF, 0x77, 0xB7, 0x75, 0xD5, 0xAA, 0xAA, 0x4A, 0x24, 0x85,
+    0x02, 0x21, 0x08, 0x88, 0xA4, 0xA6,
+};
+
+static const uint8_t audioData12[92] = {
+    0xB7, 0x6E, 0xB9, 0xCD, 0x55, 0x32, 0x68, 0xE3, 0x35, 0x39, 0xAB, 0x59, 0xCD, 0x66, 0xAB, 0x1C,
+    0x53, 0x14, 0xA5, 0x31, 0xCB, 0x6B, 0xAE, 0xAE, 0x53, 0x0A, 0x08, 0x48, 0x4C, 0x5A, 0xCF, 0x6D,
+    0xDA, 0xEB, 0x35, 0x54, 0xAA, 0x65, 0x34, 0xD5, 0x59, 0xCD, 0x67, 0x4E, 0x6A, 0xAC, 0x69, 0x51,
+    0x8C, 0x54, 0xB1, 0xCE, 0x76, 0xD7, 0x55, 0x4C, 0x18, 0x09, 0x0A, 0x26, 0x6B, 0x6B, 0xD7, 0x9E,
+    0x73, 0x55, 0x4C, 0xA6, 0x55, 0x34, 0xD5, 0x9A, 0xD5, 0xAB, 0x59, 0xAA, 0xB1, 0xA5, 0x26, 0x2A,
+    0x32, 0xAC, 0xD6, 0xDC, 0xF3, 0x55, 0x28, 0x50, 0x12, 0x24, 0x9A, 0x75,
+};
+
+// 1.43 s, 1003 bytes, 6.7 dB SNR (19.1 dB without the packet breaks)
+static const AudioSegment audioClipChordSegments[] = {
+    {audioData0, 345, 7},
+    {audioData1, 348, 7},
+    {audioData2, 310, 12},
+};
+const AudioClip audioClipChord = {audioClipChordSegments, 3, AUDIOCLIPS_BITRATE};
+
+// 0.39 s, 219 bytes, 6.8 dB SNR (20.6 dB without the packet breaks)
+static const AudioSegment audioClipDtmfSegments[] = {
+    {audioData3, 134, 5},
+    {audioData4, 16, 30},
+    {audioData5, 69, 10},
+    {audioData4, 16, 30},
+};
+const AudioClip audioClipDtmf = {audioClipDtmfSegments, 4, AUDIOCLIPS_BITRATE};
+
+// 0.50 s, 3000 bytes, 11.1 dB SNR (21.1 dB without the packet breaks)
+static const AudioSegment audioClipSweepSegments[] = {
+    {audioData6, 1500, 1},
+    {audioData7, 1500, 1},
+};
+const AudioClip audioClipSweep = {audioClipSweepSegments, 2, AUDIOCLIPS_BITRATE};
+
+// 1.31 s, 407 bytes, 6.6 dB SNR (17.7 dB without the packet breaks)
+static const AudioSegment audioClipJingleSegments[] = {
+    {audioData8, 92, 13},
+    {audioData9, 82, 15},
+    {audioData10, 23, 91},
+    {audioData4, 16, 38},
+    {audioData11, 102, 9},
+    {audioData12, 92, 20},
+};
+const AudioClip audioClipJingle = {audioClipJingleSegments, 6, AUDIOCLIPS_BITRATE};
@@ -0,0 +1,348 @@
+/**
+  ******************************************************************************
+  * @file           : beacon.c
+  * @brief          : Beacon schedule derived from beacon_config.h.
+  ******************************************************************************
+  * The beacon cycle (frequency, power ladders, tones, beep and gap lengths)
+  * is built by the compiler as a const radio script in flash: every radio
+  * word is a constant expression, so nothing is computed at boot and nothing
+  * lives on the stack. The checks below turn settings that cannot work into
+  * build errors.
+  *
+  * Frequency, power and period can also be changed at runtime (config.c),
+  * and the top of the power ladders can be capped (powerctl.c).
+  * Beacon_Apply() then rebuilds the same script in RAM with the new words;
+  * beep counts, lengths and tones stay compile-time, so the rebuilt script
+  * is never longer than beaconCycle. The callsign is compiled into a morse
+  * timing stream here as well (morse.c).
+  */
+
+#include "beacon.h"
+#include "radio.h"
+#include "radioscript.h"
+#include "chirp.h"
+
+#define BEACON_FSK_MAX_COUNT 12
+#define BEACON_CW_MAX_COUNT 8
+
+// i-th entry (0 based) of a comma separated list, 0 past its end
+#define BEACON_NTH(i, ...) BEACON_NTH_(i, __VA_ARGS__, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0)
+#define BEACON_NTH_(i, ...) BEACON_NTH_##i(__VA_ARGS__)
+#define BEACON_NTH_0(a0, ...) a0
+#define BEACON_NTH_1(a0, a1, ...) a1
+#define BEACON_NTH_2(a0, a1, a2, ...) a2
+#define BEACON_NTH_3(a0, a1, a2, a3, ...) a3
+#define BEACON_NTH_4(a0, a1, a2, a3, a4, ...) a4
+#define BEACON_NTH_5(a0, a1, a2, a3, a4, a5, ...) a5
+#define BEACON_NTH_6(a0, a1, a2, a3, a4, a5, a6, ...) a6
+#define BEACON_NTH_7(a0, a1, a2, a3, a4, a5, a6, a7, ...) a7
+#define BEACON_NTH_8(a0, a1, a2, a3, a4, a5, a6, a7, a8, ...) a8
+#define BEACON_NTH_9(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, ...) a9
+#define BEACON_NTH_10(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, ...) a10
+#define BEACON_NTH_11(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, ...) a11
+
+#define BEACON_COUNT_ARGS(...) BEACON_COUNT_ARGS_(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
+#define BEACON_COUNT_ARGS_(a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, n, ...) n
+
+#if BEACON_FSK_CUSTOM_TONES
+#define BEACON_FSK_TONE(i) BEACON_NTH(i, BEACON_FSK_CUSTOM_FREQUENCIES)
+#else
+// 320, 400, 480 Hz, doubled for every following group of three
+#define BEACON_FSK_TONE(i) (80 * (4 + (i) % 3) * (1 << ((i) / 3)))
+#endif
+
+// The tone is half the FSK bitrate, which the radio limits to 0.6 - 300 kbps
+#define BEACON_FSK_TONE_OK(i) (BEACON_FSK_TONE(i) >= 300 && BEACON_FSK_TONE(i) <= 150000)
+
+// Power ladders: the strongest beep at BEACON_MAX_POWER, the weakest around -9 dBm
+#define BEACON_STEPSIZE(count) ((count) > 1 ? (31 - 22 + BEACON_MAX_POWER) / ((count) - 1) : 0)
+#define BEACON_FSK_POWER(i) (BEACON_MAX_POWER - BEACON_STEPSIZE(BEACON_FSK_COUNT) * \
+                             (BEACON_FSK_HIGH2LOW ? (i) : BEACON_FSK_COUNT - 1 - (i)))
+#define BEACON_CW_POWER(i) (BEACON_MAX_POWER - BEACON_STEPSIZE(BEACON_CW_COUNT) * \
+                            (BEACON_CW_HIGH2LOW ? (i) : BEACON_CW_COUNT - 1 - (i)))
+
+// Same commands as LED_on(), FSKBeep() / CWBeep(), LED_off(), Radio_Delay()
+#define BEACON_FSK_BEEP(i) \
+    RSCRIPT_LED_ON, \
+    RSCRIPT_STEP_CMD(0x95, 4, RADIO_PA_CONFIG_PARAMS(BEACON_FSK_POWER(i))), \
+    RSCRIPT_STEP_CMD(0x8E, 2, RADIO_TX_PARAMS(BEACON_FSK_POWER(i))), \
+    RSCRIPT_STEP_CMD(0x8B, 8, RADIO_FSK_MOD_PARAMS(BEACON_FSK_TONE(i) * 2, 0x09, 0x1E, 2500)), \
+    RSCRIPT_STEP_TX(BEACON_FSK_LENGTH), \
+    RSCRIPT_LED_OFF, \
+    RSCRIPT_STEP_DELAY(BEACON_FSK_GAP),
+
+#define BEACON_CW_FREQ(i) RF_FREQ_WORD(BEACON_CENTER_FREQ + BEACON_CW_OFFSET * (i), BEACON_FREQ_CORRECTION)
+
+#if BEACON_CW_CHIRP_SPAN
+// The chirp sets the frequency itself (chirp.c)
+#define BEACON_CW_BEEP(i) \
+    RSCRIPT_LED_ON, \
+    RSCRIPT_STEP_CMD(0x95, 4, RADIO_PA_CONFIG_PARAMS(BEACON_CW_POWER(i))), \
+    RSCRIPT_STEP_CMD(0x8E, 2, RADIO_TX_PARAMS(BEACON_CW_POWER(i))), \
+    RSCRIPT_STEP_CMD(0x8B, 8, RADIO_FSK_MOD_PARAMS(2000, 0x00, 0x1E, 0)), \
+    RSCRIPT_STEP_CHIRP(BEACON_CW_FREQ(i), BEACON_CW_LENGTH), \
+    RSCRIPT_LED_OFF, \
+    RSCRIPT_STEP_DELAY(BEACON_CW_GAP),
+#else
+#define BEACON_CW_BEEP(i) \
+    RSCRIPT_LED_ON, \
+    RSCRIPT_STEP_CMD(0x86, 4, RADIO_BYTES32(BEACON_CW_FREQ(i))), \
+    RSCRIPT_STEP_CMD(0x95, 4, RADIO_PA_CONFIG_PARAMS(BEACON_CW_POWER(i))), \
+    RSCRIPT_STEP_CMD(0x8E, 2, RADIO_TX_PARAMS(BEACON_CW_POWER(i))), \
+    RSCRIPT_STEP_CMD(0x8B, 8, RADIO_FSK_MOD_PARAMS(2000, 0x00, 0x1E, 0)), \
+    RSCRIPT_STEP_TX(BEACON_CW_LENGTH), \
+    RSCRIPT_LED_OFF, \
+    RSCRIPT_STEP_DELAY(BEACON_CW_GAP),
+#endif
+
+// Frequency steps of a chirp, the first at the start of the beep
+#define BEACON_CW_CHIRP_STEPS (BEACON_CW_LENGTH * 1000 / BEACON_CW_CHIRP_STEP_US)
+
+_Static_assert(BEACON_FSK_ENABLED || BEACON_CW_ENABLED, "enable FSK or CW beeps");
+_Static_assert(BEACON_CENTER_FREQ + BEACON_CW_ENABLED * (BEACON_CW_CHIRP_SPAN < 0 ? BEACON_CW_CHIRP_SPAN : 0) >= 150000000 &&
+               BEACON_CENTER_FREQ + BEACON_CW_ENABLED * (BEACON_CW_OFFSET * (BEACON_CW_COUNT - 1) + (BEACON_CW_CHIRP_SPAN > 0 ? BEACON_CW_CHIRP_SPAN : 0)) <= 960000000,
+               "frequencies must be within 150 - 960 MHz");
+_Static_assert(BEACON_FREQ_CORRECTION >= -100000 && BEACON_FREQ_CORRECTION <= 100000, "BEACON_FREQ_CORRECTION is in ppb, +-100 ppm at most");
+_Static_assert(BEACON_MAX_POWER >= -17 && BEACON_MAX_POWER <= 22, "BEACON_MAX_POWER must be between -17 and 22 dBm");
+
+_Static_assert(!BEACON_FSK_ENABLED || (BEACON_FSK_COUNT >= 1 && BEACON_FSK_COUNT <= BEACON_FSK_MAX_COUNT), "BEACON_FSK_COUNT must be 1 to 12");
+_Static_assert(!BEACON_FSK_ENABLED || (BEACON_FSK_LENGTH > 0 && BEACON_FSK_LENGTH <= 0xFFFF && BEACON_FSK_GAP >= 0 && BEACON_FSK_GAP <= 0xFFFF),
+               "FSK beep and gap lengths must be 1 - 65535 ms");
+_Static_assert(!BEACON_FSK_ENABLED || !BEACON_FSK_CUSTOM_TONES || BEACON_COUNT_ARGS(BEACON_FSK_CUSTOM_FREQUENCIES) == BEACON_FSK_COUNT,
+               "BEACON_FSK_CUSTOM_FREQUENCIES must have BEACON_FSK_COUNT entries");
+_Static_assert(!BEACON_FSK_ENABLED || ((BEACON_FSK_COUNT <= 0 || BEACON_FSK_TONE_OK(0)) && \
+    (BEACON_FSK_COUNT <= 1 || BEACON_FSK_TONE_OK(1)) && \
+    (BEACON_FSK_COUNT <= 2 || BEACON_FSK_TONE_OK(2)) && \
+    (BEACON_FSK_COUNT <= 3 || BEACON_FSK_TONE_OK(3)) && \
+    (BEACON_FSK_COUNT <= 4 || BEACON_FSK_TONE_OK(4)) && \
+    (BEACON_FSK_COUNT <= 5 || BEACON_FSK_TONE_OK(5)) && \
+    (BEACON_FSK_COUNT <= 6 || BEACON_FSK_TONE_OK(6)) && \
+    (BEACON_FSK_COUNT <= 7 || BEACON_FSK_TONE_OK(7)) && \
+    (BEACON_FSK_COUNT <= 8 || BEACON_FSK_TONE_OK(8)) && \
+    (BEACON_FSK_COUNT <= 9 || BEACON_FSK_TONE_OK(9)) && \
+    (BEACON_FSK_COUNT <= 10 || BEACON_FSK_TONE_OK(10)) && \
+    (BEACON_FSK_COUNT <= 11 || BEACON_FSK_TONE_OK(11))),
+               "FSK tones must be 300 - 150000 Hz");
+
+_Static_assert(!BEACON_CW_ENABLED || (BEACON_CW_COUNT >= 1 && BEACON_CW_COUNT <= BEACON_CW_MAX_COUNT), "BEACON_CW_COUNT must be 1 to 8");
+_Static_assert(!BEACON_CW_ENABLED || (BEACON_CW_LENGTH > 0 && BEACON_CW_LENGTH <= 0xFFFF && BEACON_CW_GAP >= 0 && BEACON_CW_GAP <= 0xFFFF),
+               "CW beep and gap lengths must be 1 - 65535 ms");
+// Each step is a SetRfFrequency on the SUBGHZ SPI, about 0.5 ms
+_Static_assert(!BEACON_CW_ENABLED || !BEACON_CW_CHIRP_SPAN || (BEACON_CW_CHIRP_STEP_US >= 500 && BEACON_CW_CHIRP_STEP_US <= 0xFFFF),
+               "BEACON_CW_CHIRP_STEP_US must be 500 - 65535 us");
+_Static_assert(!BEACON_CW_ENABLED || !BEACON_CW_CHIRP_SPAN || (BEACON_CW_CHIRP_STEPS >= 2 && BEACON_CW_CHIRP_STEPS <= 1000),
+               "a chirp must have 2 - 1000 steps, change BEACON_CW_CHIRP_STEP_US");
+
+_Static_assert(BEACON_GAP_TOTAL >= 0, "the beeps do not fit in BEACON_PERIOD");
+_Static_assert(BEACON_GAP <= 0xFFFF, "BEACON_PERIOD is too long, the gap must stay below 65536 ms");
+_Static_assert(!BEACON_WSPR_ENABLED || (BEACON_WSPR_FREQ >= 150000000 && BEACON_WSPR_FREQ <= 960000000),
+               "BEACON_WSPR_FREQ must be between 150 and 960 MHz");
+_Static_assert(BEACON_LOOP_COUNTER >= 2, "BEACON_CALLSIGN_PERIOD must be at least two BEACON_PERIODs");
+_Static_assert(sizeof(BEACON_CALLSIGN) <= 256, "BEACON_CALLSIGN is too long");
+_Static_assert(BEACON_MORSE_WPM >= 5 && BEACON_MORSE_WPM <= 60, "BEACON_MORSE_WPM must be 5 - 60");
+_Static_assert(BEACON_MORSE_FARNSWORTH_WPM >= 1 && BEACON_MORSE_FARNSWORTH_WPM <= BEACON_MORSE_WPM,
+               "BEACON_MORSE_FARNSWORTH_WPM must be 1 - BEACON_MORSE_WPM");
+
+const uint8_t beaconCycle[] = {
+    RSCRIPT_STEP_CMD(0x86, 4, RADIO_BYTES32(BEACON_RF_FREQ)),
+#if BEACON_FSK_ENABLED
+#if BEACON_FSK_COUNT > 0
+    BEACON_FSK_BEEP(0)
+#endif
+#if BEACON_FSK_COUNT > 1
+    BEACON_FSK_BEEP(1)
+#endif
+#if BEACON_FSK_COUNT > 2
+    BEACON_FSK_BEEP(2)
+#endif
+#if BEACON_FSK_COUNT > 3
+    BEACON_FSK_BEEP(3)
+#endif
+#if BEACON_FSK_COUNT > 4
+    BEACON_FSK_BEEP(4)
+#endif
+#if BEACON_FSK_COUNT > 5
+    BEACON_FSK_BEEP(5)
+#endif
+#if BEACON_FSK_COUNT > 6
+    BEACON_FSK_BEEP(6)
+#endif
+#if BEACON_FSK_COUNT > 7
+    BEACON_FSK_BEEP(7)
+#endif
+#if BEACON_FSK_COUNT > 8
+    BEACON_FSK_BEEP(8)
+#endif
+#if BEACON_FSK_COUNT > 9
+    BEACON_FSK_BEEP(9)
+#endif
+#if BEACON_FSK_COUNT > 10
+    BEACON_FSK_BEEP(10)
+#endif
+#if BEACON_FSK_COUNT > 11
+    BEACON_FSK_BEEP(11)
+#endif
+    RSCRIPT_STEP_DELAY(BEACON_GAP),
+#endif
+#if BEACON_CW_ENABLED
+#if BEACON_CW_COUNT > 0
+    BEACON_CW_BEEP(0)
+#endif
+#if BEACON_CW_COUNT > 1
+    BEACON_CW_BEEP(1)
+#endif
+#if BEACON_CW_COUNT > 2
+    BEACON_CW_BEEP(2)
+#endif
+#if BEACON_CW_COUNT > 3
+    BEACON_CW_BEEP(3)
+#endif
+#if BEACON_CW_COUNT > 4
+    BEACON_CW_BEEP(4)
+#endif
+#if BEACON_CW_COUNT > 5
+    BEACON_CW_BEEP(5)
+#endif
+#if BEACON_CW_COUNT > 6
+    BEACON_CW_BEEP(6)
+#endif
+#if BEACON_CW_COUNT > 7
+    BEACON_CW_BEEP(7)
+#endif
+    RSCRIPT_STEP_DELAY(BEACON_GAP),
+#endif
+    RSCRIPT_END
+};
+
+static uint8_t beaconCallsign[MORSE_STREAM_SIZE(CONFIG_CALLSIGN_SIZE - 1)];
+
+BeaconSchedule beacon = {beaconCycle, BEACON_RF_FREQ, BEACON_GAP, BEACON_LOOP_COUNTER, beaconCallsign};
+
+static uint8_t beaconCycleBuf[sizeof(beaconCycle)];
+
+// Beacon_SetPowerCap(), no beep is sent stronger than this
+static int32_t beaconPowerCap = 22;
+
+#if BEACON_CW_ENABLED && BEACON_CW_CHIRP_SPAN
+static int32_t beaconChirp[BEACON_CW_CHIRP_STEPS];
+#endif
+
+#if BEACON_FSK_ENABLED
+static const uint32_t beaconFskTones[BEACON_FSK_MAX_COUNT] = {
+    BEACON_FSK_TONE(0), BEACON_FSK_TONE(1), BEACON_FSK_TONE(2), BEACON_FSK_TONE(3),
+    BEACON_FSK_TONE(4), BEACON_FSK_TONE(5), BEACON_FSK_TONE(6), BEACON_FSK_TONE(7),
+    BEACON_FSK_TONE(8), BEACON_FSK_TONE(9), BEACON_FSK_TONE(10), BEACON_FSK_TONE(11),
+};
+#endif
+
+// Same as BEACON_GAP for another period, negative when the beeps do not fit
+static int32_t Beacon_Gap(uint32_t period) {
+    int32_t total = (int32_t) period - BEACON_FSK_SPAN - BEACON_CW_SPAN;
+    return BEACON_FSK_ENABLED && BEACON_CW_ENABLED ? total / 2 : total;
+}
+
+// Same as BEACON_FSK_POWER / BEACON_CW_POWER for another maximum power
+static int8_t Beacon_Power(int32_t maxPower, int32_t count, bool high2low, int32_t i) {
+    int32_t stepsize = count > 1 ? (31 - 22 + maxPower) / (count - 1) : 0;
+    int32_t dBm = maxPower - stepsize * (high2low ? i : count - 1 - i);
+    return dBm > beaconPowerCap ? beaconPowerCap : dBm;
+}
+
+// The runtime side of the _Static_asserts above
+bool Beacon_Check(const BeaconConfig *cfg) {
+    int32_t gap = Beacon_Gap(cfg->period);
+    int32_t chirpSpan = BEACON_CW_ENABLED * BEACON_CW_CHIRP_SPAN;
+    uint32_t topFreq = cfg->centerFreq + BEACON_CW_ENABLED * BEACON_CW_OFFSET * (BEACON_CW_COUNT - 1) + (chirpSpan > 0 ? chirpSpan : 0);
+    uint32_t bottomFreq = cfg->centerFreq + (chirpSpan < 0 ? chirpSpan : 0);
+    return gap >= 0 && gap <= 0xFFFF && topFreq <= 960000000 && bottomFreq >= 150000000 &&
+           cfg->callsignPeriod * 1000 / cfg->period >= 2 && cfg->morseFarnsworthWpm <= cfg->morseWpm;
+}
+
+static void Beacon_AppendPower(RadioScript *script, int8_t dBm) {
+    const uint8_t paConfig[] = {RADIO_PA_CONFIG_PARAMS(dBm)};
+    const uint8_t txParams[] = {RADIO_TX_PARAMS(dBm)};
+    RadioScript_AppendCmd(script, 0x95, paConfig, sizeof(paConfig));
+    RadioScript_AppendCmd(script, 0x8E, txParams, sizeof(txParams));
+}
+
+static void Beacon_AppendFreq(RadioScript *script, uint32_t freq) {
+    const uint8_t params[] = {RADIO_BYTES32(freq)};
+    RadioScript_AppendCmd(script, 0x86, params, sizeof(params));
+}
+
+// Same steps as beaconCycle, the words computed from cfg
+static bool Beacon_Build(const BeaconConfig *cfg, uint32_t rfFreq, uint32_t gap) {
+    RadioScript script;
+    RadioScript_Init(&script, beaconCycleBuf, sizeof(beaconCycleBuf));
+    Beacon_AppendFreq(&script, rfFreq);
+#if BEACON_FSK_ENABLED
+    for (int32_t i = 0; i < BEACON_FSK_COUNT; i++) {
+        const uint8_t modParams[] = {RADIO_FSK_MOD_PARAMS(beaconFskTones[i] * 2, 0x09, 0x1E, 2500)};
+        RadioScript_AppendLed(&script, true);
+        Beacon_AppendPower(&script, Beacon_Power(cfg->maxPower, BEACON_FSK_COUNT, BEACON_FSK_HIGH2LOW, i));
+        RadioScript_AppendCmd(&script, 0x8B, modParams, sizeof(modParams));
+        RadioScript_AppendTx(&script, BEACON_FSK_LENGTH);
+        RadioScript_AppendLed(&script, false);
+        RadioScript_AppendDelay(&script, BEACON_FSK_GAP);
+    }
+    RadioScript_AppendDelay(&script, gap);
+#endif
+#if BEACON_CW_ENABLED
+    const uint8_t cwModParams[] = {RADIO_FSK_MOD_PARAMS(2000, 0x00, 0x1E, 0)};
+    for (int32_t i = 0; i < BEACON_CW_COUNT; i++) {
+        uint32_t cwFreq = RF_FREQ_WORD(cfg->centerFreq + BEACON_CW_OFFSET * i, cfg->freqCorrection);
+        RadioScript_AppendLed(&script, true);
+#if !BEACON_CW_CHIRP_SPAN
+        Beacon_AppendFreq(&script, cwFreq);
+#endif
+        Beacon_AppendPower(&script, Beacon_Power(cfg->maxPower, BEACON_CW_COUNT, BEACON_CW_HIGH2LOW, i));
+        RadioScript_AppendCmd(&script, 0x8B, cwModParams, sizeof(cwModParams));
+#if BEACON_CW_CHIRP_SPAN
+        RadioScript_AppendChirp(&script, cwFreq, BEACON_CW_LENGTH);
+#else
+        RadioScript_AppendTx(&script, BEACON_CW_LENGTH);
+#endif
+        RadioScript_AppendLed(&script, false);
+        RadioScript_AppendDelay(&script, BEACON_CW_GAP);
+    }
+    RadioScript_AppendDelay(&script, gap);
+#endif
+    return !script.overflow;
+}
+
+// Switches the beacon to cfg, which must have passed Config_Check()
+void Beacon_Apply(const BeaconConfig *cfg) {
+    uint32_t rfFreq = RF_FREQ_WORD(cfg->centerFreq, cfg->freqCorrection);
+    uint32_t gap = Beacon_Gap(cfg->period);
+    const uint8_t *cycle = beaconCycle;
+
+    // The compiled-in cycle covers the defaults, no need for a RAM copy
+    if (cfg->centerFreq != BEACON_CENTER_FREQ || cfg->freqCorrection != BEACON_FREQ_CORRECTION ||
+        cfg->maxPower != BEACON_MAX_POWER || cfg->period != BEACON_PERIOD || beaconPowerCap < cfg->maxPower) {
+        if (!Beacon_Build(cfg, rfFreq, gap)) {
+            Error_Handler();
+        }
+        cycle = beaconCycleBuf;
+    }
+
+#if BEACON_CW_ENABLED && BEACON_CW_CHIRP_SPAN
+    Chirp_Build(beaconChirp, BEACON_CW_CHIRP_STEPS, BEACON_CW_CHIRP_SPAN, BEACON_CW_CHIRP_STEP_US);
+#endif
+
+    beacon.cycle = cycle;
+    beacon.rfFreq = rfFreq;
+    beacon.gap = gap;
+    beacon.loopCounter = cfg->callsignPeriod * 1000 / cfg->period;
+
+    // Sized for the longest callsign, cannot fail
+    if (!Morse_Compile(cfg->callsign, beaconCallsign, sizeof(beaconCallsign))) {
+        Error_Handler();
+    }
+    beacon.morse = Morse_Timing(cfg->morseWpm, cfg->morseFarnsworthWpm);
+}
+
+// Caps the power ladders, the steps below the cap stay where they are
+void Beacon_SetPowerCap(int32_t dBm) {
+    beaconPowerCap = dBm;
+    Beacon_Apply(&config);
+}
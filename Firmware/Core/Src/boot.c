@@ -0,0 +1,155 @@
+/**
+  ******************************************************************************
+  * @file           : boot.c
+  * @brief          : Reset cause and the wait for the supply before beaconing.
+  ******************************************************************************
+  * A coin cell that browns out under a TX pulse resets the MCU and recovers
+  * within a fraction of a second once the load is gone. Waiting the full
+  * BEACON_STARTUP_WAIT after such a reset would leave the beacon silent
+  * for seconds at every brownout, so that wait is kept for power-on only.
+  *
+  * Power-on and brownout both set BORRSTF, so they are told apart by a
+  * marker in SRAM2 that is not cleared by the startup code: it is only
+  * still there if the RAM kept its contents through the reset. After any
+  * other reset the beacon starts once the supply is above
+  * BEACON_BOOT_MIN_MV and no longer rising, measured through VREFINT
+  * while sleeping in Stop2.
+  *
+  * The same SRAM2 block keeps the position in the beacon loop. After a
+  * warm reset the loop continues with the cycle that was interrupted
+  * instead of starting over with the callsign, so the callsign keeps its
+  * period and the cycle count keeps counting. It also keeps the power
+  * ladder cap (powerctl.c), so a brownout does not start it over at full
+  * power.
+  */
+
+#include "boot.h"
+#include "beacon_config.h"
+#include "console.h"
+#include "lowpower.h"
+#include "radio.h"
+#include "supply.h"
+
+#define BOOT_MARKER 0xB0075AFEU
+
+// Supply sampling while waiting for the cell to recover
+#define BOOT_POLL_MS 20
+#define BOOT_SETTLED_MV 10 // rise per poll below which the supply is settled
+
+BootInfo bootInfo;
+
+// Not cleared by the startup code, see the linker script .noinit section
+static struct {
+    uint32_t marker[2];
+    BeaconPosition position;
+    int32_t powerCapDbm;
+    uint32_t check;
+} retained __attribute__((section(".noinit")));
+
+static const struct {
+    uint8_t flag;
+    const char *name;
+} resetNames[] = {
+    {RCC_CSR_LPWRRSTF >> 24, "low power"},
+    {RCC_CSR_WWDGRSTF >> 24, "window watchdog"},
+    {RCC_CSR_IWDGRSTF >> 24, "watchdog"},
+    {RCC_CSR_SFTRSTF >> 24, "software"},
+    {RCC_CSR_BORRSTF >> 24, "brownout"},
+    {RCC_CSR_PINRSTF >> 24, "reset pin"},
+    {RCC_CSR_OBLRSTF >> 24, "option bytes"},
+    {RCC_CSR_RFILARSTF >> 24, "radio illegal access"},
+};
+
+// Reads and clears the reset flags, before anything else looks at them
+void Boot_Init(void) {
+    bootInfo.resetFlags = RCC->CSR >> 24;
+    __HAL_RCC_CLEAR_RESET_FLAGS();
+
+    bootInfo.warm = retained.marker[0] == BOOT_MARKER && retained.marker[1] == ~BOOT_MARKER;
+    retained.marker[0] = BOOT_MARKER;
+    retained.marker[1] = ~BOOT_MARKER;
+}
+
+static uint32_t Boot_Check(void) {
+    const BeaconPosition *position = &retained.position;
+    return BOOT_MARKER ^ position->phase ^ (position->cycle * 0x9E3779B1U) ^ __ROR(position->cycles, 16) ^
+           ((uint32_t) retained.powerCapDbm << 24);
+}
+
+// Called from the beacon loop before every step, a few stores into SRAM2
+void Boot_SavePosition(const BeaconPosition *position) {
+    retained.position = *position;
+    retained.check = Boot_Check();
+}
+
+// Called when the power ladder cap changes
+void Boot_SavePowerCap(int32_t dBm) {
+    retained.powerCapDbm = dBm;
+    retained.check = Boot_Check();
+}
+
+// The saved position if it survived the reset and fits the schedule
+bool Boot_Resume(BeaconPosition *position) {
+    bootInfo.resumed = bootInfo.warm && retained.check == Boot_Check() &&
+                       retained.position.phase <= BEACON_PHASE_CYCLES &&
+                       retained.position.cycle < beacon.loopCounter - 1;
+    if (bootInfo.resumed) {
+        *position = retained.position;
+    }
+    return bootInfo.resumed;
+}
+
+// The power ladder cap before the reset, false unless Boot_Resume() succeeded
+bool Boot_ResumePowerCap(int32_t *dBm) {
+    if (bootInfo.resumed) {
+        *dBm = retained.powerCapDbm;
+    }
+    return bootInfo.resumed;
+}
+
+void Boot_WaitForSupply(void) {
+    uint32_t start = HAL_GetTick();
+
+    if (!bootInfo.warm) {
+        LowPower_Delay(BEACON_STARTUP_WAIT);
+        bootInfo.supplyMv = Supply_MeasureMv();
+        bootInfo.waitMs = HAL_GetTick() - start;
+        return;
+    }
+
+    // Only a brownout leaves the cell recovering, after other resets one
+    // good measurement is enough
+    bool brownout = (bootInfo.resetFlags & (RCC_CSR_BORRSTF >> 24)) != 0;
+    uint32_t mv = Supply_MeasureMv();
+    uint32_t last = 0;
+    while (HAL_GetTick() - start < BEACON_STARTUP_WAIT) {
+        // A failed measurement (0) never passes, the wait then ends on time
+        if (mv >= BEACON_BOOT_MIN_MV && (!brownout || mv < last + BOOT_SETTLED_MV)) {
+            break;
+        }
+        last = mv;
+        LowPower_Delay(BOOT_POLL_MS);
+        mv = Supply_MeasureMv();
+    }
+    bootInfo.supplyMv = mv;
+    bootInfo.waitMs = HAL_GetTick() - start;
+}
+
+// From reset to the first SetTx, 0 before it. The HAL tick starts in
+// HAL_Init(), well under a millisecond after the reset.
+uint32_t Boot_FirstBeepMs(void) {
+    return radioTiming.firstTxTick;
+}
+
+void Boot_Dump(void) {
+    Console_Printf("reset:");
+    for (uint8_t i = 0; i < sizeof(resetNames) / sizeof(resetNames[0]); i++) {
+        if (bootInfo.resetFlags & resetNames[i].flag) {
+            Console_Printf(" %s", resetNames[i].name);
+        }
+    }
+    Console_Printf(" (%02lx), %s\r\n", (unsigned long) bootInfo.resetFlags, bootInfo.warm ? "warm" : "power-on");
+    Console_Printf("waited %lu ms, supply %lu mV, first beep %lu ms after reset (%s)\r\n", (unsigned long) bootInfo.waitMs,
+                   (unsigned long) bootInfo.supplyMv, (unsigned long) Boot_FirstBeepMs(),
+                   bootInfo.resumed ? "resumed" : "from the start");
+}
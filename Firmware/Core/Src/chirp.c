@@ -0,0 +1,123 @@
+/**
+  ******************************************************************************
+  * @file           : chirp.c
+  * @brief          : Carrier swept through a table of frequency steps in one transmission.
+  ******************************************************************************
+  * A chirp is a CW beep whose frequency rises (or falls) in even steps
+  * while the radio transmits. The steps are frequency word offsets,
+  * computed once by Chirp_Build(); TIM16 then interrupts once per step and
+  * the interrupt only adds the offset to the start word and sends
+  * SetRfFrequency. The radio follows a new frequency during TX.
+  *
+  * Each step is a 5 byte SUBGHZ command, about 0.4 ms on the 125 kHz SPI
+  * plus the HAL overhead at the 1 MHz core clock, which limits the step
+  * rate. Every step is timed with the DWT cycle counter, the 'h' console
+  * command prints the average and worst case and the step rate they allow.
+  *
+  * TIM16 does not run in Stop2, so the core only waits in Sleep mode
+  * (LowPower_RequestRun()) during a chirp. It shares the priority of the
+  * radio IRQ, so neither interrupts the other's SPI transfer.
+  */
+
+#include "chirp.h"
+#include "radio.h"
+#include "rfmath.h"
+#include "lowpower.h"
+#include "console.h"
+#include "radioscript.h"
+#include "cycles.h"
+
+ChirpStats chirpStats;
+
+static const int32_t *chirpTable;
+static uint16_t chirpCount;
+static uint32_t chirpStepUs;
+
+// Set up by Chirp_Tx(), stepped by the interrupt
+static uint32_t chirpRfFreq;
+static volatile uint16_t chirpNext;
+
+void Chirp_Init(void) {
+    // TIM16 counts microseconds: PCLK2 is 1 MHz on both the MSI and the HSE clock
+    __HAL_RCC_TIM16_CLK_ENABLE();
+    TIM16->CR1 = TIM_CR1_URS;
+    TIM16->PSC = 0;
+    TIM16->DIER = TIM_DIER_UIE;
+    HAL_NVIC_SetPriority(TIM16_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(TIM16_IRQn);
+
+    Cycles_Enable();
+}
+
+// A linear sweep over spanHz in count steps of stepUs, into table
+void Chirp_Build(int32_t *table, uint16_t count, int32_t spanHz, uint32_t stepUs) {
+    uint32_t span = spanHz < 0 ? -spanHz : spanHz;
+    for (uint16_t i = 0; i < count; i++) {
+        int32_t word = (int32_t) ComputeRfFreq(count > 1 ? span * i / (count - 1) : 0, 0);
+        table[i] = spanHz < 0 ? -word : word;
+    }
+    chirpTable = table;
+    chirpCount = count;
+    chirpStepUs = stepUs;
+}
+
+// One CW transmission of lengthMs starting at rfFreq, stepping through the
+// table built last. The CW modulation and power must already be set.
+void Chirp_Tx(uint32_t rfFreq, uint32_t lengthMs) {
+    if (radioRecorder) {
+        RadioScript_AppendChirp(radioRecorder, rfFreq, lengthMs);
+        return;
+    }
+
+    chirpRfFreq = rfFreq;
+    chirpNext = 1;
+    SetRfFreq(rfFreq + chirpTable[0]);
+
+    LowPower_RequestRun();
+    Radio_StartTx(lengthMs);
+    TIM16->ARR = chirpStepUs - 1;
+    TIM16->CNT = 0;
+    TIM16->SR = 0;
+    TIM16->CR1 |= TIM_CR1_CEN;
+
+    Radio_SampleTxSupply(lengthMs);
+    // TIM16 must be stopped before a missed TX-done IRQ makes Radio_WaitTx()
+    // send SetStandby, a step could otherwise interrupt it with SetRfFrequency
+    Radio_SleepTx();
+    TIM16->CR1 &= ~TIM_CR1_CEN;
+    Radio_WaitTx();
+    LowPower_ReleaseRun();
+    chirpStats.chirps++;
+}
+
+void Chirp_Dump(void) {
+    uint32_t avg = chirpStats.steps ? chirpStats.totalCycles / chirpStats.steps : 0;
+    Console_Printf("chirps %lu, steps %lu, overruns %lu\r\n", chirpStats.chirps, chirpStats.steps, chirpStats.overruns);
+    Console_Printf("step %lu us, SetRfFrequency avg %lu us, max %lu us\r\n", chirpStepUs,
+                   Cycles_ToUs(avg), Cycles_ToUs(chirpStats.maxCycles));
+    if (chirpStats.maxCycles > 0) {
+        Console_Printf("up to %lu steps/s (%lu on average)\r\n", SystemCoreClock / chirpStats.maxCycles,
+                       avg ? SystemCoreClock / avg : 0);
+    }
+}
+
+void Chirp_IRQHandler(void) {
+    TIM16->SR = 0;
+    // The last frequency is held until the radio ends the transmission
+    if (chirpNext >= chirpCount) {
+        return;
+    }
+
+    uint32_t start = DWT->CYCCNT;
+    SetRfFreq(chirpRfFreq + chirpTable[chirpNext++]);
+    uint32_t cycles = DWT->CYCCNT - start;
+
+    chirpStats.steps++;
+    chirpStats.totalCycles += cycles;
+    if (cycles > chirpStats.maxCycles) {
+        chirpStats.maxCycles = cycles;
+    }
+    if (TIM16->SR & TIM_SR_UIF) {
+        chirpStats.overruns++;
+    }
+}
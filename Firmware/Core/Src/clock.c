@@ -0,0 +1,89 @@
+/**
+  ******************************************************************************
+  * @file           : clock.c
+  * @brief          : MSI idle clock with on-demand HSE.
+  ******************************************************************************
+  * The MCU normally runs from MSI at 1 MHz with all bus prescalers at /1.
+  * That gives the same 1 MHz HCLK, HCLK3 and PCLK1 as SystemClock_Config()
+  * (HSE32 / 2 / 16), so SysTick, the UART baud rate and the SUBGHZ SPI
+  * prescaler are the same whichever clock is active.
+  *
+  * The radio does not need the MCU on HSE: the SUBGHZ SPI is clocked from
+  * PCLK3 and the radio turns HSE32 on by itself for STDBY_XOSC and TX.
+  * Code that needs the crystal accuracy on the MCU side brackets itself with
+  * Clock_RequestHSE() / Clock_ReleaseHSE(); the HSE runs only while at least
+  * one request is open.
+  *
+  * Stop2 keeps the MSI range and the prescalers and wakes up on MSI, so an
+  * MSI system clock is already correct after wake-up and the HSE start-up
+  * time is no longer paid on every wake-up.
+  */
+
+#include "clock.h"
+
+static uint8_t hseRequests;
+
+static void Clock_ConfigMSI(void) {
+    RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+    RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+
+    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_MSI;
+    RCC_OscInitStruct.MSIState = RCC_MSI_ON;
+    RCC_OscInitStruct.MSICalibrationValue = RCC_MSICALIBRATION_DEFAULT;
+    RCC_OscInitStruct.MSIClockRange = RCC_MSIRANGE_4; // 1 MHz
+    RCC_OscInitStruct.PLL.PLLState = RCC_PLL_NONE;
+    if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK) {
+        Error_Handler();
+    }
+
+    // Switch SYSCLK first while the /16 prescalers are still set, otherwise
+    // HCLK would briefly run at 16 MHz from the HSE with zero wait states.
+    RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_SYSCLK;
+    RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_MSI;
+    if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_0) != HAL_OK) {
+        Error_Handler();
+    }
+
+    RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK3|RCC_CLOCKTYPE_HCLK
+                                |RCC_CLOCKTYPE_PCLK1|RCC_CLOCKTYPE_PCLK2;
+    RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+    RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV1;
+    RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+    RCC_ClkInitStruct.AHBCLK3Divider = RCC_SYSCLK_DIV1;
+    if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_0) != HAL_OK) {
+        Error_Handler();
+    }
+
+    // Release the MCU's HSE request, the radio keeps its own
+    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSE;
+    RCC_OscInitStruct.HSEState = RCC_HSE_OFF;
+    RCC_OscInitStruct.MSIState = RCC_MSI_ON;
+    if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK) {
+        Error_Handler();
+    }
+}
+
+// Moves from the boot clock (SystemClock_Config) to the MSI idle clock
+void Clock_Init(void) {
+    hseRequests = 0;
+    Clock_ConfigMSI();
+}
+
+void Clock_RequestHSE(void) {
+    if (hseRequests++ == 0) {
+        SystemClock_Config();
+    }
+}
+
+void Clock_ReleaseHSE(void) {
+    if (hseRequests > 0 && --hseRequests == 0) {
+        Clock_ConfigMSI();
+    }
+}
+
+// Stop2 wakes up on MSI, bring the HSE back if it was in use
+void Clock_RestoreAfterStop(void) {
+    if (hseRequests > 0) {
+        SystemClock_Config();
+    }
+}
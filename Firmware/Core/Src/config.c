@@ -0,0 +1,323 @@
+/**
+  ******************************************************************************
+  * @file           : config.c
+  * @brief          : Runtime settings stored in the emulated EEPROM.
+  ******************************************************************************
+  * The settings are one record of 32 bit EEPROM variables: a header with the
+  * schema version and word count, a CRC-32 computed with hcrc, and the
+  * BeaconConfig words. Boot reads the whole record once; anything missing,
+  * torn, newer than this firmware or out of range falls back to the
+  * beacon_config.h defaults. The console edits the record in RAM, applies it
+  * to the beacon schedule and writes it back on request.
+  */
+
+#include "config.h"
+#include "beacon.h"
+#include "console.h"
+#include "cycles.h"
+#include "flashwork.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern CRC_HandleTypeDef hcrc;
+
+// eeprom_emul.c, sets the CRC unit up for the EEPROM element CRC
+void ConfigureCrc(void);
+
+// Flash reserved for the EEPROM emulation, STM32WLE5CBUX_FLASH.ld
+extern uint8_t _eeprom_emul_start[];
+extern uint8_t _eeprom_emul_end[];
+
+// EEPROM virtual addresses, 0 is not a valid one
+#define CONFIG_EE_HEADER 1U // CONFIG_MAGIC | version << 8 | number of words
+#define CONFIG_EE_CRC    2U // CRC-32 of the header and the words
+#define CONFIG_EE_DATA   3U // the BeaconConfig words
+
+#define CONFIG_MAGIC 0xBEAC0000U
+
+_Static_assert(sizeof(BeaconConfig) % 4 == 0, "BeaconConfig must be whole words");
+_Static_assert(CONFIG_WORDS <= 0xFF, "BeaconConfig word count must fit the header");
+_Static_assert(CONFIG_EE_DATA + CONFIG_WORDS <= NB_OF_VARIABLES, "not enough EEPROM variables for BeaconConfig");
+_Static_assert(sizeof(BEACON_CALLSIGN) <= CONFIG_CALLSIGN_SIZE, "BEACON_CALLSIGN does not fit the stored callsign");
+
+typedef enum {
+    CONFIG_FIELD_U32,
+    CONFIG_FIELD_I32,
+    CONFIG_FIELD_STR,
+} ConfigFieldType;
+
+typedef struct {
+    const char *name;
+    ConfigFieldType type;
+    uint8_t offset;
+    int32_t min; // ranges of numbers, strings are printable ASCII
+    int32_t max;
+} ConfigField;
+
+static const ConfigField fields[] = {
+    {"freq", CONFIG_FIELD_U32, offsetof(BeaconConfig, centerFreq), 150000000, 960000000},
+    {"correction", CONFIG_FIELD_I32, offsetof(BeaconConfig, freqCorrection), -100000, 100000},
+    {"power", CONFIG_FIELD_I32, offsetof(BeaconConfig, maxPower), -17, 22},
+    {"period", CONFIG_FIELD_U32, offsetof(BeaconConfig, period), 1, 600000},
+    {"callsign_on", CONFIG_FIELD_U32, offsetof(BeaconConfig, callsignEnabled), 0, 1},
+    {"callsign_period", CONFIG_FIELD_U32, offsetof(BeaconConfig, callsignPeriod), 1, 86400},
+    {"callsign", CONFIG_FIELD_STR, offsetof(BeaconConfig, callsign), 0, 0},
+    {"wpm", CONFIG_FIELD_U32, offsetof(BeaconConfig, morseWpm), 5, 60},
+    {"farnsworth_wpm", CONFIG_FIELD_U32, offsetof(BeaconConfig, morseFarnsworthWpm), 1, 60},
+};
+
+static const char *const statusNames[] = {
+    "eeprom",
+    "defaults, no eeprom",
+    "defaults, blank",
+    "defaults, newer version",
+    "defaults, bad crc",
+    "defaults, invalid",
+};
+
+BeaconConfig config;
+ConfigStatus configStatus = CONFIG_NO_EEPROM;
+uint32_t configInitUs;
+uint32_t configLoadUs;
+
+static bool eeReady;
+
+void Config_Defaults(BeaconConfig *cfg) {
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->centerFreq = BEACON_CENTER_FREQ;
+    cfg->freqCorrection = BEACON_FREQ_CORRECTION;
+    cfg->maxPower = BEACON_MAX_POWER;
+    cfg->period = BEACON_PERIOD;
+    cfg->callsignEnabled = BEACON_CALLSIGN_ENABLED;
+    cfg->callsignPeriod = BEACON_CALLSIGN_PERIOD;
+    strcpy(cfg->callsign, BEACON_CALLSIGN);
+    cfg->morseWpm = BEACON_MORSE_WPM;
+    cfg->morseFarnsworthWpm = BEACON_MORSE_FARNSWORTH_WPM;
+}
+
+bool Config_Check(const BeaconConfig *cfg) {
+    for (uint8_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        const ConfigField *field = &fields[i];
+        const uint8_t *value = (const uint8_t *) cfg + field->offset;
+        if (field->type == CONFIG_FIELD_STR) {
+            // The morse table covers ' ' to 'z'
+            const char *s = (const char *) value;
+            size_t len = strnlen(s, CONFIG_CALLSIGN_SIZE);
+            if (len == CONFIG_CALLSIGN_SIZE) {
+                return false;
+            }
+            for (size_t j = 0; j < len; j++) {
+                if (s[j] < ' ' || s[j] > 'z') {
+                    return false;
+                }
+            }
+        } else if (field->type == CONFIG_FIELD_I32) {
+            int32_t v = *(const int32_t *) value;
+            if (v < field->min || v > field->max) {
+                return false;
+            }
+        } else {
+            uint32_t v = *(const uint32_t *) value;
+            if (v < (uint32_t) field->min || v > (uint32_t) field->max) {
+                return false;
+            }
+        }
+    }
+    return Beacon_Check(cfg);
+}
+
+// The EEPROM emulation keeps the CRC unit set up for its own 16 bit CRC,
+// so hcrc is reapplied for the record CRC and handed back afterwards.
+static uint32_t Config_Crc(const uint32_t *words, uint32_t count) {
+    HAL_CRC_Init(&hcrc);
+    uint32_t crc = HAL_CRC_Calculate(&hcrc, (uint32_t *) words, count * 4);
+    ConfigureCrc();
+    return crc;
+}
+
+static uint32_t Config_ElapsedUs(uint32_t start) {
+    return Cycles_ToUs(DWT->CYCCNT - start);
+}
+
+static ConfigStatus Config_Read(BeaconConfig *cfg) {
+    if (!eeReady) {
+        return CONFIG_NO_EEPROM;
+    }
+
+    uint32_t words[1 + CONFIG_WORDS];
+    EE_Status status = EE_ReadVariable32bits(CONFIG_EE_HEADER, &words[0]);
+    if (status == EE_NO_DATA) {
+        return CONFIG_BLANK;
+    }
+    if (status != EE_OK || (words[0] & 0xFFFF0000U) != CONFIG_MAGIC) {
+        return CONFIG_BAD_CRC;
+    }
+
+    uint32_t version = (words[0] >> 8) & 0xFF;
+    uint32_t count = words[0] & 0xFF;
+    if (version > CONFIG_VERSION || count > CONFIG_WORDS) {
+        return CONFIG_BAD_VERSION;
+    }
+
+    uint32_t crc;
+    if (EE_ReadVariable32bits(CONFIG_EE_CRC, &crc) != EE_OK) {
+        return CONFIG_BAD_CRC;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (EE_ReadVariable32bits(CONFIG_EE_DATA + i, &words[1 + i]) != EE_OK) {
+            return CONFIG_BAD_CRC;
+        }
+    }
+    if (Config_Crc(words, 1 + count) != crc) {
+        return CONFIG_BAD_CRC;
+    }
+
+    // Fields newer than the stored version keep their defaults
+    BeaconConfig loaded;
+    Config_Defaults(&loaded);
+    memcpy(&loaded, &words[1], count * 4);
+    if (!Config_Check(&loaded)) {
+        return CONFIG_INVALID;
+    }
+    *cfg = loaded;
+    return CONFIG_OK;
+}
+
+// Starts the EEPROM emulation and loads the settings, or the defaults
+ConfigStatus Config_Load(void) {
+    Cycles_Enable();
+
+    Config_Defaults(&config);
+
+    uint32_t start = DWT->CYCCNT;
+    // Pages the linker did not reserve could hold code, pages past the end of
+    // this part's flash would fault on the first read
+    if (START_PAGE_ADDRESS == (uint32_t) _eeprom_emul_start && END_EEPROM_ADDRESS < (uint32_t) _eeprom_emul_end &&
+        END_EEPROM_ADDRESS <= FLASH_END_ADDR) {
+        FlashWork_Unlock();
+        eeReady = EE_Init(EE_CONDITIONAL_ERASE) == EE_OK;
+        FlashWork_Lock();
+    }
+    configInitUs = Config_ElapsedUs(start);
+
+    start = DWT->CYCCNT;
+    configStatus = Config_Read(&config);
+    configLoadUs = Config_ElapsedUs(start);
+    return configStatus;
+}
+
+// Unchanged words are not rewritten, every write uses up flash
+static bool Config_WriteWord(uint16_t address, uint32_t value) {
+    uint32_t stored;
+    if (EE_ReadVariable32bits(address, &stored) == EE_OK && stored == value) {
+        return true;
+    }
+    EE_Status status = EE_WriteVariable32bits(address, value);
+    if (status == EE_CLEANUP_REQUIRED) {
+        // The old pages are erased in the next long radio idle window
+        FlashWork_Request(FLASHWORK_EE_CLEANUP);
+        status = EE_OK;
+    }
+    return status == EE_OK;
+}
+
+bool Config_Save(void) {
+    if (!eeReady || !Config_Check(&config)) {
+        return false;
+    }
+
+    // A page transfer needs the pages of the previous one erased
+    FlashWork_Flush();
+
+    uint32_t words[1 + CONFIG_WORDS];
+    words[0] = CONFIG_MAGIC | (CONFIG_VERSION << 8) | CONFIG_WORDS;
+    memcpy(&words[1], &config, sizeof(config));
+    uint32_t crc = Config_Crc(words, 1 + CONFIG_WORDS);
+
+    // Data before CRC: a reset halfway leaves a record that fails its check
+    FlashWork_Unlock();
+    bool ok = true;
+    for (uint32_t i = 0; ok && i < CONFIG_WORDS; i++) {
+        ok = Config_WriteWord(CONFIG_EE_DATA + i, words[1 + i]);
+    }
+    ok = ok && Config_WriteWord(CONFIG_EE_CRC, crc);
+    ok = ok && Config_WriteWord(CONFIG_EE_HEADER, words[0]);
+    FlashWork_Lock();
+    return ok;
+}
+
+static void Config_PrintField(const ConfigField *field, const BeaconConfig *cfg) {
+    const uint8_t *value = (const uint8_t *) cfg + field->offset;
+    if (field->type == CONFIG_FIELD_STR) {
+        Console_Printf("%s=%s\r\n", field->name, (const char *) value);
+    } else if (field->type == CONFIG_FIELD_I32) {
+        Console_Printf("%s=%ld\r\n", field->name, (long) *(const int32_t *) value);
+    } else {
+        Console_Printf("%s=%lu\r\n", field->name, (unsigned long) *(const uint32_t *) value);
+    }
+}
+
+void Config_Dump(void) {
+    Console_Printf("config v%u, %s, init %lu us, load %lu us\r\n", CONFIG_VERSION, statusNames[configStatus],
+                   (unsigned long) configInitUs, (unsigned long) configLoadUs);
+    for (uint8_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        Config_PrintField(&fields[i], &config);
+    }
+}
+
+// Reads name=value from the console and applies it to the running beacon
+void Config_Set(void) {
+    char line[40];
+    Console_Printf("name=value: ");
+    if (!Console_ReadLine(line, sizeof(line))) {
+        return;
+    }
+
+    char *value = strchr(line, '=');
+    const ConfigField *field = NULL;
+    if (value) {
+        *value++ = '\0';
+        for (uint8_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+            if (strcmp(fields[i].name, line) == 0) {
+                field = &fields[i];
+            }
+        }
+    }
+    if (!field) {
+        Console_Printf("unknown setting, see c\r\n");
+        return;
+    }
+
+    BeaconConfig edited = config;
+    uint8_t *dest = (uint8_t *) &edited + field->offset;
+    if (field->type == CONFIG_FIELD_STR) {
+        strncpy((char *) dest, value, CONFIG_CALLSIGN_SIZE);
+    } else {
+        char *end;
+        int32_t v = strtol(value, &end, 0);
+        if (end == value || *end != '\0') {
+            Console_Printf("not a number\r\n");
+            return;
+        }
+        memcpy(dest, &v, 4);
+    }
+
+    if (!Config_Check(&edited)) {
+        Console_Printf("out of range\r\n");
+        return;
+    }
+    config = edited;
+    Beacon_Apply(&config);
+    Config_PrintField(field, &config);
+}
+
+void Config_Write(void) {
+    Console_Printf(Config_Save() ? "saved\r\n" : "save failed\r\n");
+}
+
+void Config_Reset(void) {
+    Config_Defaults(&config);
+    Beacon_Apply(&config);
+    Console_Printf("defaults, w to save\r\n");
+}
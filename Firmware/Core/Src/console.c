@@ -0,0 +1,185 @@
+/**
+  ******************************************************************************
+  * @file           : console.c
+  * @brief          : Single-key command console on USART2.
+  ******************************************************************************
+  * USART2 is not clocked in Stop2, so the RX pin (PA3) also drives EXTI
+  * line 3: the start bit of any character wakes the MCU and marks the
+  * console as requested. The beacon loop calls Console_Poll() between
+  * cycles, which prints a prompt and waits briefly for a command key.
+  * 9600 baud, 8N1.
+  *
+  * PA3 is pulled up so an unconnected header idles like a UART line. A
+  * falling edge can still come from noise or a cable being plugged in, so
+  * after the first CONSOLE_OPEN_WINDOW_MS from power-on the prompt is only
+  * shown once a character arrives without a framing or noise error.
+  */
+
+#include "console.h"
+#include "energy.h"
+#include "config.h"
+#include "flashwork.h"
+#include "flightlog.h"
+#include "boot.h"
+#include "powerctl.h"
+#include "radiotrace.h"
+#include "chirp.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+extern UART_HandleTypeDef huart2;
+
+// How long Console_Poll() waits for the command key after the prompt
+#define CONSOLE_KEY_TIMEOUT_MS 3000
+
+// How long Console_ReadLine() waits for each character
+#define CONSOLE_LINE_TIMEOUT_MS 30000
+
+// Time after power-on in which any wake-up of the RX line opens the console
+#define CONSOLE_OPEN_WINDOW_MS 120000
+
+// Later, how long Console_Poll() listens for a valid character before it opens it
+#define CONSOLE_WAKE_LISTEN_MS 1000
+
+static volatile bool consoleRequested;
+
+static void Console_Help(void);
+
+typedef struct {
+    char key;
+    const char *help;
+    void (*run)(void);
+} ConsoleCommand;
+
+static const ConsoleCommand commands[] = {
+    {'e', "energy ledger", Energy_Dump},
+    {'r', "reset energy ledger", Energy_Reset},
+    {'c', "config", Config_Dump},
+    {'s', "set config value", Config_Set},
+    {'w', "write config to eeprom", Config_Write},
+    {'d', "config defaults", Config_Reset},
+    {'j', "flash work and beep timing", FlashWork_Dump},
+    {'l', "flight log", FlightLog_Dump},
+    {'b', "boot and time to first beep", Boot_Dump},
+    {'p', "power cap and supply under load", PowerCtl_Dump},
+    {'h', "chirp step timing", Chirp_Dump},
+#ifdef RADIO_TRACE
+    {'t', "radio trace", RadioTrace_Dump},
+#endif
+    {'?', "help", Console_Help},
+};
+
+static void Console_Help(void) {
+    for (uint8_t i = 0; i < sizeof(commands) / sizeof(commands[0]); i++) {
+        Console_Printf("%c  %s\r\n", commands[i].key, commands[i].help);
+    }
+}
+
+void Console_Init(void) {
+    // PA3 on EXTI line 3, falling edge (start bit)
+    MODIFY_REG(SYSCFG->EXTICR[0], SYSCFG_EXTICR1_EXTI3, 0);
+    EXTI->FTSR1 |= EXTI_FTSR1_FT3;
+    EXTI->PR1 = EXTI_PR1_PIF3;
+    EXTI->IMR1 |= EXTI_IMR1_IM3;
+    HAL_NVIC_SetPriority(EXTI3_IRQn, 3, 0);
+    HAL_NVIC_EnableIRQ(EXTI3_IRQn);
+}
+
+void Console_Printf(const char *format, ...) {
+    char buf[96];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    if (len > (int) sizeof(buf) - 1) {
+        len = sizeof(buf) - 1;
+    }
+    if (len > 0) {
+        HAL_UART_Transmit(&huart2, (uint8_t *) buf, len, 100);
+    }
+}
+
+// Reads a line with echo, up to Enter. False on timeout.
+bool Console_ReadLine(char *buf, uint16_t size) {
+    uint16_t len = 0;
+    while (1) {
+        uint8_t c;
+        if (HAL_UART_Receive(&huart2, &c, 1, CONSOLE_LINE_TIMEOUT_MS) != HAL_OK) {
+            Console_Printf("\r\n");
+            return false;
+        }
+        if (c == '\r' || c == '\n') {
+            buf[len] = '\0';
+            Console_Printf("\r\n");
+            return true;
+        }
+        if ((c == '\b' || c == 0x7F) && len > 0) {
+            len--;
+            Console_Printf("\b \b");
+        } else if (c >= ' ' && c < 0x7F && len + 1 < size) {
+            buf[len++] = c;
+            Console_Printf("%c", c);
+        }
+    }
+}
+
+// Whether a wake-up of the RX line was someone at the console: any one
+// shortly after power-on, later only if a character follows that the UART
+// received cleanly (Enter or a printable one)
+static bool Console_Wanted(void) {
+    if (!bootInfo.warm && HAL_GetTick() < CONSOLE_OPEN_WINDOW_MS) {
+        return true;
+    }
+    uint8_t c;
+    if (HAL_UART_Receive(&huart2, &c, 1, CONSOLE_WAKE_LISTEN_MS) != HAL_OK) {
+        return false;
+    }
+    if (__HAL_UART_GET_FLAG(&huart2, UART_FLAG_FE) || __HAL_UART_GET_FLAG(&huart2, UART_FLAG_NE)) {
+        return false;
+    }
+    return c == '\r' || c == '\n' || (c >= ' ' && c < 0x7F);
+}
+
+void Console_Poll(void) {
+    if (!consoleRequested) {
+        return;
+    }
+
+    // The character that woke us up was lost while the clocks came back
+    __HAL_UART_CLEAR_FLAG(&huart2, UART_CLEAR_OREF | UART_CLEAR_FEF | UART_CLEAR_NEF);
+    __HAL_UART_SEND_REQ(&huart2, UART_RXDATA_FLUSH_REQUEST);
+    if (!Console_Wanted()) {
+        consoleRequested = false;
+        return;
+    }
+    Console_Printf("\r\nrocketbeacon> ");
+
+    uint8_t key;
+    if (HAL_UART_Receive(&huart2, &key, 1, CONSOLE_KEY_TIMEOUT_MS) == HAL_OK) {
+        Console_Printf("%c\r\n", key);
+        const ConsoleCommand *command = NULL;
+        for (uint8_t i = 0; i < sizeof(commands) / sizeof(commands[0]); i++) {
+            if (commands[i].key == key) {
+                command = &commands[i];
+            }
+        }
+        if (command) {
+            command->run();
+        } else {
+            Console_Help();
+        }
+    } else {
+        Console_Printf("\r\n");
+    }
+
+    // Our own receive traffic also triggered the EXTI line
+    consoleRequested = false;
+}
+
+void Console_IRQHandler(void) {
+    if (EXTI->PR1 & EXTI_PR1_PIF3) {
+        EXTI->PR1 = EXTI_PR1_PIF3;
+        consoleRequested = true;
+    }
+}
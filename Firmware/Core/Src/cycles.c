@@ -0,0 +1,26 @@
+/**
+  ******************************************************************************
+  * @file           : cycles.c
+  * @brief          : Core cycle counter for timing code on the target.
+  ******************************************************************************
+  * The DWT cycle counter runs at HCLK, which is 1 MHz on both the MSI and
+  * the HSE clock but is read from SystemCoreClock in case that changes.
+  */
+
+#include "cycles.h"
+
+// Safe to call from every module that times something, at any time
+void Cycles_Enable(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+// Split so the conversion does not overflow for counts of several seconds
+uint32_t Cycles_ToUs(uint32_t cycles) {
+    uint32_t perMs = SystemCoreClock / 1000;
+    return cycles / perMs * 1000 + cycles % perMs * 1000 / perMs;
+}
+
+uint32_t Cycles_ToMs(uint32_t cycles) {
+    return cycles / (SystemCoreClock / 1000);
+}
@@ -0,0 +1,159 @@
+/**
+  ******************************************************************************
+  * @file           : energy.c
+  * @brief          : Time-in-state ledger and charge estimate.
+  ******************************************************************************
+  * Every radio state change, LED change and Stop2 sleep adds the time spent
+  * in the previous state to a millisecond counter. Energy_Dump() converts the
+  * counters to charge with the current table and prints them on the console,
+  * so different power ladders and schedules can be compared on the real
+  * board without a current meter.
+  */
+
+#include "energy.h"
+#include "console.h"
+#include <string.h>
+
+EnergyLedger energyLedger;
+
+EnergyCurrents energyCurrents = {
+    .cpuRun = 150,  // MSI 1 MHz, range 2
+    .cpuStop = 2,   // Stop2 with LSI and LPTIM1
+    .led = 1000,
+    .radio = {
+        [RADIO_STDBY_XOSC] = 800,
+        [RADIO_STDBY_RC]   = 600,
+        [RADIO_SLEEP]      = 1,
+    },
+};
+
+// Typical TX supply current (uA) of the high power PA at 434 MHz, LDO
+// regulator, with the optimal PA settings of SetOutputPower(). Linearly
+// interpolated in between.
+static const struct {
+    int8_t dBm;
+    uint32_t uA;
+} txCurrentPoints[] = {
+    {-17, 15000},
+    {-9, 18000},
+    {0, 25000},
+    {10, 45000},
+    {14, 75000},
+    {17, 90000},
+    {20, 105000},
+    {22, 120000},
+};
+
+// Radio state being timed and since when
+static bool radioTx;
+static RadioPowerState radioIdle = RADIO_STDBY_XOSC;
+static int8_t radioTxDbm;
+static uint32_t radioSince;
+
+static bool ledOn;
+static uint32_t ledSince;
+
+void Energy_Reset(void) {
+    uint32_t now = HAL_GetTick();
+    memset(&energyLedger, 0, sizeof(energyLedger));
+    energyLedger.startTick = now;
+    radioSince = now;
+    ledSince = now;
+}
+
+void Energy_AddStop(uint32_t ms) {
+    energyLedger.cpuStopMs += ms;
+}
+
+void Energy_Led(bool on) {
+    uint32_t now = HAL_GetTick();
+    if (ledOn) {
+        energyLedger.ledMs += now - ledSince;
+    }
+    ledOn = on;
+    ledSince = now;
+}
+
+static void Energy_CloseRadio(uint32_t now) {
+    if (radioTx) {
+        energyLedger.txMs[radioTxDbm - ENERGY_TX_MIN_DBM] += now - radioSince;
+    } else {
+        energyLedger.radioMs[radioIdle] += now - radioSince;
+    }
+    radioSince = now;
+}
+
+void Energy_Radio(RadioPowerState state) {
+    Energy_CloseRadio(HAL_GetTick());
+    radioTx = false;
+    radioIdle = state;
+}
+
+void Energy_RadioTx(int8_t powerdBm) {
+    Energy_CloseRadio(HAL_GetTick());
+    radioTx = true;
+    radioTxDbm = powerdBm < ENERGY_TX_MIN_DBM ? ENERGY_TX_MIN_DBM
+               : (powerdBm > ENERGY_TX_MAX_DBM ? ENERGY_TX_MAX_DBM : powerdBm);
+}
+
+uint32_t Energy_TxCurrent(int8_t powerdBm) {
+    uint8_t last = sizeof(txCurrentPoints) / sizeof(txCurrentPoints[0]) - 1;
+    if (powerdBm <= txCurrentPoints[0].dBm) {
+        return txCurrentPoints[0].uA;
+    }
+    for (uint8_t i = 1; i <= last; i++) {
+        if (powerdBm <= txCurrentPoints[i].dBm) {
+            int32_t span = txCurrentPoints[i].dBm - txCurrentPoints[i-1].dBm;
+            int32_t step = powerdBm - txCurrentPoints[i-1].dBm;
+            return txCurrentPoints[i-1].uA + ((int32_t)(txCurrentPoints[i].uA - txCurrentPoints[i-1].uA)) * step / span;
+        }
+    }
+    return txCurrentPoints[last].uA;
+}
+
+// ms * uA in nAh
+static uint32_t Energy_Charge(uint32_t ms, uint32_t uA) {
+    return (uint32_t)((uint64_t) ms * uA / 3600);
+}
+
+static uint32_t Energy_PrintRow(const char *name, int8_t dBm, uint32_t ms, uint32_t uA) {
+    uint32_t nAh = Energy_Charge(ms, uA);
+    if (name) {
+        Console_Printf("%-12s", name);
+    } else {
+        Console_Printf("tx %3d dBm  ", dBm);
+    }
+    Console_Printf(" %10lu ms %6lu uA %8lu.%03lu uAh\r\n",
+                   (unsigned long) ms, (unsigned long) uA, (unsigned long)(nAh / 1000), (unsigned long)(nAh % 1000));
+    return nAh;
+}
+
+void Energy_Dump(void) {
+    // Account the time up to now in the current states
+    uint32_t now = HAL_GetTick();
+    Energy_CloseRadio(now);
+    Energy_Led(ledOn);
+
+    uint32_t uptime = now - energyLedger.startTick;
+    uint32_t run = uptime > energyLedger.cpuStopMs ? uptime - energyLedger.cpuStopMs : 0;
+    uint32_t nAh = 0;
+
+    Console_Printf("uptime %lu ms\r\n", (unsigned long) uptime);
+    nAh += Energy_PrintRow("cpu run", 0, run, energyCurrents.cpuRun);
+    nAh += Energy_PrintRow("cpu stop2", 0, energyLedger.cpuStopMs, energyCurrents.cpuStop);
+    nAh += Energy_PrintRow("led", 0, energyLedger.ledMs, energyCurrents.led);
+    nAh += Energy_PrintRow("radio xosc", 0, energyLedger.radioMs[RADIO_STDBY_XOSC], energyCurrents.radio[RADIO_STDBY_XOSC]);
+    nAh += Energy_PrintRow("radio rc", 0, energyLedger.radioMs[RADIO_STDBY_RC], energyCurrents.radio[RADIO_STDBY_RC]);
+    nAh += Energy_PrintRow("radio sleep", 0, energyLedger.radioMs[RADIO_SLEEP], energyCurrents.radio[RADIO_SLEEP]);
+    for (int8_t dBm = ENERGY_TX_MIN_DBM; dBm <= ENERGY_TX_MAX_DBM; dBm++) {
+        uint32_t ms = energyLedger.txMs[dBm - ENERGY_TX_MIN_DBM];
+        if (ms) {
+            nAh += Energy_PrintRow(NULL, dBm, ms, Energy_TxCurrent(dBm));
+        }
+    }
+
+    // nAh * 3600 / ms = uA
+    uint32_t average = uptime ? (uint32_t)((uint64_t) nAh * 3600 / uptime) : 0;
+    Console_Printf("total %lu.%03lu uAh, average %lu uA\r\n",
+                   (unsigned long)(nAh / 1000), (unsigned long)(nAh % 1000), (unsigned long) average);
+}
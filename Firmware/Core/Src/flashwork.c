@@ -0,0 +1,168 @@
+/**
+  ******************************************************************************
+  * @file           : flashwork.c
+  * @brief          : Flash erases deferred to radio idle windows.
+  ******************************************************************************
+  * The core runs from the same flash bank it erases, so it stalls for the
+  * whole erase (about 22 ms per 2K page). Erases are therefore only queued
+  * where they become necessary and run from Radio_Delay(), with the radio
+  * parked, when the idle window is longer than the erase plus a margin.
+  * A beep can then only start late if an erase takes longer than any erase
+  * measured before it; radioTiming shows whether that ever happened.
+  */
+
+#include "flashwork.h"
+#include "console.h"
+#include "cycles.h"
+#include "radio.h"
+#include "flightlog.h"
+
+// Page erase time used until a slower one is measured
+#define FLASHWORK_PAGE_ERASE_MS 25U
+
+// Kept free at the end of a window, for the code around the erase
+#define FLASHWORK_MARGIN_MS 5U
+
+typedef struct {
+    bool (*start)(void); // starts the erase in interrupt mode
+    void (*done)(void);  // after a successful erase, flash still unlocked
+    uint8_t pages;
+} FlashWorkEntry;
+
+static bool FlashWork_StartEECleanUp(void) {
+    return EE_CleanUp_IT() == EE_OK;
+}
+
+static const FlashWorkEntry jobs[FLASHWORK_JOBS] = {
+    [FLASHWORK_EE_CLEANUP] = {FlashWork_StartEECleanUp, NULL, PAGES_NUMBER / 2},
+    [FLASHWORK_LOG_ERASE] = {FlightLog_StartErase, FlightLog_EraseDone, 1},
+};
+
+FlashWorkStats flashWorkStats;
+
+static volatile uint32_t pending;
+static volatile bool busy;
+static volatile bool failed;
+
+void FlashWork_Init(void) {
+    Cycles_Enable();
+    HAL_NVIC_SetPriority(FLASH_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(FLASH_IRQn);
+}
+
+void FlashWork_Unlock(void) {
+    // Flash program and erase need the HSI16 running
+    __HAL_RCC_HSI_ENABLE();
+    while (!__HAL_RCC_GET_FLAG(RCC_FLAG_HSIRDY)) {
+    }
+    HAL_FLASH_Unlock();
+}
+
+void FlashWork_Lock(void) {
+    HAL_FLASH_Lock();
+    __HAL_RCC_HSI_DISABLE();
+}
+
+void FlashWork_Request(FlashWorkJob job) {
+    pending |= 1U << job;
+}
+
+bool FlashWork_Pending(FlashWorkJob job) {
+    return (pending & (1U << job)) != 0;
+}
+
+static uint32_t FlashWork_BudgetMs(FlashWorkJob job) {
+    uint32_t pageMs = flashWorkStats.maxPageMs > FLASHWORK_PAGE_ERASE_MS ? flashWorkStats.maxPageMs : FLASHWORK_PAGE_ERASE_MS;
+    return jobs[job].pages * pageMs + FLASHWORK_MARGIN_MS;
+}
+
+static void FlashWork_Run(FlashWorkJob job) {
+    pending &= ~(1U << job);
+
+    uint32_t startTick = HAL_GetTick();
+    uint32_t startCycles = DWT->CYCCNT;
+    FlashWork_Unlock();
+    busy = true;
+    failed = false;
+    if (jobs[job].start()) {
+        // No WFI: the cycle counter keeps running while the core is
+        // stalled on flash, but not while it sleeps
+        while (busy) {
+        }
+        FI_CacheFlush();
+        if (jobs[job].done != NULL && !failed) {
+            jobs[job].done();
+        }
+    } else {
+        busy = false;
+        failed = true;
+        flashWorkStats.errors++;
+    }
+    FlashWork_Lock();
+
+    // The pages are still to be erased, and the owner of a job may be
+    // waiting for it without asking again (a full flight log page). The
+    // HAL clears the error flags, so the next window starts afresh.
+    if (failed) {
+        FlashWork_Request(job);
+    }
+
+    // SysTick could not be serviced during the stall, catch the tick up
+    uint32_t ms = Cycles_ToMs(DWT->CYCCNT - startCycles);
+    int32_t missed = (int32_t) (ms - (HAL_GetTick() - startTick));
+    if (missed > 0) {
+        uwTick += missed;
+    }
+
+    flashWorkStats.runs++;
+    flashWorkStats.lastMs = ms;
+    if (ms / jobs[job].pages > flashWorkStats.maxPageMs) {
+        flashWorkStats.maxPageMs = (ms + jobs[job].pages - 1) / jobs[job].pages;
+    }
+}
+
+// Runs the pending work that is sure to finish before tick
+void FlashWork_RunUntil(uint32_t tick) {
+    for (FlashWorkJob job = 0; job < FLASHWORK_JOBS; job++) {
+        if (!FlashWork_Pending(job)) {
+            continue;
+        }
+        if ((int32_t) (tick - HAL_GetTick()) < (int32_t) FlashWork_BudgetMs(job)) {
+            flashWorkStats.deferred++;
+            continue;
+        }
+        FlashWork_Run(job);
+    }
+}
+
+// Runs all pending work now, for callers that are not on the beacon schedule
+void FlashWork_Flush(void) {
+    for (FlashWorkJob job = 0; job < FLASHWORK_JOBS; job++) {
+        if (FlashWork_Pending(job)) {
+            FlashWork_Run(job);
+        }
+    }
+}
+
+void FlashWork_Dump(void) {
+    Console_Printf("flash work: %lu runs, last %lu ms, page max %lu ms, %lu deferred, %lu errors, pending %lx\r\n",
+                   (unsigned long) flashWorkStats.runs, (unsigned long) flashWorkStats.lastMs,
+                   (unsigned long) flashWorkStats.maxPageMs, (unsigned long) flashWorkStats.deferred,
+                   (unsigned long) flashWorkStats.errors, (unsigned long) pending);
+    Console_Printf("beep timing: %lu waits, %lu ended late, worst %lu ms late\r\n",
+                   (unsigned long) radioTiming.count, (unsigned long) radioTiming.lateCount,
+                   (unsigned long) radioTiming.maxLateMs);
+}
+
+void HAL_FLASH_EndOfOperationCallback(uint32_t ReturnValue) {
+    // Called after every page, the erase is done once no procedure is left
+    if (pFlash.ProcedureOnGoing == FLASH_TYPENONE) {
+        busy = false;
+    }
+}
+
+void HAL_FLASH_OperationErrorCallback(uint32_t ReturnValue) {
+    flashWorkStats.errors++;
+    failed = true;
+    busy = false;
+}
@@ -0,0 +1,263 @@
+/**
+  ******************************************************************************
+  * @file           : flightlog.c
+  * @brief          : Ring log of beacon and power events in flash.
+  ******************************************************************************
+  * The log lives in its own flash region (FLIGHTLOG in the linker script),
+  * a ring of 2K pages. Every record is one 64-bit doubleword, the unit the
+  * flash programs at once:
+  *
+  *   bits  0..7   type (FlightLogType)
+  *   bits  8..15  CRC-8 of the record with these bits zero
+  *   bits 16..39  seconds since boot
+  *   bits 40..63  value
+  *
+  * The first record of every page is a FLIGHTLOG_PAGE record with an
+  * increasing sequence number, which orders the pages; the page with the
+  * highest one is written until it is full, then the oldest page is erased
+  * in a radio idle window (FlashWork) and takes its place.
+  *
+  * Records are collected in RAM and programmed together once per
+  * checkpoint, one per beacon loop. A power loss can only cost the records
+  * still in RAM and the doubleword being programmed: an erased doubleword
+  * is all ones and a torn one fails the CRC (or the ECC, see NMI_Handler()),
+  * so the first erased doubleword of the newest page is always where the
+  * next record goes. A page without a valid first record is erased again.
+  */
+
+#include "flightlog.h"
+#include "flashwork.h"
+#include "console.h"
+#include "radio.h"
+#include "supply.h"
+#include "flash_interface.h"
+#include "boot.h"
+#include <string.h>
+
+// Linker script FLIGHTLOG region
+extern uint8_t _flightlog_start[];
+extern uint8_t _flightlog_end[];
+
+#define FLIGHTLOG_PAGE_RECORDS (FLASH_PAGE_SIZE / sizeof(uint64_t))
+#define FLIGHTLOG_ERASED UINT64_MAX
+#define FLIGHTLOG_FIELD_MASK 0xFFFFFFU
+
+// Records waiting for the next commit. A checkpoint adds up to three.
+#define FLIGHTLOG_BUFFER_SIZE 16
+
+FlightLogStats flightLogStats;
+
+static uint64_t buffer[FLIGHTLOG_BUFFER_SIZE];
+static uint8_t buffered;
+static uint32_t droppedSinceCommit;
+
+static uint32_t pageCount;     // 0 if the region is unusable, the log stays in RAM
+static int32_t current = -1;   // page being written, -1 until one is ready
+static uint32_t head;          // next free record in that page
+static uint32_t pageSequence;
+static uint32_t bootNumber;
+static uint32_t lastLateMs;
+static bool firstBeepLogged;
+
+static const uint64_t *FlightLog_Page(uint32_t page) {
+    return (const uint64_t *) (_flightlog_start + page * FLASH_PAGE_SIZE);
+}
+
+static uint8_t FlightLog_Crc(uint64_t record) {
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        crc ^= (uint8_t) (record >> (8 * i));
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t) ((crc << 1) ^ 0x07) : (uint8_t) (crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint64_t FlightLog_Pack(FlightLogType type, uint32_t seconds, uint32_t value) {
+    uint64_t record = (uint64_t) type | (uint64_t) (seconds & FLIGHTLOG_FIELD_MASK) << 16 |
+                      (uint64_t) (value & FLIGHTLOG_FIELD_MASK) << 40;
+    return record | (uint64_t) FlightLog_Crc(record) << 8;
+}
+
+static uint8_t FlightLog_Type(uint64_t record) {
+    return (uint8_t) record;
+}
+
+static uint32_t FlightLog_Value(uint64_t record) {
+    return (uint32_t) (record >> 40);
+}
+
+// All zeros (a deleted doubleword) and all ones (erased) are never valid
+static bool FlightLog_Valid(uint64_t record) {
+    uint8_t type = FlightLog_Type(record);
+    if (type == 0x00 || type == 0xFF) {
+        return false;
+    }
+    return (uint8_t) (record >> 8) == FlightLog_Crc(record & ~(0xFFULL << 8));
+}
+
+// The last boot number, searched backwards from the head through the pages
+// in sequence order
+static uint32_t FlightLog_FindBootNumber(void) {
+    for (uint32_t n = 0; n < pageCount; n++) {
+        uint32_t page = (current + pageCount - n) % pageCount;
+        const uint64_t *records = FlightLog_Page(page);
+        if (!FlightLog_Valid(records[0]) || FlightLog_Value(records[0]) != ((pageSequence - n) & FLIGHTLOG_FIELD_MASK)) {
+            break;
+        }
+        for (uint32_t i = n == 0 ? head : FLIGHTLOG_PAGE_RECORDS; i-- > 1;) {
+            if (FlightLog_Valid(records[i]) && FlightLog_Type(records[i]) == FLIGHTLOG_BOOT) {
+                return FlightLog_Value(records[i]);
+            }
+        }
+    }
+    return 0;
+}
+
+void FlightLog_Init(void) {
+    uint32_t start = (uint32_t) _flightlog_start;
+    uint32_t size = _flightlog_end - _flightlog_start;
+    if (start % FLASH_PAGE_SIZE == 0 && size % FLASH_PAGE_SIZE == 0 && size / FLASH_PAGE_SIZE >= 2) {
+        pageCount = size / FLASH_PAGE_SIZE;
+    }
+
+    // Unlocked, so that NMI_Handler() can delete a doubleword torn by a power
+    // loss instead of faulting on it again on every boot
+    FlashWork_Unlock();
+    for (uint32_t page = 0; page < pageCount; page++) {
+        uint64_t first = FlightLog_Page(page)[0];
+        if (!FlightLog_Valid(first) || FlightLog_Type(first) != FLIGHTLOG_PAGE) {
+            continue;
+        }
+        uint32_t sequence = FlightLog_Value(first);
+        if (current < 0 || (int32_t) ((sequence - pageSequence) << 8) > 0) {
+            current = page;
+            pageSequence = sequence;
+        }
+    }
+    if (current >= 0) {
+        const uint64_t *records = FlightLog_Page(current);
+        for (head = 1; head < FLIGHTLOG_PAGE_RECORDS && records[head] != FLIGHTLOG_ERASED; head++) {
+        }
+        bootNumber = FlightLog_FindBootNumber();
+    }
+    FlashWork_Lock();
+
+    if (pageCount > 0 && (current < 0 || head == FLIGHTLOG_PAGE_RECORDS)) {
+        FlashWork_Request(FLASHWORK_LOG_ERASE);
+    }
+
+    bootNumber++;
+    FlightLog_Add(FLIGHTLOG_BOOT, bootNumber);
+    FlightLog_Add(FLIGHTLOG_RESET, bootInfo.resetFlags);
+}
+
+void FlightLog_Add(FlightLogType type, uint32_t value) {
+    if (buffered == FLIGHTLOG_BUFFER_SIZE) {
+        droppedSinceCommit++;
+        flightLogStats.dropped++;
+        return;
+    }
+    buffer[buffered++] = FlightLog_Pack(type, HAL_GetTick() / 1000, value);
+}
+
+// Once per beacon loop, from the main loop right before a radio idle gap
+void FlightLog_Checkpoint(uint32_t cycles) {
+    FlightLog_Add(FLIGHTLOG_CYCLES, cycles);
+    FlightLog_Add(FLIGHTLOG_SUPPLY, Supply_MeasureMv());
+    if (!firstBeepLogged && Boot_FirstBeepMs() != 0) {
+        firstBeepLogged = true;
+        FlightLog_Add(FLIGHTLOG_FIRST_BEEP, Boot_FirstBeepMs());
+    }
+    if (radioTiming.maxLateMs != lastLateMs) {
+        lastLateMs = radioTiming.maxLateMs;
+        FlightLog_Add(FLIGHTLOG_LATE, lastLateMs);
+    }
+    FlightLog_Commit();
+}
+
+// Programs the buffered records, about 0.1 ms each
+void FlightLog_Commit(void) {
+    if (current < 0 || head == FLIGHTLOG_PAGE_RECORDS) {
+        return;
+    }
+
+    uint8_t done = 0;
+    FlashWork_Unlock();
+    while (done < buffered && head < FLIGHTLOG_PAGE_RECORDS) {
+        uint32_t address = (uint32_t) &FlightLog_Page(current)[head++];
+        if (FI_WriteDoubleWord(address, buffer[done]) == HAL_OK) {
+            done++;
+            flightLogStats.written++;
+        } else {
+            // Maybe half programmed, leave it and use the next one
+            flightLogStats.errors++;
+        }
+    }
+    FlashWork_Lock();
+    FI_CacheFlush();
+
+    buffered -= done;
+    memmove(buffer, buffer + done, buffered * sizeof(buffer[0]));
+    if (droppedSinceCommit > 0 && buffered < FLIGHTLOG_BUFFER_SIZE) {
+        buffer[buffered++] = FlightLog_Pack(FLIGHTLOG_DROPPED, HAL_GetTick() / 1000, droppedSinceCommit);
+        droppedSinceCommit = 0;
+    }
+
+    if (head == FLIGHTLOG_PAGE_RECORDS) {
+        FlashWork_Request(FLASHWORK_LOG_ERASE);
+    }
+}
+
+static uint32_t FlightLog_NextPage(void) {
+    return current < 0 ? 0 : (current + 1) % pageCount;
+}
+
+// FlashWork job: erase the page after the current one, the oldest
+bool FlightLog_StartErase(void) {
+    uint32_t address = (uint32_t) FlightLog_Page(FlightLog_NextPage());
+    return FI_PageErase_IT((address - FLASH_BASE) / FLASH_PAGE_SIZE, 1) == EE_OK;
+}
+
+// Called with the flash still unlocked
+void FlightLog_EraseDone(void) {
+    uint32_t page = FlightLog_NextPage();
+    uint32_t sequence = current < 0 ? 0 : pageSequence + 1;
+    if (FI_WriteDoubleWord((uint32_t) FlightLog_Page(page), FlightLog_Pack(FLIGHTLOG_PAGE, 0, sequence)) != HAL_OK) {
+        // Not a valid page, it is erased again on the next request
+        flightLogStats.errors++;
+        FlashWork_Request(FLASHWORK_LOG_ERASE);
+        return;
+    }
+    current = page;
+    pageSequence = sequence;
+    head = 1;
+}
+
+static void FlightLog_Print(uint64_t record) {
+    Console_Printf("L %08lx%08lx\r\n", (unsigned long) (record >> 32), (unsigned long) record);
+}
+
+// Raw records, oldest first, for Tools/flightlog_decode.py
+void FlightLog_Dump(void) {
+    FlightLog_Commit();
+    Console_Printf("flight log: boot %lu, %lu pages, page %ld record %lu, %lu written, %lu dropped, %lu errors\r\n",
+                   (unsigned long) bootNumber, (unsigned long) pageCount, (long) current, (unsigned long) head,
+                   (unsigned long) flightLogStats.written, (unsigned long) flightLogStats.dropped,
+                   (unsigned long) flightLogStats.errors);
+    for (uint32_t n = 1; n <= pageCount; n++) {
+        const uint64_t *records = FlightLog_Page((current + n) % pageCount);
+        if (!FlightLog_Valid(records[0]) || FlightLog_Type(records[0]) != FLIGHTLOG_PAGE) {
+            continue;
+        }
+        for (uint32_t i = 0; i < FLIGHTLOG_PAGE_RECORDS && records[i] != FLIGHTLOG_ERASED; i++) {
+            FlightLog_Print(records[i]);
+        }
+    }
+    // Not in flash yet
+    for (uint8_t i = 0; i < buffered; i++) {
+        FlightLog_Print(buffer[i]);
+    }
+    Console_Printf("flight log end\r\n");
+}
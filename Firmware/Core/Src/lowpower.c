@@ -0,0 +1,240 @@
+/**
+  ******************************************************************************
+  * @file           : lowpower.c
+  * @brief          : Tickless Stop2 delays timed by LPTIM1.
+  ******************************************************************************
+  * LPTIM1 is clocked from the LSI (32 kHz) through a /32 prescaler, so one
+  * count is about one millisecond. A delay arms a one-shot autoreload match,
+  * stops SysTick and enters Stop2; on wake-up the slept time is added to the
+  * HAL tick so HAL_GetTick() keeps counting as if the core had been running.
+  *
+  * The LSI is only good to a few percent and drifts with temperature, so
+  * LowPower_CalibrateLsi() measures it against the HSE32 with TIM16, whose
+  * input 1 can be the LSI (TIM16_OR1 TI1_RMP). The counts of a delay are
+  * scaled to the measured frequency, and what a delay rounds off is carried
+  * into the next one, so back-to-back delays keep to the crystal.
+  *
+  * Peripherals that stop in Stop2 (TIM16 for the chirps) keep the core in
+  * Sleep mode with LowPower_RequestRun() / LowPower_ReleaseRun() while
+  * they run; waits then only gate the core clock with WFI.
+  */
+
+#include "lowpower.h"
+#include "clock.h"
+#include "energy.h"
+#include "radiotrace.h"
+
+// Largest single sleep, that the 16 bit LPTIM1 counter can time up to an
+// LSI of 34.9 kHz
+#define LOWPOWER_MAX_SLEEP_MS 60000U
+
+// LPTIM1 counts per ms are lsiHz / LOWPOWER_LSI_HZ
+#define LOWPOWER_LSI_HZ 32000U
+
+// A calibration times LOWPOWER_LSI_CAPTURES captures of 8 LSI periods each,
+// 16 ms for 64, in TIM16 counts of 1 us on the crystal
+#define LOWPOWER_LSI_CAPTURES 64U
+#define LOWPOWER_LSI_MIN_HZ 26000U
+#define LOWPOWER_LSI_MAX_HZ 38000U
+#define LOWPOWER_LSI_TIMEOUT_MS 25U
+
+// The core wakes from Stop2 on MSI in a few microseconds, but every sleep
+// waits for the ARR write to cross into the 32 kHz LSI domain (about 100 us)
+// and the slept time is only known to the millisecond. Below this those are
+// a large part of the wait, so short waits only gate the core clock with WFI
+// between SysTicks.
+#define LOWPOWER_MIN_STOP_MS 3U
+
+static volatile bool lptimExpired;
+static uint8_t runRequests;
+static uint32_t lsiHz = LOWPOWER_LSI_HZ;
+// What the counts of the last delays were short of their ms, in 1 / LOWPOWER_LSI_HZ counts
+static int32_t lptimResidue;
+
+static uint32_t LowPower_ReadCounter(void) {
+    // LPTIM1 is asynchronous to the bus, two equal reads are needed
+    uint32_t cnt;
+    do {
+        cnt = LPTIM1->CNT;
+    } while (cnt != LPTIM1->CNT);
+    return cnt;
+}
+
+void LowPower_Init(void) {
+    __HAL_RCC_LSI_ENABLE();
+    while (!__HAL_RCC_GET_FLAG(RCC_FLAG_LSIRDY)) {
+    }
+
+    __HAL_RCC_LPTIM1_CONFIG(RCC_LPTIM1CLKSOURCE_LSI);
+    __HAL_RCC_LPTIM1_CLK_ENABLE();
+
+    // Prescaler /32, must be written while the timer is disabled
+    LPTIM1->CR = 0;
+    LPTIM1->CFGR = LPTIM_CFGR_PRESC_2 | LPTIM_CFGR_PRESC_0;
+    LPTIM1->IER = LPTIM_IER_ARRMIE;
+
+    // LPTIM1 wake-up is EXTI direct line 29
+    EXTI->IMR1 |= EXTI_IMR1_IM29;
+    HAL_NVIC_SetPriority(LPTIM1_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(LPTIM1_IRQn);
+
+    __HAL_RCC_WAKEUPSTOP_CLK_CONFIG(RCC_STOP_WAKEUPCLOCK_MSI);
+}
+
+// Measures the LSI against the HSE32, TIM16 must not be in use (no chirp).
+// Returns false and keeps the last value if the LSI edges do not come or
+// are out of range.
+bool LowPower_CalibrateLsi(void) {
+    Clock_RequestHSE();
+    __HAL_RCC_TIM16_CLK_ENABLE();
+
+    // TIM16 counts microseconds, PCLK2 is 1 MHz from the crystal now.
+    // Input capture of every 8th LSI edge, no interrupts.
+    uint32_t dier = TIM16->DIER;
+    TIM16->DIER = 0;
+    TIM16->CR1 = 0;
+    TIM16->PSC = 0;
+    TIM16->ARR = 0xFFFF;
+    TIM16->OR1 = TIM16_OR1_TI1_RMP_0;
+    TIM16->CCMR1 = TIM_CCMR1_CC1S_0 | TIM_CCMR1_IC1PSC;
+    TIM16->CCER = TIM_CCER_CC1E;
+    TIM16->CNT = 0;
+    TIM16->SR = 0;
+    TIM16->CR1 = TIM_CR1_CEN;
+
+    uint16_t first = 0;
+    uint16_t last = 0;
+    uint32_t captures = 0;
+    uint32_t start = HAL_GetTick();
+    while (captures <= LOWPOWER_LSI_CAPTURES && HAL_GetTick() - start < LOWPOWER_LSI_TIMEOUT_MS) {
+        uint32_t sr = TIM16->SR;
+        if (sr & TIM_SR_CC1OF) {
+            // A capture was missed, the count of edges is off
+            break;
+        }
+        if (sr & TIM_SR_CC1IF) {
+            last = (uint16_t) TIM16->CCR1;
+            TIM16->SR = 0;
+            if (captures++ == 0) {
+                first = last;
+            }
+        }
+    }
+
+    // Back to what Chirp_Init() left
+    TIM16->CR1 = TIM_CR1_URS;
+    TIM16->CCER = 0;
+    TIM16->CCMR1 = 0;
+    TIM16->OR1 = 0;
+    TIM16->SR = 0;
+    TIM16->DIER = dier;
+    Clock_ReleaseHSE();
+
+    if (captures <= LOWPOWER_LSI_CAPTURES) {
+        return false;
+    }
+    uint16_t us = last - first;
+    uint32_t hz = (uint32_t) ((LOWPOWER_LSI_CAPTURES * 8ULL * 1000000U + us / 2) / us);
+    if (hz < LOWPOWER_LSI_MIN_HZ || hz > LOWPOWER_LSI_MAX_HZ) {
+        return false;
+    }
+    lsiHz = hz;
+    return true;
+}
+
+uint32_t LowPower_LsiHz(void) {
+    return lsiHz;
+}
+
+// Sleeps for up to ms milliseconds and returns the time actually slept.
+// Any enabled interrupt ends the sleep early.
+uint32_t LowPower_Sleep(uint32_t ms) {
+    if (ms == 0) {
+        return 0;
+    }
+
+    if (runRequests > 0) {
+        uint32_t start = HAL_GetTick();
+        __WFI();
+        return HAL_GetTick() - start;
+    }
+
+    if (ms < LOWPOWER_MIN_STOP_MS) {
+        uint32_t start = HAL_GetTick();
+        while (HAL_GetTick() - start < ms) {
+            __WFI();
+        }
+        return HAL_GetTick() - start;
+    }
+
+    if (ms > LOWPOWER_MAX_SLEEP_MS) {
+        ms = LOWPOWER_MAX_SLEEP_MS;
+    }
+
+    // Rounded to the nearest count, the rest is carried into the next sleep
+    int64_t exact = (int64_t) ms * lsiHz + lptimResidue;
+    uint32_t counts = (uint32_t) ((exact + LOWPOWER_LSI_HZ / 2) / LOWPOWER_LSI_HZ);
+    if (counts == 0) {
+        counts = 1;
+    }
+
+    lptimExpired = false;
+    LPTIM1->CR = LPTIM_CR_ENABLE;
+    LPTIM1->ICR = LPTIM_ICR_ARRMCF | LPTIM_ICR_ARROKCF;
+    LPTIM1->ARR = counts - 1;
+    while (!(LPTIM1->ISR & LPTIM_ISR_ARROK)) {
+    }
+    LPTIM1->ICR = LPTIM_ICR_ARROKCF;
+    LPTIM1->CR = LPTIM_CR_ENABLE | LPTIM_CR_SNGSTRT;
+
+    HAL_SuspendTick();
+    HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFI);
+
+    Clock_RestoreAfterStop();
+
+    uint32_t slept;
+    if (lptimExpired) {
+        slept = ms;
+        lptimResidue = (int32_t) (exact - (int64_t) counts * LOWPOWER_LSI_HZ);
+    } else {
+        // Woken early by another interrupt, the wait is started again anyway
+        slept = (uint32_t) ((uint64_t) LowPower_ReadCounter() * LOWPOWER_LSI_HZ / lsiHz);
+        lptimResidue = 0;
+    }
+    LPTIM1->CR = 0;
+
+    uwTick += slept;
+    Energy_AddStop(slept);
+    HAL_ResumeTick();
+    return slept;
+}
+
+void LowPower_RequestRun(void) {
+    runRequests++;
+}
+
+void LowPower_ReleaseRun(void) {
+    if (runRequests > 0) {
+        runRequests--;
+    }
+}
+
+void LowPower_SleepUntil(uint32_t tick) {
+    int32_t remaining;
+    while ((remaining = (int32_t)(tick - HAL_GetTick())) > 0) {
+        LowPower_Sleep((uint32_t) remaining);
+    }
+}
+
+// Drop-in replacement for HAL_Delay() that sleeps in Stop2 in between.
+void LowPower_Delay(uint32_t ms) {
+    RADIO_TRACE_EVENT(RTRACE_DELAY, 0, ms);
+    LowPower_SleepUntil(HAL_GetTick() + ms);
+}
+
+void LowPower_IRQHandler(void) {
+    if (LPTIM1->ISR & LPTIM_ISR_ARRM) {
+        LPTIM1->ICR = LPTIM_ICR_ARRMCF;
+        lptimExpired = true;
+    }
+}
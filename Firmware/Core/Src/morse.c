@@ -0,0 +1,286 @@
+/**
+  ******************************************************************************
+  * @file           : morse.c
+  * @brief          : Callsign compiled into a key-down / key-up timing stream.
+  ******************************************************************************
+  * Morse_Compile() turns the text into runs of key-down and key-up time in
+  * PARIS units once, when the settings are applied (Beacon_Apply()), so
+  * sending it only walks the runs:
+  *
+  *   dit 1, dah 3, gap inside a character 1 dit unit
+  *   gap between characters 3, between words 7 spacing units
+  *
+  * The spacing unit is the dit unit, or longer for Farnsworth timing, where
+  * the characters keep their speed and only the spacing is stretched until
+  * "PARIS " (31 dit units, 19 spacing units) takes 60 / farnsworthWpm s.
+  *
+  * Morse_Play() configures the radio once for the whole text. Every key-down
+  * is then a single SetTx that the radio ends itself with its TX timeout
+  * IRQ, and every key-up a sleep until the next run starts. The runs are
+  * timed against absolute ticks from the start, so command and wake-up
+  * overhead never adds up.
+  *
+  * Morse_PlayPacket() sends the same stream as FSK packets from the radio
+  * buffer instead (radiopacket.c): the radio crystal times every bit and
+  * the MCU sleeps through whole packets, but the carrier also stays on in
+  * the gaps inside a packet.
+  */
+
+#include "morse.h"
+#include "radio.h"
+#include "lowpower.h"
+#include "energy.h"
+#include "radiotrace.h"
+#include "radiopacket.h"
+
+// FSK tone of the callsign, for FM receivers
+#define MORSE_TONE_HZ 400
+
+#define MORSE_NO_CODE 0b11111111
+
+// letter to morse based on ASCII characters.
+// right-terminated by a "1". 1 is dah, 0 is dit.
+const uint8_t morse_chars[] = {
+    0b11111111,       // Special code for SPACE
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b10000110,       // - Hyphen sign
+    0b10000000,       // N/A
+    0b10010100,       // "/" Slash
+    0b11111100,       // "0"
+    0b01111100,       // "1"
+    0b00111100,       // "2"
+    0b00011100,       // "3"
+    0b00001100,       // "4"
+    0b00000100,       // "5"
+    0b10000100,       // "6"
+    0b11000100,       // "7"
+    0b11100100,       // "8"
+    0b11110100,       // "9"
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b10001100,       // "=" BT prosign/Equal sign
+    0b10000000,       // N/A
+    0b00110010,       // "?" Question mark
+    0b10000000,       // N/A
+    0b01100000,       // "A"
+    0b10001000,       // "B"
+    0b10101000,       // "C"
+    0b10010000,       // "D"
+    0b01000000,       // "E"
+    0b00101000,       // "F"
+    0b11010000,       // "G"
+    0b00001000,       // "H"
+    0b00100000,       // "I"
+    0b01111000,       // "J"
+    0b10110000,       // "K"
+    0b01001000,       // "L"
+    0b11100000,       // "M"
+    0b10100000,       // "N"
+    0b11110000,       // "O"
+    0b01101000,       // "P"
+    0b11011000,       // "Q"
+    0b01010000,       // "R"
+    0b00010000,       // "S"
+    0b11000000,       // "T"
+    0b00110000,       // "U"
+    0b00011000,       // "V"
+    0b01110000,       // "W"
+    0b10011000,       // "X"
+    0b10111000,       // "Y"
+    0b11001000,       // "Z"
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b10000000,       // N/A
+    0b01100000,       // "a"
+    0b10001000,       // "b"
+    0b10101000,       // "c"
+    0b10010000,       // "d"
+    0b01000000,       // "e"
+    0b00101000,       // "f"
+    0b11010000,       // "g"
+    0b00001000,       // "h"
+    0b00100000,       // "i"
+    0b01111000,       // "j"
+    0b10110000,       // "k"
+    0b01001000,       // "l"
+    0b11100000,       // "m"
+    0b10100000,       // "n"
+    0b11110000,       // "o"
+    0b01101000,       // "p"
+    0b11011000,       // "q"
+    0b01010000,       // "r"
+    0b00010000,       // "s"
+    0b11000000,       // "t"
+    0b00110000,       // "u"
+    0b00011000,       // "v"
+    0b01110000,       // "w"
+    0b10011000,       // "x"
+    0b10111000,       // "y"
+    0b11001000        // "z"
+};
+
+// Characters at wpm, spaced out to an overall farnsworthWpm (at most wpm)
+MorseTiming Morse_Timing(uint32_t wpm, uint32_t farnsworthWpm) {
+    MorseTiming timing;
+    timing.ditMs = 1200 / wpm;
+    timing.spaceMs = timing.ditMs;
+    if (farnsworthWpm < wpm && (60000 / farnsworthWpm - 31 * timing.ditMs) / 19 > timing.ditMs) {
+        timing.spaceMs = (60000 / farnsworthWpm - 31 * timing.ditMs) / 19;
+    }
+    return timing;
+}
+
+// Appends a run, or lengthens the last one if it is spacing as well
+static bool Morse_Append(uint8_t *stream, uint16_t size, uint16_t *n, uint8_t kind, uint8_t units) {
+    if (kind == MORSE_SPACE && *n > 0 && (stream[*n - 1] & MORSE_KIND_MASK) == MORSE_SPACE &&
+        (stream[*n - 1] & MORSE_UNITS_MASK) + units <= MORSE_UNITS_MASK) {
+        stream[*n - 1] += units;
+        return true;
+    }
+    // Always keep room for MORSE_END
+    if (*n + 1 >= size) {
+        return false;
+    }
+    stream[(*n)++] = kind | units;
+    stream[*n] = MORSE_END;
+    return true;
+}
+
+// False if the stream is too small, it then holds the text up to there
+bool Morse_Compile(const char *text, uint8_t *stream, uint16_t size) {
+    uint16_t n = 0;
+    bool ok = size > 0;
+    if (ok) {
+        stream[0] = MORSE_END;
+    }
+
+    for (; ok && *text; text++) {
+        uint8_t code = MORSE_NO_CODE;
+        if (*text > 31 && *text < 123) {
+            code = morse_chars[*text - 32];
+        }
+
+        // A word gap is 7 units, 3 of them follow the previous character
+        if (code == MORSE_NO_CODE) {
+            ok = Morse_Append(stream, size, &n, MORSE_SPACE, 4);
+            continue;
+        }
+
+        // Elements from bit 7 down to the terminating 1
+        uint8_t terminate = 0;
+        while (terminate < 7 && !(code & (1 << terminate))) {
+            terminate++;
+        }
+        if (terminate == 7) {
+            // N/A, nothing to send
+            continue;
+        }
+        for (uint8_t i = 7; ok && i > terminate; i--) {
+            if (i != 7) {
+                ok = Morse_Append(stream, size, &n, MORSE_KEY_UP, 1);
+            }
+            ok = ok && Morse_Append(stream, size, &n, MORSE_KEY_DOWN, (code & (1 << i)) ? 3 : 1);
+        }
+        ok = ok && Morse_Append(stream, size, &n, MORSE_SPACE, 3);
+    }
+
+    // The gap after the callsign follows anyway
+    if (n > 0 && (stream[n - 1] & MORSE_KIND_MASK) == MORSE_SPACE) {
+        stream[--n] = MORSE_END;
+    }
+    return ok;
+}
+
+static uint32_t Morse_RunMs(uint8_t run, const MorseTiming *timing) {
+    uint32_t unit = (run & MORSE_KIND_MASK) == MORSE_SPACE ? timing->spaceMs : timing->ditMs;
+    return (run & MORSE_UNITS_MASK) * unit;
+}
+
+uint32_t Morse_DurationMs(const uint8_t *stream, const MorseTiming *timing) {
+    uint32_t ms = 0;
+    for (const uint8_t *p = stream; *p != MORSE_END; p++) {
+        ms += Morse_RunMs(*p, timing);
+    }
+    return ms;
+}
+
+static void Morse_Led(bool on) {
+    HAL_GPIO_WritePin(LED_GPIO_Port, LED_Pin, on ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    Energy_Led(on);
+    RADIO_TRACE_EVENT(RTRACE_LED, 0, on);
+}
+
+// Sends a compiled stream, the radio must be in STDBY_XOSC on the frequency
+void Morse_Play(const uint8_t *stream, const MorseTiming *timing, int8_t powerdBm, bool useCw) {
+    SetOutputPower(powerdBm);
+    if (useCw) {
+        SetModulationParamsFSK(2000, 0x00, 0x1E, 0);
+    } else {
+        SetModulationParamsFSK(MORSE_TONE_HZ * 2, 0x09, 0x1E, 2500);
+    }
+
+    uint32_t next = HAL_GetTick();
+    for (const uint8_t *p = stream; *p != MORSE_END; p++) {
+        uint32_t ms = Morse_RunMs(*p, timing);
+        next += ms;
+        if ((*p & MORSE_KIND_MASK) == MORSE_KEY_DOWN) {
+            Morse_Led(true);
+            TimedTx(ms);
+            Morse_Led(false);
+        } else if ((*p & MORSE_KIND_MASK) == MORSE_SPACE) {
+            // Long enough to park the radio
+            int32_t remaining = (int32_t) (next - HAL_GetTick());
+            if (remaining > 0) {
+                Radio_Delay((uint32_t) remaining);
+            }
+        } else {
+            // Too short to park the radio, it stays in STDBY_XOSC
+            LowPower_SleepUntil(next);
+        }
+    }
+}
+
+typedef struct {
+    const uint8_t *p;
+    const MorseTiming *timing;
+    uint32_t ms;   // start of the next run
+    uint32_t bits; // same in bits
+} MorsePacketReader;
+
+// RadioPacketSource, bits counted from the start so rounding never adds up
+static bool Morse_NextRun(void *context, RadioPacketRun *run) {
+    MorsePacketReader *r = context;
+    if (*r->p == MORSE_END) {
+        return false;
+    }
+    r->ms += Morse_RunMs(*r->p, r->timing);
+    uint32_t end = r->ms * (2 * MORSE_TONE_HZ) / 1000;
+    run->bits = end - r->bits;
+    run->halfPeriod = (*r->p & MORSE_KIND_MASK) == MORSE_KEY_DOWN ? 1 : 0;
+    r->bits = end;
+    r->p++;
+    return true;
+}
+
+// Sends a compiled stream as tone (FM) morse through the packet engine, one
+// bit per half period of the tone. The radio must be in STDBY_XOSC on the
+// frequency.
+void Morse_PlayPacket(const uint8_t *stream, const MorseTiming *timing, int8_t powerdBm) {
+    MorsePacketReader reader = {stream, timing};
+    RadioPacket_Send(2 * MORSE_TONE_HZ, powerdBm, Morse_NextRun, &reader);
+}
@@ -0,0 +1,112 @@
+/**
+  ******************************************************************************
+  * @file           : powerctl.c
+  * @brief          : Power ladder cap following the supply under TX load.
+  ******************************************************************************
+  * A coin cell's internal resistance rises as it gets cold or empty, and
+  * the strongest beep then pulls the supply down into a brownout reset.
+  * TimedTx() measures the supply three quarters into every beep at the top
+  * of the ladder, where the sag is deepest. Below BEACON_SAG_LOW_MV the cap
+  * on the ladder drops 2 dB, which also moves the beep to a lower-current
+  * PA config (RADIO_PA_CONFIG_PARAMS); after POWERCTL_RAISE_COUNT top
+  * beeps in a row above BEACON_SAG_HIGH_MV it goes back up 1 dB, up to the
+  * configured maxPower. The gap between the thresholds is wider than the
+  * sag difference of a 1 dB step, so the cap settles instead of hunting.
+  *
+  * A beep can also brown out before its measurement. The cap is kept in
+  * SRAM2 through warm resets (boot.c), and after a brownout it starts one
+  * step below the top power that caused it.
+  *
+  * Tools/beacon_sim.py runs this code on the host build against a battery
+  * model.
+  */
+
+#include "powerctl.h"
+#include "beacon.h"
+#include "console.h"
+#include "flightlog.h"
+#include "boot.h"
+
+#define POWERCTL_MAX_DBM 22
+#define POWERCTL_MIN_DBM (-9)      // lowest power of the high power PA
+#define POWERCTL_MIN_TX_MS 10      // shorter beeps end before the measurement
+#define POWERCTL_LOWER_DB 2
+#define POWERCTL_RAISE_DB 1
+#define POWERCTL_RAISE_COUNT 8
+
+PowerCtl powerCtl = {.capDbm = POWERCTL_MAX_DBM, .minMv = UINT32_MAX};
+
+static int32_t appliedCapDbm = POWERCTL_MAX_DBM;
+static uint32_t goodCount;
+
+static int32_t PowerCtl_TopDbm(void) {
+    return powerCtl.capDbm < config.maxPower ? powerCtl.capDbm : config.maxPower;
+}
+
+// After Boot_Resume(), before the beacon loop
+void PowerCtl_Init(void) {
+    // Power-on also sets BORRSTF, but never resumes
+    int32_t cap;
+    if (Boot_ResumePowerCap(&cap) && cap >= POWERCTL_MIN_DBM && cap <= POWERCTL_MAX_DBM) {
+        powerCtl.capDbm = cap;
+        int32_t top = PowerCtl_TopDbm() - POWERCTL_LOWER_DB;
+        if ((bootInfo.resetFlags & (RCC_CSR_BORRSTF >> 24)) && top >= POWERCTL_MIN_DBM) {
+            powerCtl.capDbm = top;
+            powerCtl.lowered++;
+        }
+    }
+    Boot_SavePowerCap(appliedCapDbm);
+    PowerCtl_Update();
+}
+
+// Only the strongest beep of the ladder is measured
+bool PowerCtl_WantSample(int8_t dBm, uint32_t lengthMs) {
+    return lengthMs >= POWERCTL_MIN_TX_MS && dBm == PowerCtl_TopDbm();
+}
+
+// From TimedTx(), the new cap is applied between cycles by PowerCtl_Update()
+void PowerCtl_TxSample(int8_t dBm, uint32_t mv) {
+    powerCtl.lastMv = mv;
+    if (mv == 0) {
+        return;
+    }
+    powerCtl.samples++;
+    if (mv < powerCtl.minMv) {
+        powerCtl.minMv = mv;
+    }
+
+    if (mv < BEACON_SAG_LOW_MV) {
+        goodCount = 0;
+        if (dBm - POWERCTL_LOWER_DB >= POWERCTL_MIN_DBM) {
+            powerCtl.capDbm = dBm - POWERCTL_LOWER_DB;
+            powerCtl.lowered++;
+        }
+    } else if (mv > BEACON_SAG_HIGH_MV && dBm < config.maxPower) {
+        if (++goodCount >= POWERCTL_RAISE_COUNT) {
+            goodCount = 0;
+            powerCtl.capDbm = dBm + POWERCTL_RAISE_DB;
+            powerCtl.raised++;
+        }
+    } else {
+        goodCount = 0;
+    }
+}
+
+// Rebuilds the beacon cycle when the cap changed. Called from the beacon
+// loop between cycles, never while the cycle runs.
+void PowerCtl_Update(void) {
+    if (powerCtl.capDbm == appliedCapDbm) {
+        return;
+    }
+    appliedCapDbm = powerCtl.capDbm;
+    Beacon_SetPowerCap(appliedCapDbm);
+    Boot_SavePowerCap(appliedCapDbm);
+    FlightLog_Add(FLIGHTLOG_POWER_CAP, (uint8_t) (int8_t) PowerCtl_TopDbm());
+}
+
+void PowerCtl_Dump(void) {
+    Console_Printf("power cap %ld dBm (max %ld), last %lu mV, min %lu mV, %lu samples, %lu lowered, %lu raised\r\n",
+                   (long) PowerCtl_TopDbm(), (long) config.maxPower, (unsigned long) powerCtl.lastMv,
+                   (unsigned long) (powerCtl.samples ? powerCtl.minMv : 0), (unsigned long) powerCtl.samples,
+                   (unsigned long) powerCtl.lowered, (unsigned long) powerCtl.raised);
+}
@@ -0,0 +1,470 @@
+/**
+  ******************************************************************************
+  * @file           : radio.c
+  * @brief          : SUBGHZ radio commands with a shadow copy of the radio state.
+  ******************************************************************************
+  * Configuration commands (packet type, frequency, PA, TX params, modulation
+  * and packet params, fallback mode, IRQ routing) are remembered after they
+  * are sent. Sending the same parameters again is skipped, which saves the
+  * SPI transfer and the BUSY wait that follows every command.
+  *
+  * Radio_Delay() also manages the radio power state between transmissions:
+  * depending on the length of the wait and the measured wake-up time it
+  * leaves the radio in STDBY_XOSC, drops it to STDBY_RC or puts it to Sleep
+  * with warm start, and wakes it back to STDBY_XOSC just before the wait ends.
+  */
+
+#include "radio.h"
+#include "radioscript.h"
+#include "lowpower.h"
+#include "rfmath.h"
+#include "energy.h"
+#include "radiotrace.h"
+#include "flashwork.h"
+#include "powerctl.h"
+#include "supply.h"
+#include "cycles.h"
+#include <string.h>
+
+extern SUBGHZ_HandleTypeDef hsubghz;
+
+// Longest parameter list of a shadowed command (SetPacketParams in FSK mode)
+#define RADIO_SHADOW_MAX_PARAMS 9
+
+typedef struct {
+    uint8_t opcode;
+    uint8_t size; // 0 until the command has been sent once
+    uint8_t params[RADIO_SHADOW_MAX_PARAMS];
+} RadioShadow;
+
+static RadioShadow shadow[] = {
+    {0x8A}, // SetPacketType
+    {0x86}, // SetRfFrequency
+    {0x95}, // SetPaConfig
+    {0x8E}, // SetTxParams
+    {0x8B}, // SetModulationParams
+    {0x8C}, // SetPacketParams
+    {0x93}, // SetTxRxFallbackMode
+    {0x08}, // SetDioIrqParams
+    {0x96}, // SetRegulatorMode
+    {0x8F}, // SetBufferBaseAddress
+};
+
+RadioStats radioStats;
+
+// Set from the SUBGHZ IRQ when the radio ends a transmission by itself
+volatile bool radioTxDone = false;
+static uint32_t radioTxDeadline;
+
+// Idle states are only used when the wait is at least this much longer than
+// twice the wake-up time, to cover the MCU wake-up and tick rounding.
+#define RADIO_IDLE_MARGIN_MS 2
+
+static RadioPowerState radioState = RADIO_STDBY_XOSC;
+
+// Last PA config and output power sent, for the energy ledger
+static uint8_t radioPaConfig[3] = {RADIO_PA_DUTY(22), RADIO_PA_HPMAX(22), RADIO_PA_LP(22)};
+static int8_t radioOutputDbm;
+
+// Time from the wake-up command until the radio is back in STDBY_XOSC, in us.
+// Starts from conservative guesses that are replaced by the first measurement.
+RadioWakeCost radioWakeCost[RADIO_POWER_STATES] = {
+    [RADIO_STDBY_XOSC] = {0, 0, 0},
+    [RADIO_STDBY_RC]   = {1000, 0, 0},
+    [RADIO_SLEEP]      = {3000, 0, 0},
+};
+
+// Milliseconds spent in each idle state by Radio_Delay()
+uint32_t radioIdleMs[RADIO_POWER_STATES];
+RadioTiming radioTiming;
+
+static void Radio_SetState(RadioPowerState state) {
+    radioState = state;
+    Energy_Radio(state);
+}
+
+// Follows the output power from the raw SetPaConfig / SetTxParams commands,
+// which is all a replayed radio script sends.
+static void Radio_TrackPower(uint8_t opcode, const uint8_t *params) {
+    if (opcode == 0x95) {
+        memcpy(radioPaConfig, params, sizeof(radioPaConfig));
+    } else if (opcode == 0x8E) {
+        // The output power SetOutputPower() would have sent these bytes for,
+        // otherwise the power relative to the 22 dBm config
+        radioOutputDbm = (int8_t) params[0];
+        for (int8_t dBm = -21; dBm <= 22; dBm++) {
+            if (radioPaConfig[0] == RADIO_PA_DUTY(dBm) && radioPaConfig[1] == RADIO_PA_HPMAX(dBm) &&
+                radioPaConfig[2] == RADIO_PA_LP(dBm) && (int8_t) params[0] == RADIO_TX_POWER(dBm)) {
+                radioOutputDbm = dBm;
+                break;
+            }
+        }
+    }
+}
+
+static RadioShadow *Radio_FindShadow(uint8_t opcode) {
+    for (uint8_t i = 0; i < sizeof(shadow) / sizeof(shadow[0]); i++) {
+        if (shadow[i].opcode == opcode) {
+            return &shadow[i];
+        }
+    }
+    return NULL;
+}
+
+static void Radio_ForgetShadow(uint8_t opcode) {
+    RadioShadow *entry = Radio_FindShadow(opcode);
+    if (entry) {
+        entry->size = 0;
+    }
+}
+
+HAL_StatusTypeDef Radio_ExecSetCmd(uint8_t opcode, uint8_t *params, uint16_t size) {
+    if (radioRecorder) {
+        RadioScript_AppendCmd(radioRecorder, opcode, params, size);
+        return HAL_OK;
+    }
+
+    RadioShadow *entry = Radio_FindShadow(opcode);
+    if (entry && entry->size == size && memcmp(entry->params, params, size) == 0) {
+        radioStats.suppressed++;
+        radioStats.bytesSuppressed += size + 1;
+        return HAL_OK;
+    }
+
+    // Any command wakes the radio from Sleep into STDBY_RC
+    if (radioState == RADIO_SLEEP) {
+        Radio_SetState(RADIO_STDBY_RC);
+    }
+
+    HAL_StatusTypeDef status = HAL_SUBGHZ_ExecSetCmd(&hsubghz, (SUBGHZ_RadioSetCmd_t) opcode, params, size);
+    RADIO_TRACE_CMD(opcode, params, size);
+    radioStats.issued++;
+    radioStats.bytesIssued += size + 1;
+
+    if (entry) {
+        if (status == HAL_OK && size > 0 && size <= RADIO_SHADOW_MAX_PARAMS) {
+            memcpy(entry->params, params, size);
+            entry->size = size;
+        } else {
+            entry->size = 0;
+        }
+    }
+
+    // A new packet type resets the modulation and packet parameters
+    if (opcode == 0x8A) {
+        Radio_ForgetShadow(0x8B);
+        Radio_ForgetShadow(0x8C);
+    }
+
+    if (opcode == 0x80) {
+        Radio_SetState(params[0] ? RADIO_STDBY_XOSC : RADIO_STDBY_RC);
+    } else if (opcode == 0x84) {
+        Radio_SetState(RADIO_SLEEP);
+        // Only a warm start keeps the configuration
+        if (!(params[0] & 0x04)) {
+            Radio_InvalidateShadow();
+        }
+    } else if (opcode == 0x83 || opcode == 0xD1 || opcode == 0xD2) {
+        // Transmissions end in the STDBY_XOSC fallback mode
+        radioState = RADIO_STDBY_XOSC;
+        Energy_RadioTx(radioOutputDbm);
+        if (radioTiming.firstTxTick == 0) {
+            radioTiming.firstTxTick = HAL_GetTick();
+        }
+    } else if (opcode == 0x95 || opcode == 0x8E) {
+        Radio_TrackPower(opcode, params);
+    }
+    return status;
+}
+
+// Forget everything, e.g. after the radio lost its configuration
+void Radio_InvalidateShadow() {
+    for (uint8_t i = 0; i < sizeof(shadow) / sizeof(shadow[0]); i++) {
+        shadow[i].size = 0;
+    }
+}
+
+void Radio_ResetStats() {
+    memset(&radioStats, 0, sizeof(radioStats));
+}
+
+void SetStandbyXOSC() {
+    uint8_t txbuf[2] = {0x80, 0x01};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+void SetStandbyRC() {
+    uint8_t txbuf[2] = {0x80, 0x00};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+void SetSleep(uint8_t config) {
+    // Bit 2: warm start (keep the configuration), bit 0: wake up on the RTC
+    // The next command wakes the radio up into STDBY_RC
+    uint8_t txbuf[2] = {0x84, config};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+void SetPacketTypeLora() {
+    uint8_t txbuf[2] = {0x8A, 0x01};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+void SetPacketTypeFSK() {
+    uint8_t txbuf[2] = {0x8A, 0x00};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+void SetRfFreq(uint32_t rfFreq) {
+    uint8_t txbuf[5] = {0x86, (rfFreq & 0xFF000000) >> 24, (rfFreq & 0x00FF0000) >> 16, (rfFreq & 0x0000FF00) >> 8, rfFreq & 0x000000FF};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+void SetPaLowPower() {
+    // set Pa to 14 dB.
+    uint8_t txbuf[5] = {0x95, 0x02, 0x02, 0x00, 0x01};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+void SetPa22dB() {
+    // set Pa to the highest 22 dBm
+    uint8_t txbuf[5] = {0x95, 0x04, 0x07, 0x00, 0x01};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+void SetTxPower(int8_t powerdBm) {
+    // Between -9 and 22
+    int8_t power = powerdBm < -9 ? -9 : ((powerdBm > 22) ? 22 : powerdBm);
+    uint8_t txbuf[3] = {0x8E, (uint8_t) power, 0x02};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+void SetRegulatorMode(uint8_t mode) {
+    // 0x00 LDO, 0x01 SMPS
+    uint8_t txbuf[2] = {0x96, mode};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+// Sets the PA config and TX power for an output of powerdBm, using the
+// lowest-current PA setting that reaches it.
+void SetOutputPower(int8_t powerdBm) {
+    uint8_t paConfig[5] = {0x95, RADIO_PA_CONFIG_PARAMS(powerdBm)};
+    Radio_ExecSetCmd(paConfig[0], paConfig+1, sizeof(paConfig)-1);
+    uint8_t txParams[3] = {0x8E, RADIO_TX_PARAMS(powerdBm)};
+    Radio_ExecSetCmd(txParams[0], txParams+1, sizeof(txParams)-1);
+}
+
+void SetContinuousWave() {
+    uint8_t txbuf[1] = {0xD1};
+    Radio_ExecSetCmd(txbuf[0], txbuf, 0);
+}
+
+void SetTxInfinitePreamble() {
+    uint8_t txbuf[1] = {0xD2};
+    Radio_ExecSetCmd(txbuf[0], txbuf, 0);
+}
+
+void SetTx(uint32_t timeout) {
+    // Timeout * 15.625 µs
+    uint8_t txbuf[4] = {0x83, (timeout & 0x00FF0000) >> 16, (timeout & 0x0000FF00) >> 8, timeout & 0x000000FF};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+void SetRx(uint32_t timeout) {
+    // Timeout * 15.625 µs
+    // 0x000000 No timeout. Rx Single mode
+    // 0xFFFFFF Rx Continuous mode. The device remains in RX mode until the host sends a command to change the operation mode
+    uint8_t txbuf[4] = {0x82, (timeout & 0x00FF0000) >> 16, (timeout & 0x0000FF00) >> 8, timeout & 0x000000FF};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+void SetTxRxFallbackMode(uint8_t mode) {
+    // 0x20 STDBY_RC, 0x30 STDBY_XOSC, 0x40 FS
+    uint8_t txbuf[2] = {0x93, mode};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+void SetDioIrqParams(uint16_t irqMask, uint16_t dio1Mask, uint16_t dio2Mask, uint16_t dio3Mask) {
+    uint8_t txbuf[9] = {0x08, (irqMask >> 8) & 0xFF, irqMask & 0xFF, (dio1Mask >> 8) & 0xFF, dio1Mask & 0xFF,
+                        (dio2Mask >> 8) & 0xFF, dio2Mask & 0xFF, (dio3Mask >> 8) & 0xFF, dio3Mask & 0xFF};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+void SetModulationParamsLora(const uint8_t params[4]) {
+    uint8_t txbuf[5] = {0x8B, params[0], params[1], params[2], params[3]};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+void SetModulationParamsFSK(uint32_t bitrate, uint8_t pulseshape, uint8_t bandwidth, uint32_t freq_dev) {
+    uint32_t BR = ComputeFSKBitrate(bitrate);
+    uint32_t fdev = ComputeFSKFdev(freq_dev);
+    uint8_t txbuf[9] = {0x8B, (BR & 0x00FF0000) >> 16, (BR & 0x0000FF00) >> 8, BR & 0x000000FF, pulseshape, bandwidth, (fdev & 0x00FF0000) >> 16, (fdev & 0x0000FF00) >> 8, fdev & 0x000000FF};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+void SetPacketParamsLora(uint16_t preamble_length, bool header_fixed, uint8_t payload_length, bool crc_enabled, bool invert_iq) {
+    uint8_t txbuf[7] = {0x8C, (uint8_t)((preamble_length >> 8) & 0xFF), (uint8_t)(preamble_length & 0xFF),
+                        (uint8_t) header_fixed, payload_length, (uint8_t) crc_enabled, (uint8_t) invert_iq};
+
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+void SetPacketParamsFSK(uint16_t preamble_length, uint8_t payload_length) {
+    // Preamble length in bits. No preamble detector, sync word, address filtering, CRC or whitening, fixed length
+    uint8_t txbuf[10] = {0x8C, (uint8_t)((preamble_length >> 8) & 0xFF), (uint8_t)(preamble_length & 0xFF),
+                         0x00, 0x00, 0x00, 0x00, payload_length, 0x01, 0x00};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+void SetBufferBaseAddress(uint8_t txBase, uint8_t rxBase) {
+    uint8_t txbuf[3] = {0x8F, txBase, rxBase};
+    Radio_ExecSetCmd(txbuf[0], txbuf+1, sizeof(txbuf)-1);
+}
+
+// The 256 byte radio buffer, also while a packet from another part of it
+// is being sent
+void WriteBuffer(uint8_t offset, const uint8_t *data, uint8_t len) {
+    HAL_SUBGHZ_WriteBuffer(&hsubghz, offset, (uint8_t *) data, len);
+    RADIO_TRACE_CMD(0x0E, &offset, 1);
+    radioStats.issued++;
+    radioStats.bytesIssued += len + 2;
+}
+
+/*
+void ReadBuffer(uint8_t offset, uint8_t *data, uint8_t len) {
+    HAL_SUBGHZ_ReadBuffer(&hsubghz, offset, data, len);
+}
+*/
+
+void HAL_SUBGHZ_TxCpltCallback(SUBGHZ_HandleTypeDef *hsubghz) {
+    radioTxDone = true;
+}
+
+void HAL_SUBGHZ_RxTxTimeoutCallback(SUBGHZ_HandleTypeDef *hsubghz) {
+    radioTxDone = true;
+}
+
+void TimedTx(uint32_t lengthMs) {
+    // The radio ends the transmission after lengthMs on its own timebase and
+    // falls back to STDBY_XOSC, the MCU sleeps until the IRQ arrives.
+    if (radioRecorder) {
+        RadioScript_AppendTx(radioRecorder, lengthMs);
+        return;
+    }
+
+    Radio_StartTx(lengthMs);
+    Radio_SampleTxSupply(lengthMs);
+    Radio_WaitTx();
+}
+
+// The supply under load, for the power ladder cap. Called right after
+// Radio_StartTx() of a transmission of lengthMs, samples late in it.
+void Radio_SampleTxSupply(uint32_t lengthMs) {
+    if (PowerCtl_WantSample(radioOutputDbm, lengthMs)) {
+        LowPower_SleepUntil(HAL_GetTick() + lengthMs * 3 / 4);
+        PowerCtl_TxSample(radioOutputDbm, Supply_MeasureMv());
+    }
+}
+
+// SetTx with a timeout of lengthMs, the end is waited for by Radio_WaitTx().
+// A packet ends earlier, when its last bit is sent.
+void Radio_StartTx(uint32_t lengthMs) {
+    radioTxDone = false;
+    SetTx(lengthMs * 64);
+    // Safety net in case the IRQ never comes
+    radioTxDeadline = HAL_GetTick() + lengthMs + 10;
+}
+
+// SetContinuousWave, which the radio keeps up until SetStandby: the caller
+// ends it after lengthMs and sets radioTxDone. Radio_WaitTx() sends
+// SetStandby itself if that has not happened by the deadline.
+void Radio_StartCw(uint32_t lengthMs) {
+    radioTxDone = false;
+    SetContinuousWave();
+    radioTxDeadline = HAL_GetTick() + lengthMs + 10;
+}
+
+// Sleeps until the radio reports the end of the transmission or its
+// deadline passes, without sending any command.
+void Radio_SleepTx(void) {
+    while (!radioTxDone && (int32_t)(radioTxDeadline - HAL_GetTick()) > 0) {
+        LowPower_Sleep(radioTxDeadline - HAL_GetTick());
+    }
+}
+
+void Radio_WaitTx(void) {
+    Radio_SleepTx();
+    if (!radioTxDone) {
+        SetStandbyXOSC();
+    }
+    Energy_Radio(RADIO_STDBY_XOSC);
+    RADIO_TRACE_EVENT(RTRACE_TX_END, 0, 0);
+}
+
+static uint32_t Radio_WakeMs(RadioPowerState state) {
+    return (radioWakeCost[state].lastUs + 999) / 1000;
+}
+
+// Deepest state that can be left again before a wait of ms milliseconds ends
+RadioPowerState Radio_IdleStateFor(uint32_t ms) {
+    for (RadioPowerState state = RADIO_SLEEP; state > RADIO_STDBY_XOSC; state--) {
+        if (ms >= 2 * Radio_WakeMs(state) + RADIO_IDLE_MARGIN_MS) {
+            return state;
+        }
+    }
+    return RADIO_STDBY_XOSC;
+}
+
+static void Radio_Wake(RadioPowerState from) {
+    Cycles_Enable();
+
+    // SetStandby returns once BUSY drops, i.e. the crystal is running
+    uint32_t start = DWT->CYCCNT;
+    SetStandbyXOSC();
+    uint32_t us = Cycles_ToUs(DWT->CYCCNT - start);
+
+    RadioWakeCost *cost = &radioWakeCost[from];
+    cost->lastUs = us;
+    if (us > cost->maxUs) {
+        cost->maxUs = us;
+    }
+    cost->count++;
+}
+
+// LowPower_Delay() that can be recorded into a radio script. The radio is
+// parked in the cheapest state it can wake up from in time and is back in
+// STDBY_XOSC when the delay returns.
+void Radio_Delay(uint32_t ms) {
+    if (radioRecorder) {
+        RadioScript_AppendDelay(radioRecorder, ms);
+        return;
+    }
+
+    uint32_t end = HAL_GetTick() + ms;
+    RadioPowerState idle = Radio_IdleStateFor(ms);
+    RADIO_TRACE_EVENT(RTRACE_DELAY, idle, ms);
+    if (idle == RADIO_SLEEP) {
+        SetSleep(0x04);
+    } else if (idle == RADIO_STDBY_RC) {
+        SetStandbyRC();
+    }
+
+    uint32_t wakeMs = Radio_WakeMs(idle);
+    FlashWork_RunUntil(end - wakeMs);
+    LowPower_SleepUntil(end - wakeMs);
+    radioIdleMs[idle] += ms - wakeMs;
+    if (idle != RADIO_STDBY_XOSC) {
+        Radio_Wake(idle);
+    }
+    radioIdleMs[RADIO_STDBY_XOSC] += wakeMs;
+    LowPower_SleepUntil(end);
+
+    int32_t late = (int32_t) (HAL_GetTick() - end);
+    radioTiming.count++;
+    if (late > 0) {
+        radioTiming.lateCount++;
+        if ((uint32_t) late > radioTiming.maxLateMs) {
+            radioTiming.maxLateMs = late;
+        }
+    }
+}
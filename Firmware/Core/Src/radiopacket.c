@@ -0,0 +1,293 @@
+/**
+  ******************************************************************************
+  * @file           : radiopacket.c
+  * @brief          : Tone sequences clocked out of the radio buffer as FSK packets.
+  ******************************************************************************
+  * With no sync word, CRC or whitening, an FSK packet sends the buffer bits
+  * as they are, at the bitrate of the radio crystal. A tone is a square wave
+  * of bits (alternating bits are a tone of half the bitrate, the same as
+  * the FSK beeps' preamble), and silence is a run of zeros: a steady
+  * carrier that an FM receiver hears as quiet.
+  *
+  * A message is rendered into one half of the radio buffer at a time, as
+  * one packet. While the radio sends one half, the other half is rendered
+  * and written; the TX done IRQ of the first then starts the second. A
+  * packet only ends right after a tone, so the restart falls into a
+  * silence, where the radio is off and the MCU times the rest of it. The
+  * packets start at fixed offsets from the start of the message, so the
+  * bit timing holds across them. Only a tone longer than a buffer half
+  * (1.28 s at 800 bps) is cut in two.
+  *
+  * The preamble of each packet is sent in place of the first bits of its
+  * first tone when that is a tone at half the bitrate (morse), otherwise it
+  * is a short blip right before the tone.
+  *
+  * A stream (RadioPacket_Stream) has no silences to restart in, so its
+  * packets are as long as possible: the whole buffer, all from offset 0.
+  * The first half of the next packet is written once the radio is past it
+  * in the current one, the second half right after the next packet has
+  * started. Between packets only SetTx goes to the radio, the carrier
+  * break is about 0.5 ms.
+  */
+
+#include "radiopacket.h"
+#include "radio.h"
+#include "lowpower.h"
+#include "energy.h"
+#include "radiotrace.h"
+#include <string.h>
+
+#define RADIOPACKET_HALF_BITS (RADIOPACKET_HALF_SIZE * 8)
+
+// TX timeout past the expected end of a packet
+#define RADIOPACKET_TIMEOUT_MARGIN_MS 20
+
+typedef struct {
+    RadioPacketSource source;
+    void *context;
+    RadioPacketRun run;
+    uint32_t runDone; // bits of run already rendered, for the tone phase
+    bool pending;     // run is valid
+    uint32_t pos;     // message bit where the rest of run starts
+} RadioPacketReader;
+
+// Part of the message in one buffer half
+typedef struct {
+    int32_t startBit; // where its preamble starts in the message
+    uint32_t bits;    // after the preamble
+} RadioPacketChunk;
+
+static uint8_t radioPacketHalf[RADIOPACKET_HALF_SIZE];
+
+static bool RadioPacket_Next(RadioPacketReader *r) {
+    if (!r->pending) {
+        if (!r->source(r->context, &r->run)) {
+            return false;
+        }
+        r->pending = true;
+        r->runDone = 0;
+    }
+    return true;
+}
+
+static void RadioPacket_Consume(RadioPacketReader *r, uint32_t bits) {
+    r->run.bits -= bits;
+    r->runDone += bits;
+    r->pos += bits;
+    if (r->run.bits == 0) {
+        r->pending = false;
+    }
+}
+
+// Renders the next packet into radioPacketHalf, false at the end of the message
+static bool RadioPacket_Render(RadioPacketReader *r, RadioPacketChunk *chunk) {
+    memset(radioPacketHalf, 0, sizeof(radioPacketHalf));
+
+    // Silence before the first tone is timed by the MCU
+    while (RadioPacket_Next(r) && r->run.halfPeriod == 0) {
+        RadioPacket_Consume(r, r->run.bits);
+    }
+    if (!r->pending) {
+        return false;
+    }
+
+    // A tone at half the bitrate continues the 0101 preamble, which then
+    // replaces its first bits
+    chunk->startBit = (int32_t) r->pos - RADIOPACKET_PREAMBLE_BITS;
+    if (r->run.halfPeriod == 1 && r->run.bits > RADIOPACKET_PREAMBLE_BITS && r->runDone % 2 == 0) {
+        chunk->startBit += RADIOPACKET_PREAMBLE_BITS;
+        RadioPacket_Consume(r, RADIOPACKET_PREAMBLE_BITS);
+    }
+
+    uint32_t used = 0;
+    uint32_t committed = 0;
+    while (RadioPacket_Next(r)) {
+        uint32_t bits = r->run.bits;
+        if (r->run.halfPeriod == 0) {
+            // Left as zeros, sent only if a tone follows in this packet
+            if (used + bits > RADIOPACKET_HALF_BITS) {
+                break;
+            }
+        } else if (used + bits > RADIOPACKET_HALF_BITS) {
+            if (committed > 0) {
+                break;
+            }
+            bits = RADIOPACKET_HALF_BITS - used;
+        }
+
+        if (r->run.halfPeriod != 0) {
+            for (uint32_t i = 0; i < bits; i++) {
+                if (((r->runDone + i) / r->run.halfPeriod) & 1) {
+                    radioPacketHalf[(used + i) >> 3] |= 0x80 >> ((used + i) & 7);
+                }
+            }
+            committed = used + bits;
+        }
+        used += bits;
+        RadioPacket_Consume(r, bits);
+        if (used == RADIOPACKET_HALF_BITS) {
+            break;
+        }
+    }
+    chunk->bits = committed;
+    return true;
+}
+
+static uint8_t RadioPacket_Bytes(const RadioPacketChunk *chunk) {
+    return (uint8_t) ((chunk->bits + 7) / 8);
+}
+
+// Sends the message from source as FSK packets at bitrate. The radio must be
+// in STDBY_XOSC on the frequency, and is left there with the endless
+// preamble packet params of the beeps.
+void RadioPacket_Send(uint32_t bitrate, int8_t powerdBm, RadioPacketSource source, void *context) {
+    RadioPacketReader reader = {source, context};
+    RadioPacketChunk chunks[2];
+
+    SetOutputPower(powerdBm);
+    SetModulationParamsFSK(bitrate, 0x09, 0x1E, 2500);
+
+    if (!RadioPacket_Render(&reader, &chunks[0])) {
+        return;
+    }
+    WriteBuffer(0, radioPacketHalf, RadioPacket_Bytes(&chunks[0]));
+
+    // Message time 0, so that the first packet starts now
+    uint32_t start = HAL_GetTick() - chunks[0].startBit * 1000 / (int32_t) bitrate;
+    uint8_t half = 0;
+    bool more = true;
+    while (more) {
+        const RadioPacketChunk *chunk = &chunks[half];
+        LowPower_SleepUntil(start + chunk->startBit * 1000 / (int32_t) bitrate);
+
+        SetBufferBaseAddress(half * RADIOPACKET_HALF_SIZE, 0);
+        SetPacketParamsFSK(RADIOPACKET_PREAMBLE_BITS, RadioPacket_Bytes(chunk));
+        HAL_GPIO_WritePin(LED_GPIO_Port, LED_Pin, GPIO_PIN_SET);
+        Energy_Led(true);
+        RADIO_TRACE_EVENT(RTRACE_LED, 0, 1);
+        Radio_StartTx((RADIOPACKET_PREAMBLE_BITS + RadioPacket_Bytes(chunk) * 8) * 1000 / bitrate +
+                      RADIOPACKET_TIMEOUT_MARGIN_MS);
+
+        // The other half is refilled while this one is sent
+        more = RadioPacket_Render(&reader, &chunks[half ^ 1]);
+        if (more) {
+            WriteBuffer((half ^ 1) * RADIOPACKET_HALF_SIZE, radioPacketHalf, RadioPacket_Bytes(&chunks[half ^ 1]));
+        }
+
+        Radio_WaitTx();
+        HAL_GPIO_WritePin(LED_GPIO_Port, LED_Pin, GPIO_PIN_RESET);
+        Energy_Led(false);
+        RADIO_TRACE_EVENT(RTRACE_LED, 0, 0);
+        half ^= 1;
+    }
+
+    SetPacketParamsFSK(0xFFFF, 0);
+}
+
+// Time for bits at bitrate, rounded up
+static uint32_t RadioPacket_Ms(uint32_t bits, uint32_t bitrate) {
+    return (bits * 1000 + bitrate - 1) / bitrate;
+}
+
+// Fills len bytes, or as many as the stream has left
+static uint16_t RadioPacket_Fill(RadioPacketFill fill, void *context, uint16_t len) {
+    uint16_t done = 0;
+    uint16_t n;
+    while (done < len && (n = fill(context, radioPacketHalf + done, len - done)) > 0) {
+        done += n;
+    }
+    return done;
+}
+
+// Sends the bitstream from fill as back-to-back FSK packets at bitrate. The
+// radio must be in STDBY_XOSC on the frequency, and is left there with the
+// endless preamble packet params of the beeps. Nothing is sent above
+// RADIOPACKET_STREAM_MAX_BITRATE, where the buffer refill cannot keep up.
+void RadioPacket_Stream(uint32_t bitrate, int8_t powerdBm, RadioPacketFill fill, void *context) {
+    if (bitrate > RADIOPACKET_STREAM_MAX_BITRATE) {
+        return;
+    }
+    uint16_t first = RadioPacket_Fill(fill, context, RADIOPACKET_HALF_SIZE);
+    if (first == 0) {
+        return;
+    }
+
+    SetOutputPower(powerdBm);
+    SetModulationParamsFSK(bitrate, 0x09, 0x1E, 2500);
+    SetBufferBaseAddress(0, 0);
+    WriteBuffer(0, radioPacketHalf, first);
+    uint16_t second = 0;
+    if (first == RADIOPACKET_HALF_SIZE) {
+        second = RadioPacket_Fill(fill, context, RADIOPACKET_STREAM_SIZE - RADIOPACKET_HALF_SIZE);
+    }
+
+    HAL_GPIO_WritePin(LED_GPIO_Port, LED_Pin, GPIO_PIN_SET);
+    Energy_Led(true);
+    RADIO_TRACE_EVENT(RTRACE_LED, 0, 1);
+    while (first > 0) {
+        uint16_t length = first + second;
+        SetPacketParamsFSK(RADIOPACKET_PREAMBLE_BITS, (uint8_t) length);
+        uint32_t start = HAL_GetTick();
+        Radio_StartTx(RadioPacket_Ms(RADIOPACKET_PREAMBLE_BITS + length * 8, bitrate) +
+                      RADIOPACKET_TIMEOUT_MARGIN_MS);
+
+        // The radio is still sending the first half
+        if (second > 0) {
+            WriteBuffer(RADIOPACKET_HALF_SIZE, radioPacketHalf, (uint8_t) second);
+        }
+
+        first = 0;
+        if (length == RADIOPACKET_STREAM_SIZE) {
+            first = RadioPacket_Fill(fill, context, RADIOPACKET_HALF_SIZE);
+        }
+        if (first > 0) {
+            // Past the first half, with a tick of rounding and the TX ramp-up
+            LowPower_SleepUntil(start + RadioPacket_Ms(RADIOPACKET_PREAMBLE_BITS + RADIOPACKET_HALF_BITS, bitrate) + 2);
+            WriteBuffer(0, radioPacketHalf, (uint8_t) first);
+            second = 0;
+            if (first == RADIOPACKET_HALF_SIZE) {
+                second = RadioPacket_Fill(fill, context, RADIOPACKET_STREAM_SIZE - RADIOPACKET_HALF_SIZE);
+            }
+        }
+        Radio_WaitTx();
+    }
+    HAL_GPIO_WritePin(LED_GPIO_Port, LED_Pin, GPIO_PIN_RESET);
+    Energy_Led(false);
+    RADIO_TRACE_EVENT(RTRACE_LED, 0, 0);
+
+    SetPacketParamsFSK(0xFFFF, 0);
+}
+
+typedef struct {
+    const RadioPacketTone *tones;
+    uint16_t count;
+    uint32_t bitrate;
+    uint32_t ms;   // start of the next tone in the message
+    uint32_t bits; // same in bits
+} RadioPacketToneReader;
+
+// Bits are counted from the start of the message, so rounding never adds up
+static bool RadioPacket_NextTone(void *context, RadioPacketRun *run) {
+    RadioPacketToneReader *r = context;
+    if (r->count == 0) {
+        return false;
+    }
+    r->ms += r->tones->ms;
+    uint32_t end = r->ms * r->bitrate / 1000;
+    run->bits = end - r->bits;
+    run->halfPeriod = r->tones->toneHz ? r->bitrate / (2 * r->tones->toneHz) : 0;
+    if (r->tones->toneHz && run->halfPeriod == 0) {
+        run->halfPeriod = 1;
+    }
+    r->bits = end;
+    r->tones++;
+    r->count--;
+    return true;
+}
+
+// Tones are rounded to bitrate / (2 * n), e.g. at 9600 bps 400, 436, 480,
+// 533 Hz, ...; silences are a steady carrier
+void RadioPacket_SendTones(const RadioPacketTone *tones, uint16_t count, uint32_t bitrate, int8_t powerdBm) {
+    RadioPacketToneReader reader = {tones, count, bitrate};
+    RadioPacket_Send(bitrate, powerdBm, RadioPacket_NextTone, &reader);
+}
@@ -0,0 +1,168 @@
+/**
+  ******************************************************************************
+  * @file           : radioscript.c
+  * @brief          : Prerecorded radio command sequences replayed as a table walk.
+  ******************************************************************************
+  * A script is recorded once by running the normal beep code while
+  * radioRecorder is set: every SUBGHZ command, timed transmission, delay and
+  * LED change is appended as a byte-coded step instead of being executed.
+  * RadioScript_Run() then replays the steps with all frequency, power and
+  * modulation words already computed.
+  */
+
+#include "radioscript.h"
+#include "radio.h"
+#include "chirp.h"
+#include "energy.h"
+#include "radiotrace.h"
+#include "cycles.h"
+
+RadioScript *radioRecorder = NULL;
+
+void RadioScript_Init(RadioScript *script, uint8_t *buf, uint16_t capacity) {
+    script->buf = buf;
+    script->capacity = capacity;
+    script->size = 0;
+    script->overflow = false;
+    if (capacity > 0) {
+        buf[0] = RSCRIPT_END;
+    }
+}
+
+void RadioScript_Record(RadioScript *script) {
+    radioRecorder = script;
+}
+
+void RadioScript_Stop() {
+    radioRecorder = NULL;
+}
+
+static bool RadioScript_Reserve(RadioScript *script, uint16_t len) {
+    // Always keep room for the terminating RSCRIPT_END
+    if (script->overflow || script->size + len + 1 > script->capacity) {
+        script->overflow = true;
+        return false;
+    }
+    return true;
+}
+
+static void RadioScript_Put(RadioScript *script, uint8_t byte) {
+    script->buf[script->size++] = byte;
+    script->buf[script->size] = RSCRIPT_END;
+}
+
+void RadioScript_AppendCmd(RadioScript *script, uint8_t opcode, const uint8_t *params, uint16_t size) {
+    if (size > 0xFF || !RadioScript_Reserve(script, 3 + size)) {
+        script->overflow = true;
+        return;
+    }
+    RadioScript_Put(script, RSCRIPT_CMD);
+    RadioScript_Put(script, opcode);
+    RadioScript_Put(script, (uint8_t) size);
+    for (uint16_t i = 0; i < size; i++) {
+        RadioScript_Put(script, params[i]);
+    }
+}
+
+static void RadioScript_AppendTimed(RadioScript *script, uint8_t step, uint32_t ms) {
+    if (ms > 0xFFFF || !RadioScript_Reserve(script, 3)) {
+        script->overflow = true;
+        return;
+    }
+    RadioScript_Put(script, step);
+    RadioScript_Put(script, ms & 0xFF);
+    RadioScript_Put(script, (ms >> 8) & 0xFF);
+}
+
+void RadioScript_AppendTx(RadioScript *script, uint32_t lengthMs) {
+    RadioScript_AppendTimed(script, RSCRIPT_TX, lengthMs);
+}
+
+void RadioScript_AppendDelay(RadioScript *script, uint32_t ms) {
+    // Long waits are split over several 16 bit steps
+    while (ms > 0xFFFF) {
+        RadioScript_AppendTimed(script, RSCRIPT_DELAY, 0xFFFF);
+        ms -= 0xFFFF;
+    }
+    if (ms > 0) {
+        RadioScript_AppendTimed(script, RSCRIPT_DELAY, ms);
+    }
+}
+
+void RadioScript_AppendChirp(RadioScript *script, uint32_t rfFreq, uint32_t lengthMs) {
+    if (lengthMs > 0xFFFF || !RadioScript_Reserve(script, 7)) {
+        script->overflow = true;
+        return;
+    }
+    RadioScript_Put(script, RSCRIPT_CHIRP);
+    for (int8_t shift = 24; shift >= 0; shift -= 8) {
+        RadioScript_Put(script, (rfFreq >> shift) & 0xFF);
+    }
+    RadioScript_Put(script, lengthMs & 0xFF);
+    RadioScript_Put(script, (lengthMs >> 8) & 0xFF);
+}
+
+void RadioScript_AppendLed(RadioScript *script, bool on) {
+    if (!RadioScript_Reserve(script, 1)) {
+        return;
+    }
+    RadioScript_Put(script, on ? RSCRIPT_LED_ON : RSCRIPT_LED_OFF);
+}
+
+void RadioScript_Run(const RadioScript *script) {
+    RadioScript_RunSteps(script->buf);
+}
+
+// Runs a recorded script or a const step table, up to its RSCRIPT_END
+void RadioScript_RunSteps(const uint8_t *steps) {
+    const uint8_t *p = steps;
+#ifdef RADIO_TRACE
+    Cycles_Enable();
+#endif
+    while (1) {
+#ifdef RADIO_TRACE
+        uint8_t step = *p;
+        uint32_t cycleStart = DWT->CYCCNT;
+#endif
+        switch (*p) {
+        case RSCRIPT_CMD:
+            // Cast away const, HAL_SUBGHZ_ExecSetCmd only reads the parameters
+            Radio_ExecSetCmd(p[1], (uint8_t *) &p[3], p[2]);
+            p += 3 + p[2];
+            break;
+        case RSCRIPT_TX:
+            TimedTx(p[1] | (p[2] << 8));
+            p += 3;
+            break;
+        case RSCRIPT_DELAY: {
+            // Merge back-to-back delays so the radio sees the whole idle time
+            uint32_t ms = 0;
+            while (*p == RSCRIPT_DELAY) {
+                ms += p[1] | (p[2] << 8);
+                p += 3;
+            }
+            Radio_Delay(ms);
+            break;
+        }
+        case RSCRIPT_CHIRP:
+            Chirp_Tx(((uint32_t) p[1] << 24) | (p[2] << 16) | (p[3] << 8) | p[4], p[5] | (p[6] << 8));
+            p += 7;
+            break;
+        case RSCRIPT_LED_ON:
+            HAL_GPIO_WritePin(LED_GPIO_Port, LED_Pin, GPIO_PIN_SET);
+            Energy_Led(true);
+            RADIO_TRACE_EVENT(RTRACE_LED, 0, 1);
+            p++;
+            break;
+        case RSCRIPT_LED_OFF:
+            HAL_GPIO_WritePin(LED_GPIO_Port, LED_Pin, GPIO_PIN_RESET);
+            Energy_Led(false);
+            RADIO_TRACE_EVENT(RTRACE_LED, 0, 0);
+            p++;
+            break;
+        default:
+            return;
+        }
+        RADIO_TRACE_EVENT(RTRACE_STEP, step, Cycles_ToUs(DWT->CYCCNT - cycleStart));
+    }
+}
@@ -0,0 +1,72 @@
+/**
+  ******************************************************************************
+  * @file           : radiotrace.c
+  * @brief          : Timestamped trace of SUBGHZ commands, LED and delays.
+  ******************************************************************************
+  * Airtime, gaps and command counts of the real firmware can be read from
+  * the dump: a transmission runs from its SetTx (0x83) command to the next
+  * TX_END event.
+  */
+
+#include "radiotrace.h"
+
+#ifdef RADIO_TRACE
+#include "console.h"
+#include <string.h>
+
+RadioTraceEvent radioTrace[RADIO_TRACE_LEN];
+uint32_t radioTraceCount;
+
+static RadioTraceEvent *RadioTrace_Next(uint8_t kind) {
+    RadioTraceEvent *event = &radioTrace[radioTraceCount++ & (RADIO_TRACE_LEN - 1)];
+    memset(event, 0, sizeof(*event));
+    event->tick = HAL_GetTick();
+    event->kind = kind;
+    return event;
+}
+
+void RadioTrace_Cmd(uint8_t opcode, const uint8_t *params, uint16_t size) {
+    RadioTraceEvent *event = RadioTrace_Next(RTRACE_CMD);
+    event->opcode = opcode;
+    event->size = size;
+    memcpy(event->params, params, size < sizeof(event->params) ? size : sizeof(event->params));
+}
+
+void RadioTrace_Event(uint8_t kind, uint8_t opcode, uint32_t value) {
+    RadioTraceEvent *event = RadioTrace_Next(kind);
+    event->opcode = opcode;
+    event->value = value;
+}
+
+void RadioTrace_Dump(void) {
+    uint32_t first = radioTraceCount > RADIO_TRACE_LEN ? radioTraceCount - RADIO_TRACE_LEN : 0;
+    Console_Printf("%lu events, %lu dropped\r\n", (unsigned long) radioTraceCount, (unsigned long) first);
+
+    for (uint32_t i = first; i < radioTraceCount; i++) {
+        const RadioTraceEvent *event = &radioTrace[i & (RADIO_TRACE_LEN - 1)];
+        Console_Printf("%10lu ", (unsigned long) event->tick);
+        switch (event->kind) {
+        case RTRACE_CMD:
+            Console_Printf("cmd %02X", event->opcode);
+            for (uint8_t j = 0; j < event->size && j < sizeof(event->params); j++) {
+                Console_Printf(" %02X", event->params[j]);
+            }
+            Console_Printf("\r\n");
+            break;
+        case RTRACE_LED:
+            Console_Printf("led %s\r\n", event->value ? "on" : "off");
+            break;
+        case RTRACE_DELAY:
+            Console_Printf("delay %lu ms state %u\r\n", (unsigned long) event->value, event->opcode);
+            break;
+        case RTRACE_TX_END:
+            Console_Printf("tx end\r\n");
+            break;
+        case RTRACE_STEP:
+            Console_Printf("step %u awake %lu us\r\n", event->opcode, (unsigned long) event->value);
+            break;
+        }
+    }
+    radioTraceCount = 0;
+}
+#endif
@@ -0,0 +1,27 @@
+/**
+  ******************************************************************************
+  * @file           : rfmath.c
+  * @brief          : Integer conversions to SUBGHZ radio register words.
+  ******************************************************************************
+  * The radio synthesizer step is 32 MHz / 2^25 = 15625 / 2^14 Hz, so every
+  * conversion can be done exactly with 64 bit integers. This keeps the soft
+  * float double routines out of the radio path on the FPU-less Cortex-M4.
+  */
+
+#include "rfmath.h"
+
+// Frequency word for SetRfFreq (opcode 0x86).
+// correctionPpb trims the crystal error, e.g. -4600 for a crystal running 4.6 ppm fast.
+uint32_t ComputeRfFreq(uint32_t frequencyHz, int32_t correctionPpb) {
+    return RF_FREQ_WORD(frequencyHz, correctionPpb);
+}
+
+// Bitrate word for SetModulationParams in FSK mode: 32 * 32 MHz / bitrate
+uint32_t ComputeFSKBitrate(uint32_t bitrate) {
+    return FSK_BITRATE_WORD(bitrate);
+}
+
+// Frequency deviation word for SetModulationParams in FSK mode: Hz * 2^25 / 32 MHz
+uint32_t ComputeFSKFdev(uint32_t freqDevHz) {
+    return FSK_FDEV_WORD(freqDevHz);
+}
@@ -22,6 +22,11 @@
 #include "stm32wlxx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "lowpower.h"
+#include "console.h"
+#include "chirp.h"
+#include "wspr.h"
+#include "eeprom_emul.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -57,6 +62,7 @@
 /* External variables --------------------------------------------------------*/
 
 /* USER CODE BEGIN EV */
+extern SUBGHZ_HandleTypeDef hsubghz;
 
 /* USER CODE END EV */
 
@@ -69,6 +75,20 @@
 void NMI_Handler(void)
 {
   /* USER CODE BEGIN NonMaskableInt_IRQn 0 */
+  // A doubleword torn by a power loss while it was programmed (emulated
+  // EEPROM, flight log) fails the ECC check and raises an NMI when read.
+  // The read then just returns a bad value. If the flash is unlocked, the
+  // doubleword is set to zero so that it never faults again.
+  if (__HAL_FLASH_GET_FLAG(FLASH_FLAG_ECCD))
+  {
+    if (READ_BIT(FLASH->CR, FLASH_CR_LOCK) == 0U)
+    {
+      // ADDR_ECC is the doubleword offset from the start of the flash
+      EE_DeleteCorruptedFlashAddress(FLASH_BASE + (FLASH->ECCR & FLASH_ECCR_ADDR_ECC) * 8U);
+    }
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ECCD);
+    return;
+  }
 
   /* USER CODE END NonMaskableInt_IRQn 0 */
   /* USER CODE BEGIN NonMaskableInt_IRQn 1 */
@@ -199,5 +219,52 @@ void SysTick_Handler(void)
 /******************************************************************************/
 
 /* USER CODE BEGIN 1 */
+/**
+  * @brief This function handles LPTIM1 global interrupt (Stop2 wake-up timer).
+  */
+void LPTIM1_IRQHandler(void)
+{
+  LowPower_IRQHandler();
+}
+
+/**
+  * @brief This function handles EXTI Line 3 interrupt (USART2 RX wake-up).
+  */
+void EXTI3_IRQHandler(void)
+{
+  Console_IRQHandler();
+}
+
+/**
+  * @brief This function handles Flash global interrupt (deferred page erases).
+  */
+void FLASH_IRQHandler(void)
+{
+  HAL_FLASH_IRQHandler();
+}
+
+/**
+  * @brief This function handles TIM16 global interrupt (chirp frequency steps).
+  */
+void TIM16_IRQHandler(void)
+{
+  Chirp_IRQHandler();
+}
+
+/**
+  * @brief This function handles TIM17 global interrupt (WSPR frequency steps).
+  */
+void TIM17_IRQHandler(void)
+{
+  Wspr_IRQHandler();
+}
+
+/**
+  * @brief This function handles SUBGHZ Radio Interrupt.
+  */
+void SUBGHZ_Radio_IRQHandler(void)
+{
+  HAL_SUBGHZ_IRQHandler(&hsubghz);
+}
 
 /* USER CODE END 1 */
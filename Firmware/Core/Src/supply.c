@@ -0,0 +1,48 @@
+/**
+  ******************************************************************************
+  * @file           : supply.c
+  * @brief          : Supply voltage measurement.
+  ******************************************************************************
+  * The ADC reference is VDDA, which is the battery on the beacon boards, so
+  * converting the internal reference VREFINT against its factory calibration
+  * gives the supply voltage. The ADC is enabled only for the conversion,
+  * and its hardware oversampler averages 16 conversions per trigger
+  * (MX_ADC_Init()), so one call is a single ~1.7 ms measurement.
+  */
+
+#include "supply.h"
+
+extern ADC_HandleTypeDef hadc;
+
+void Supply_Init(void) {
+    if (HAL_ADCEx_Calibration_Start(&hadc) != HAL_OK) {
+        Error_Handler();
+    }
+}
+
+// Returns 0 if the conversion failed
+uint32_t Supply_MeasureMv(void) {
+    ADC_ChannelConfTypeDef channel = {
+        .Channel = ADC_CHANNEL_VREFINT,
+        .Rank = ADC_REGULAR_RANK_1,
+        .SamplingTime = ADC_SAMPLINGTIME_COMMON_1,
+    };
+
+    // VREFINT needs at least 4 us of sampling, at any ADC clock
+    LL_ADC_SetSamplingTimeCommonChannels(hadc.Instance, LL_ADC_SAMPLINGTIME_COMMON_1, LL_ADC_SAMPLINGTIME_39CYCLES_5);
+    if (HAL_ADC_ConfigChannel(&hadc, &channel) != HAL_OK) {
+        return 0;
+    }
+
+    uint32_t raw = 0;
+    if (HAL_ADC_Start(&hadc) == HAL_OK && HAL_ADC_PollForConversion(&hadc, 10) == HAL_OK) {
+        raw = HAL_ADC_GetValue(&hadc);
+    }
+    HAL_ADC_Stop(&hadc);
+    LL_ADC_SetCommonPathInternalCh(__LL_ADC_COMMON_INSTANCE(hadc.Instance), LL_ADC_PATH_INTERNAL_NONE);
+
+    if (raw == 0) {
+        return 0;
+    }
+    return __HAL_ADC_CALC_VREFANALOG_VOLTAGE(raw, ADC_RESOLUTION_12B);
+}
@@ -0,0 +1,111 @@
+/**
+  ******************************************************************************
+  * @file           : wspr.c
+  * @brief          : WSPR weak-signal transmissions from a frequency word table.
+  ******************************************************************************
+  * Tools/wspr_encode.py turns a message into the WSPR symbols and those into
+  * frequency word offsets (wsprmessage.c), WSPR_SUBSTEPS per symbol since the
+  * 1.46 Hz tone spacing falls between the radio's 0.95 Hz steps. The whole
+  * message is one 110.592 s continuous wave; TIM17 interrupts once per
+  * substep and sends the next word as SetRfFrequency, the core sleeps in
+  * between. The radio has no end of its own for a continuous wave, the
+  * interrupt after the last substep sends SetStandby.
+  *
+  * A substep is 8192 / 12000 / 16 s = 42666.67 us, so the interrupt sets
+  * every period to 42666 or 42667 TIM17 counts and the symbols stay on the
+  * exact WSPR timing. The core runs from the HSE during the transmission,
+  * the timer is then as accurate as the radio crystal. TIM17 stops in
+  * Stop2, so the waits only use Sleep mode (LowPower_RequestRun()).
+  *
+  * Nothing here knows the time of day: WSPR decoders look for a start one
+  * second after an even UTC minute, so for a live decode the receiver's
+  * clock must be set to the start of the transmission (or its recording
+  * cut there).
+  */
+
+#include "wspr.h"
+#include "radio.h"
+#include "clock.h"
+#include "lowpower.h"
+#include "energy.h"
+#include "radiotrace.h"
+
+#define WSPR_STEPS (WSPR_SYMBOLS * WSPR_SUBSTEPS)
+
+// A symbol is 8192000 / 12 us, a substep WSPR_STEP_NUM / WSPR_STEP_DEN us
+#define WSPR_STEP_NUM 8192000UL
+#define WSPR_STEP_DEN (12UL * WSPR_SUBSTEPS)
+
+static const int8_t *wsprWords;
+static uint32_t wsprRfFreq;
+static uint16_t wsprNext;
+static uint32_t wsprRemainder; // of the substep lengths so far, in 1 / WSPR_STEP_DEN us
+
+void Wspr_Init(void) {
+    // TIM17 counts microseconds: PCLK2 is 1 MHz on both the MSI and the HSE clock
+    __HAL_RCC_TIM17_CLK_ENABLE();
+    TIM17->CR1 = TIM_CR1_URS;
+    TIM17->PSC = 0;
+    TIM17->DIER = TIM_DIER_UIE;
+    // Same priority as the radio IRQ, neither interrupts the other's SPI transfer
+    HAL_NVIC_SetPriority(TIM17_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(TIM17_IRQn);
+}
+
+// Length of the next substep in TIM17 counts
+static uint32_t Wspr_StepUs(void) {
+    wsprRemainder += WSPR_STEP_NUM % WSPR_STEP_DEN;
+    if (wsprRemainder >= WSPR_STEP_DEN) {
+        wsprRemainder -= WSPR_STEP_DEN;
+        return WSPR_STEP_NUM / WSPR_STEP_DEN + 1;
+    }
+    return WSPR_STEP_NUM / WSPR_STEP_DEN;
+}
+
+// Sends message around rfFreq, the frequency word of the signal center. The
+// radio must be in STDBY_XOSC, and is back in it after WSPR_LENGTH_MS.
+void Wspr_Send(const WsprMessage *message, uint32_t rfFreq) {
+    Clock_RequestHSE();
+    LowPower_RequestRun();
+
+    wsprWords = message->words;
+    wsprRfFreq = rfFreq;
+    wsprNext = 1;
+    wsprRemainder = 0;
+    SetRfFreq(rfFreq + wsprWords[0]);
+    SetOutputPower(message->powerdBm);
+
+    HAL_GPIO_WritePin(LED_GPIO_Port, LED_Pin, GPIO_PIN_SET);
+    Energy_Led(true);
+    RADIO_TRACE_EVENT(RTRACE_LED, 0, 1);
+    Radio_StartCw(WSPR_LENGTH_MS);
+    TIM17->ARR = Wspr_StepUs() - 1;
+    TIM17->CNT = 0;
+    TIM17->SR = 0;
+    TIM17->CR1 |= TIM_CR1_CEN;
+
+    // TIM17 is stopped before Radio_WaitTx() may send SetStandby after a
+    // missed last interrupt, so no step can interrupt it with SetRfFrequency
+    Radio_SleepTx();
+    TIM17->CR1 &= ~TIM_CR1_CEN;
+    Radio_WaitTx();
+    HAL_GPIO_WritePin(LED_GPIO_Port, LED_Pin, GPIO_PIN_RESET);
+    Energy_Led(false);
+    RADIO_TRACE_EVENT(RTRACE_LED, 0, 0);
+
+    LowPower_ReleaseRun();
+    Clock_ReleaseHSE();
+}
+
+void Wspr_IRQHandler(void) {
+    TIM17->SR = 0;
+    // The end of the last substep ends the transmission
+    if (wsprNext >= WSPR_STEPS) {
+        TIM17->CR1 &= ~TIM_CR1_CEN;
+        SetStandbyXOSC();
+        radioTxDone = true;
+        return;
+    }
+    TIM17->ARR = Wspr_StepUs() - 1;
+    SetRfFreq(wsprRfFreq + wsprWords[wsprNext++]);
+}
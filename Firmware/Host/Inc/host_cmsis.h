@@ -0,0 +1,115 @@
+/**
+  ******************************************************************************
+  * @file           : host_cmsis.h
+  * @brief          : Host versions of the cmsis_gcc.h macros and intrinsics.
+  ******************************************************************************
+  * Included before every source of the host build (-include). Defining the
+  * cmsis_gcc.h include guard keeps its Cortex-M inline assembly out; the
+  * intrinsics the firmware and the HAL headers use are plain C here, and
+  * the ones that touch the core (interrupt mask, WFI) go to the simulator.
+  */
+
+#ifndef __HOST_CMSIS_H
+#define __HOST_CMSIS_H
+
+#define __CMSIS_GCC_H
+
+#include <stdint.h>
+
+#ifndef __ASM
+#define __ASM                   __asm
+#endif
+#ifndef __INLINE
+#define __INLINE                inline
+#endif
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE         static inline
+#endif
+#ifndef __STATIC_FORCEINLINE
+#define __STATIC_FORCEINLINE    __attribute__((always_inline)) static inline
+#endif
+#ifndef __NO_RETURN
+#define __NO_RETURN             __attribute__((__noreturn__))
+#endif
+#ifndef __USED
+#define __USED                  __attribute__((used))
+#endif
+#ifndef __WEAK
+#define __WEAK                  __attribute__((weak))
+#endif
+#ifndef __PACKED
+#define __PACKED                __attribute__((packed, aligned(1)))
+#endif
+#ifndef __PACKED_STRUCT
+#define __PACKED_STRUCT         struct __attribute__((packed, aligned(1)))
+#endif
+#ifndef __PACKED_UNION
+#define __PACKED_UNION          union __attribute__((packed, aligned(1)))
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x)            __attribute__((aligned(x)))
+#endif
+#ifndef __RESTRICT
+#define __RESTRICT              __restrict
+#endif
+#ifndef __COMPILER_BARRIER
+#define __COMPILER_BARRIER()    __asm volatile("" ::: "memory")
+#endif
+
+// sim.c
+void Sim_DisableIrq(void);
+void Sim_EnableIrq(void);
+uint32_t Sim_GetPrimask(void);
+void Sim_SetPrimask(uint32_t primask);
+void Sim_Wfi(void);
+
+__STATIC_FORCEINLINE void __enable_irq(void) { Sim_EnableIrq(); }
+__STATIC_FORCEINLINE void __disable_irq(void) { Sim_DisableIrq(); }
+__STATIC_FORCEINLINE uint32_t __get_PRIMASK(void) { return Sim_GetPrimask(); }
+__STATIC_FORCEINLINE void __set_PRIMASK(uint32_t priMask) { Sim_SetPrimask(priMask); }
+
+#define __NOP()                 __COMPILER_BARRIER()
+#define __WFI()                 Sim_Wfi()
+#define __WFE()                 Sim_Wfi()
+#define __SEV()                 __COMPILER_BARRIER()
+#define __ISB()                 __COMPILER_BARRIER()
+#define __DSB()                 __COMPILER_BARRIER()
+#define __DMB()                 __COMPILER_BARRIER()
+#define __CLREX()               __COMPILER_BARRIER()
+#define __BKPT(value)           __builtin_trap()
+
+__STATIC_FORCEINLINE uint32_t __REV(uint32_t value) { return __builtin_bswap32(value); }
+__STATIC_FORCEINLINE uint32_t __REV16(uint32_t value) {
+    return ((value & 0xFF00FF00U) >> 8) | ((value & 0x00FF00FFU) << 8);
+}
+__STATIC_FORCEINLINE int16_t __REVSH(int16_t value) { return (int16_t) __builtin_bswap16((uint16_t) value); }
+
+__STATIC_FORCEINLINE uint32_t __ROR(uint32_t op1, uint32_t op2) {
+    op2 %= 32U;
+    if (op2 == 0U) {
+        return op1;
+    }
+    return (op1 >> op2) | (op1 << (32U - op2));
+}
+
+__STATIC_FORCEINLINE uint32_t __RBIT(uint32_t value) {
+    uint32_t result = 0;
+    for (uint8_t i = 0; i < 32; i++) {
+        result = (result << 1) | ((value >> i) & 1U);
+    }
+    return result;
+}
+
+__STATIC_FORCEINLINE uint8_t __CLZ(uint32_t value) {
+    return value == 0U ? 32U : (uint8_t) __builtin_clz(value);
+}
+
+// Single core, no exclusive monitor to lose: the store always succeeds
+__STATIC_FORCEINLINE uint8_t __LDREXB(volatile uint8_t *addr) { return *addr; }
+__STATIC_FORCEINLINE uint16_t __LDREXH(volatile uint16_t *addr) { return *addr; }
+__STATIC_FORCEINLINE uint32_t __LDREXW(volatile uint32_t *addr) { return *addr; }
+__STATIC_FORCEINLINE uint32_t __STREXB(uint8_t value, volatile uint8_t *addr) { *addr = value; return 0U; }
+__STATIC_FORCEINLINE uint32_t __STREXH(uint16_t value, volatile uint16_t *addr) { *addr = value; return 0U; }
+__STATIC_FORCEINLINE uint32_t __STREXW(uint32_t value, volatile uint32_t *addr) { *addr = value; return 0U; }
+
+#endif /* __HOST_CMSIS_H */
@@ -0,0 +1,18 @@
+/**
+  ******************************************************************************
+  * @file           : host_main.h
+  * @brief          : Included before main.c in the host build (-include).
+  ******************************************************************************
+  * main() becomes Firmware_Main(), which Sim_Boot() runs once per boot, and
+  * the Error_Handler() of sim.c, which ends the boot, replaces the endless
+  * loop of main.c.
+  */
+
+#ifndef __HOST_MAIN_H
+#define __HOST_MAIN_H
+
+#define main Firmware_Main
+
+#pragma weak Error_Handler
+
+#endif /* __HOST_MAIN_H */
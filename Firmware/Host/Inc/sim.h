@@ -0,0 +1,151 @@
+/**
+  ******************************************************************************
+  * @file           : sim.h
+  * @brief          : Virtual time, interrupts and event recorder of the host build.
+  ******************************************************************************
+  * The firmware runs unchanged on the host against a mock HAL. Every mock
+  * call costs virtual time; the timers, the radio and the flash advance
+  * with it and raise their interrupts, which call the real handlers in
+  * stm32wlxx_it.c. The peripheral registers the firmware touches directly
+  * are plain memory mapped at their addresses on the chip.
+  *
+  * Times are microseconds since the power-on of the first boot.
+  */
+
+#ifndef __SIM_H
+#define __SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include <stdbool.h>
+
+// Model values of the mocks, not measurements of a board
+#define SIM_HAL_CALL_US        2U    // any HAL call that does no I/O
+#define SIM_SPI_BYTE_US        64U   // SUBGHZ SPI at 125 kHz
+#define SIM_SPI_OVERHEAD_US    100U  // HAL code around a SUBGHZ transfer at 1 MHz
+#define SIM_RADIO_WAKE_US      2700U // Sleep to STDBY_RC, warm start
+#define SIM_RADIO_XOSC_US      600U  // STDBY_RC to STDBY_XOSC
+#define SIM_FLASH_PROGRAM_US   82U   // one doubleword
+#define SIM_FLASH_ERASE_US     22000U // one 2K page
+#define SIM_ADC_CONVERSION_US  1700U // 16x oversampled VREFINT
+#define SIM_UART_CHAR_US       1042U // 9600 baud
+#define SIM_RESET_US           2000U // reset and startup code before main()
+
+// LSI of the chip, 32000 Hz unless a test sets another one before the boot.
+// It clocks LPTIM1 and can be captured by TIM16 (TIM16_OR1 TI1_RMP = LSI).
+extern uint32_t simLsiHz;
+
+typedef enum {
+    SIM_EVENT_CMD,   // SUBGHZ command: opcode, parameter bytes
+    SIM_EVENT_WRITE, // WriteBuffer: opcode is the offset, data bytes
+    SIM_EVENT_LED,   // value 1 on, 0 off
+    SIM_EVENT_DELAY, // HAL_Delay(): value ms
+    SIM_EVENT_STOP,  // Stop2: value us slept
+} SimEventType;
+
+// Leading bytes kept of a command or buffer write
+#define SIM_EVENT_DATA 16
+
+typedef struct {
+    uint64_t us;     // when the call started
+    SimEventType type;
+    uint8_t opcode;
+    uint16_t size;   // of the whole parameter list or write
+    uint8_t data[SIM_EVENT_DATA];
+    uint32_t value;
+} SimEvent;
+
+// A transmission, reported when it ends
+typedef struct {
+    uint64_t startUs;
+    uint64_t endUs;
+    int8_t dBm;
+    uint32_t rfFreq;     // at the start
+    uint32_t freqSteps;  // SetRfFrequency commands during the transmission
+    bool packet;         // FSK packet, ended by its last bit unless timedOut
+    bool timedOut;
+    uint32_t bitrateWord; // BR of SetModulationParams, a bit is BR / 1024 us
+    uint16_t preambleBits;
+    uint16_t length;     // payload bytes of a packet
+    uint8_t payload[256]; // as the radio read it from its buffer
+} SimTx;
+
+// Callbacks of a simulation driver, all optional
+typedef struct {
+    void (*load)(uint64_t us, uint32_t uA);  // supply current changed
+    uint32_t (*supplyMv)(uint64_t us);       // at an ADC conversion, 3000 mV if NULL
+    void (*tx)(const SimTx *tx);             // a transmission ended
+    void (*console)(const uint8_t *data, uint16_t size); // UART output
+} SimHooks;
+
+extern SimHooks simHooks;
+
+// Recording, off until Sim_Record(true)
+extern SimEvent *simEvents;
+extern uint32_t simEventCount;
+extern SimTx *simTxs;
+extern uint32_t simTxCount;
+
+// Kept across the boots run by Sim_Boot()
+typedef struct {
+    uint64_t nowUs;
+    uint64_t endUs;          // a boot ends when the time reaches this
+    uint32_t boots;
+    uint32_t txCount;
+    uint32_t cmdCount;
+    uint32_t retainedSize;   // 0 after a power loss
+    uint8_t retained[256];   // the .noinit section
+} SimShared;
+
+extern SimShared *simShared;
+
+typedef enum {
+    SIM_BOOT_END,    // the time ran out
+    SIM_BOOT_RESET,  // Sim_Reset()
+    SIM_BOOT_ERROR,  // Error_Handler() or a crash
+} SimBootResult;
+
+// Time
+uint64_t Sim_Now(void);
+void Sim_Awake(uint32_t us);
+void Sim_Stall(uint32_t us);
+void Sim_Stop2(void);
+
+// Mock call bracket, Sim_Leave() delivers the pending interrupts
+void Sim_Enter(void);
+void Sim_Leave(void);
+
+// Interrupts
+void Sim_EnableIrqn(IRQn_Type irq, bool enable);
+void Sim_SuspendTick(bool suspend);
+
+// Supply current, from the MCU, the LED and the radio
+void Sim_LoadChanged(void);
+void Sim_Record(bool on);
+void Sim_RecordEvent(SimEventType type, uint8_t opcode, const uint8_t *data, uint16_t size, uint32_t value);
+void Sim_RecordTx(const SimTx *tx);
+
+// Boots, of Firmware_Main() (main.c) or a test entry
+int Firmware_Main(void);
+SimBootResult Sim_Boot(int (*entry)(void), uint64_t endUs, bool powerOn, bool brownout);
+__NO_RETURN void Sim_Reset(void);
+
+// Radio model, subghz_mock.c
+void SimRadio_Reset(void);
+uint64_t SimRadio_NextEventUs(void);
+void SimRadio_Update(uint64_t now);
+uint32_t SimRadio_CurrentUa(void);
+bool SimRadio_IrqPending(void);
+
+// Flash model, hal_mock.c
+void SimFlash_FailNextErase(void);
+bool SimFlash_IrqPending(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SIM_H */
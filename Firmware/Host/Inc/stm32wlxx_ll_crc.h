@@ -0,0 +1,116 @@
+/**
+  ******************************************************************************
+  * @file           : stm32wlxx_ll_crc.h
+  * @brief          : Host stand-in for the LL CRC driver, found before the HAL one.
+  ******************************************************************************
+  * The CRC unit is computed in software (Sim_CrcFeed()) on the registers of
+  * the simulated CRC peripheral, so these functions and HAL_CRC_Calculate()
+  * in hal_mock.c share one state, like they do on the chip. Same include
+  * guard as the HAL header, so only one of them is ever seen.
+  */
+
+#ifndef STM32WLxx_LL_CRC_H
+#define STM32WLxx_LL_CRC_H
+
+#include "stm32wlxx.h"
+
+#define LL_CRC_POLYLENGTH_32B              0x00000000U
+#define LL_CRC_POLYLENGTH_16B              CRC_CR_POLYSIZE_0
+#define LL_CRC_POLYLENGTH_8B               CRC_CR_POLYSIZE_1
+#define LL_CRC_POLYLENGTH_7B               (CRC_CR_POLYSIZE_1 | CRC_CR_POLYSIZE_0)
+
+#define LL_CRC_INDATA_REVERSE_NONE         0x00000000U
+#define LL_CRC_INDATA_REVERSE_BYTE         CRC_CR_REV_IN_0
+#define LL_CRC_INDATA_REVERSE_HALFWORD     CRC_CR_REV_IN_1
+#define LL_CRC_INDATA_REVERSE_WORD         (CRC_CR_REV_IN_1 | CRC_CR_REV_IN_0)
+
+#define LL_CRC_OUTDATA_REVERSE_NONE        0x00000000U
+#define LL_CRC_OUTDATA_REVERSE_BIT         CRC_CR_REV_OUT
+
+#define LL_CRC_DEFAULT_CRC32_POLY          0x04C11DB7U
+#define LL_CRC_DEFAULT_CRC_INITVALUE       0xFFFFFFFFU
+
+// sim.c, clocks bits of InData (MSB first) through CRCx
+void Sim_CrcFeed(CRC_TypeDef *CRCx, uint32_t InData, uint8_t bits);
+
+__STATIC_INLINE void LL_CRC_ResetCRCCalculationUnit(CRC_TypeDef *CRCx) {
+    CRCx->DR = CRCx->INIT;
+}
+
+__STATIC_INLINE void LL_CRC_SetPolynomialSize(CRC_TypeDef *CRCx, uint32_t PolySize) {
+    MODIFY_REG(CRCx->CR, CRC_CR_POLYSIZE, PolySize);
+}
+
+__STATIC_INLINE uint32_t LL_CRC_GetPolynomialSize(CRC_TypeDef *CRCx) {
+    return READ_BIT(CRCx->CR, CRC_CR_POLYSIZE);
+}
+
+__STATIC_INLINE void LL_CRC_SetInputDataReverseMode(CRC_TypeDef *CRCx, uint32_t ReverseMode) {
+    MODIFY_REG(CRCx->CR, CRC_CR_REV_IN, ReverseMode);
+}
+
+__STATIC_INLINE uint32_t LL_CRC_GetInputDataReverseMode(CRC_TypeDef *CRCx) {
+    return READ_BIT(CRCx->CR, CRC_CR_REV_IN);
+}
+
+__STATIC_INLINE void LL_CRC_SetOutputDataReverseMode(CRC_TypeDef *CRCx, uint32_t ReverseMode) {
+    MODIFY_REG(CRCx->CR, CRC_CR_REV_OUT, ReverseMode);
+}
+
+__STATIC_INLINE uint32_t LL_CRC_GetOutputDataReverseMode(CRC_TypeDef *CRCx) {
+    return READ_BIT(CRCx->CR, CRC_CR_REV_OUT);
+}
+
+__STATIC_INLINE void LL_CRC_SetInitialData(CRC_TypeDef *CRCx, uint32_t InitCrc) {
+    WRITE_REG(CRCx->INIT, InitCrc);
+}
+
+__STATIC_INLINE uint32_t LL_CRC_GetInitialData(CRC_TypeDef *CRCx) {
+    return READ_REG(CRCx->INIT);
+}
+
+__STATIC_INLINE void LL_CRC_SetPolynomialCoef(CRC_TypeDef *CRCx, uint32_t PolynomCoef) {
+    WRITE_REG(CRCx->POL, PolynomCoef);
+}
+
+__STATIC_INLINE uint32_t LL_CRC_GetPolynomialCoef(CRC_TypeDef *CRCx) {
+    return READ_REG(CRCx->POL);
+}
+
+__STATIC_INLINE void LL_CRC_FeedData32(CRC_TypeDef *CRCx, uint32_t InData) {
+    Sim_CrcFeed(CRCx, InData, 32);
+}
+
+__STATIC_INLINE void LL_CRC_FeedData16(CRC_TypeDef *CRCx, uint16_t InData) {
+    Sim_CrcFeed(CRCx, InData, 16);
+}
+
+__STATIC_INLINE void LL_CRC_FeedData8(CRC_TypeDef *CRCx, uint8_t InData) {
+    Sim_CrcFeed(CRCx, InData, 8);
+}
+
+__STATIC_INLINE uint32_t LL_CRC_ReadData32(CRC_TypeDef *CRCx) {
+    return READ_REG(CRCx->DR);
+}
+
+__STATIC_INLINE uint16_t LL_CRC_ReadData16(CRC_TypeDef *CRCx) {
+    return (uint16_t) READ_REG(CRCx->DR);
+}
+
+__STATIC_INLINE uint8_t LL_CRC_ReadData8(CRC_TypeDef *CRCx) {
+    return (uint8_t) READ_REG(CRCx->DR);
+}
+
+__STATIC_INLINE uint8_t LL_CRC_ReadData7(CRC_TypeDef *CRCx) {
+    return (uint8_t) (READ_REG(CRCx->DR) & 0x7FU);
+}
+
+__STATIC_INLINE uint32_t LL_CRC_Read_IDR(CRC_TypeDef *CRCx) {
+    return READ_REG(CRCx->IDR);
+}
+
+__STATIC_INLINE void LL_CRC_Write_IDR(CRC_TypeDef *CRCx, uint32_t InData) {
+    WRITE_REG(CRCx->IDR, InData);
+}
+
+#endif /* STM32WLxx_LL_CRC_H */
@@ -0,0 +1,78 @@
+/**
+  ******************************************************************************
+  * @file           : beacon_host.c
+  * @brief          : The firmware as the power simulation of Tools/beacon_sim.py.
+  ******************************************************************************
+  * Runs main() for the given virtual time and leaves the battery to the
+  * simulator, one line per event on stdout:
+  *
+  *   PERIOD <ms>              BEACON_PERIOD of the build, first
+  *   I <us> <uA>              supply current changed, answered with 1, or
+  *                            with 0 if the supply drops below the
+  *                            brownout level under it
+  *   V <us>                   ADC conversion, answered with the supply in mV
+  *   TX <us> <dur_us> <dBm>   a transmission ended, us is its start
+  *   BOOT <us> <power-on|brownout>
+  *   END <us>
+  *
+  * A brownout resets the chip, the .noinit section survives it. The
+  * beacon settings are those of beacon_config.h, the simulator builds a
+  * copy of this for each set of them (BEACON_CONFIG_OVERRIDE).
+  */
+
+#include "sim.h"
+#include "beacon_config.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Answer of the simulator to the last line
+static long BeaconHost_Reply(void) {
+    char line[32];
+    fflush(stdout);
+    if (fgets(line, sizeof(line), stdin) == NULL) {
+        exit(EXIT_FAILURE);
+    }
+    return strtol(line, NULL, 10);
+}
+
+static void BeaconHost_Load(uint64_t us, uint32_t uA) {
+    printf("I %" PRIu64 " %" PRIu32 "\n", us, uA);
+    if (BeaconHost_Reply() == 0) {
+        Sim_Reset();
+    }
+}
+
+static uint32_t BeaconHost_SupplyMv(uint64_t us) {
+    printf("V %" PRIu64 "\n", us);
+    return (uint32_t) BeaconHost_Reply();
+}
+
+static void BeaconHost_Tx(const SimTx *tx) {
+    printf("TX %" PRIu64 " %" PRIu64 " %d\n", tx->startUs, tx->endUs - tx->startUs, tx->dBm);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <seconds>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    uint64_t endUs = strtoull(argv[1], NULL, 10) * 1000000U;
+
+    // The boots are forked children, none may read ahead of the others
+    setvbuf(stdin, NULL, _IONBF, 0);
+    simHooks.load = BeaconHost_Load;
+    simHooks.supplyMv = BeaconHost_SupplyMv;
+    simHooks.tx = BeaconHost_Tx;
+
+    printf("PERIOD %d\n", BEACON_PERIOD);
+
+    // Only the load hook resets the chip
+    SimBootResult result = SIM_BOOT_RESET;
+    for (bool powerOn = true; result == SIM_BOOT_RESET; powerOn = false) {
+        printf("BOOT %" PRIu64 " %s\n", Sim_Now(), powerOn ? "power-on" : "brownout");
+        result = Sim_Boot(Firmware_Main, endUs, powerOn, !powerOn);
+    }
+    printf("END %" PRIu64 "\n", Sim_Now());
+    return result == SIM_BOOT_END ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,381 @@
+/**
+  ******************************************************************************
+  * @file           : hal_mock.c
+  * @brief          : Host stand-ins for the HAL functions the firmware calls.
+  ******************************************************************************
+  * Each function costs virtual time and does what the firmware relies on:
+  * the tick, GPIO (the LED), Stop2, the ADC (supply from a hook), the CRC
+  * unit, the UART console (output to a hook, input always times out) and
+  * the flash, with the program and erase rules and stalls of the chip.
+  * The SUBGHZ functions are in subghz_mock.c.
+  */
+
+#include "sim.h"
+#include <string.h>
+
+__IO uint32_t uwTick;
+uint32_t uwTickPrio = (1UL << __NVIC_PRIO_BITS);
+HAL_TickFreqTypeDef uwTickFreq = HAL_TICK_FREQ_DEFAULT;
+uint32_t SystemCoreClock = 1000000U;
+
+FLASH_ProcessTypeDef pFlash;
+
+static bool flashIrq;
+static bool flashFailNext;
+
+// --- Tick -------------------------------------------------------------------
+
+HAL_StatusTypeDef HAL_Init(void) {
+    Sim_Enter();
+    Sim_SuspendTick(false);
+    HAL_MspInit();
+    Sim_Awake(SIM_HAL_CALL_US);
+    Sim_Leave();
+    return HAL_OK;
+}
+
+void HAL_IncTick(void) {
+    uwTick += uwTickFreq;
+}
+
+uint32_t HAL_GetTick(void) {
+    Sim_Enter();
+    Sim_Awake(SIM_HAL_CALL_US);
+    Sim_Leave();
+    return uwTick;
+}
+
+// Busy waits like the HAL, a tick at a time
+void HAL_Delay(uint32_t Delay) {
+    Sim_RecordEvent(SIM_EVENT_DELAY, 0, NULL, 0, Delay);
+    uint32_t start = HAL_GetTick();
+    uint32_t wait = Delay;
+    if (wait < HAL_MAX_DELAY) {
+        wait += (uint32_t) uwTickFreq;
+    }
+    while (uwTick - start < wait) {
+        Sim_Enter();
+        Sim_Awake(1000 - (uint32_t) (Sim_Now() % 1000));
+        Sim_Leave();
+    }
+}
+
+void HAL_SuspendTick(void) {
+    Sim_Enter();
+    SysTick->CTRL &= ~SysTick_CTRL_TICKINT_Msk;
+    Sim_SuspendTick(true);
+    Sim_Awake(SIM_HAL_CALL_US);
+    Sim_Leave();
+}
+
+void HAL_ResumeTick(void) {
+    Sim_Enter();
+    SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;
+    Sim_SuspendTick(false);
+    Sim_Awake(SIM_HAL_CALL_US);
+    Sim_Leave();
+}
+
+// --- NVIC, clocks, power ----------------------------------------------------
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority) {
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn) {
+    Sim_Enter();
+    Sim_EnableIrqn(IRQn, true);
+    Sim_Leave();
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn) {
+    Sim_EnableIrqn(IRQn, false);
+}
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct) {
+    Sim_Enter();
+    if (RCC_OscInitStruct->OscillatorType & RCC_OSCILLATORTYPE_HSE) {
+        if (RCC_OscInitStruct->HSEState == RCC_HSE_OFF) {
+            RCC->CR &= ~RCC_CR_HSEON;
+        } else {
+            RCC->CR |= RCC_CR_HSEON;
+        }
+    }
+    Sim_Awake(SIM_HAL_CALL_US);
+    Sim_Leave();
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency) {
+    Sim_Enter();
+    Sim_Awake(SIM_HAL_CALL_US);
+    Sim_Leave();
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RCCEx_PeriphCLKConfig(RCC_PeriphCLKInitTypeDef *PeriphClkInit) {
+    return HAL_OK;
+}
+
+uint32_t HAL_RCC_GetSysClockFreq(void) {
+    return SystemCoreClock;
+}
+
+void HAL_PWREx_EnterSTOP2Mode(uint8_t STOPEntry) {
+    Sim_Enter();
+    Sim_Stop2();
+    Sim_Leave();
+}
+
+// --- GPIO -------------------------------------------------------------------
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init) {
+}
+
+void HAL_GPIO_DeInit(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pin) {
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState) {
+    Sim_Enter();
+    if (PinState == GPIO_PIN_RESET) {
+        GPIOx->ODR &= ~GPIO_Pin;
+    } else {
+        GPIOx->ODR |= GPIO_Pin;
+    }
+    if (GPIOx == LED_GPIO_Port && (GPIO_Pin & LED_Pin)) {
+        Sim_RecordEvent(SIM_EVENT_LED, 0, NULL, 0, PinState != GPIO_PIN_RESET);
+        Sim_LoadChanged();
+    }
+    Sim_Awake(SIM_HAL_CALL_US);
+    Sim_Leave();
+}
+
+// --- UART console -----------------------------------------------------------
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart) {
+    huart->gState = HAL_UART_STATE_READY;
+    huart->RxState = HAL_UART_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout) {
+    Sim_Enter();
+    if (simHooks.console) {
+        simHooks.console(pData, Size);
+    }
+    Sim_Awake(Size * SIM_UART_CHAR_US);
+    Sim_Leave();
+    return HAL_OK;
+}
+
+// Nobody types on the simulated console
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout) {
+    Sim_Enter();
+    Sim_Awake(Timeout * 1000);
+    Sim_Leave();
+    return HAL_TIMEOUT;
+}
+
+HAL_StatusTypeDef HAL_UARTEx_SetTxFifoThreshold(UART_HandleTypeDef *huart, uint32_t Threshold) {
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UARTEx_SetRxFifoThreshold(UART_HandleTypeDef *huart, uint32_t Threshold) {
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UARTEx_DisableFifoMode(UART_HandleTypeDef *huart) {
+    return HAL_OK;
+}
+
+// --- ADC --------------------------------------------------------------------
+
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc) {
+    HAL_ADC_MspInit(hadc);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef *hadc) {
+    Sim_Enter();
+    Sim_Awake(100);
+    Sim_Leave();
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, ADC_ChannelConfTypeDef *pConfig) {
+    return pConfig->Channel == ADC_CHANNEL_VREFINT ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc) {
+    return HAL_OK;
+}
+
+// VREFINT converted against the supply of the hook
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Timeout) {
+    Sim_Enter();
+    Sim_Awake(SIM_ADC_CONVERSION_US);
+    uint32_t mv = simHooks.supplyMv ? simHooks.supplyMv(Sim_Now()) : 3000;
+    uint32_t raw = mv ? (VREFINT_CAL_VREF * (uint32_t) *VREFINT_CAL_ADDR + mv / 2) / mv : 0xFFF;
+    hadc->Instance->DR = raw > 0xFFF ? 0xFFF : raw;
+    Sim_Leave();
+    return HAL_OK;
+}
+
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc) {
+    return hadc->Instance->DR;
+}
+
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef *hadc) {
+    return HAL_OK;
+}
+
+// --- CRC --------------------------------------------------------------------
+
+// The defaults and the bit orders of the firmware, reversal is not modelled
+HAL_StatusTypeDef HAL_CRC_Init(CRC_HandleTypeDef *hcrc) {
+    if (hcrc->Init.InputDataInversionMode != CRC_INPUTDATA_INVERSION_NONE ||
+        hcrc->Init.OutputDataInversionMode != CRC_OUTPUTDATA_INVERSION_DISABLE) {
+        return HAL_ERROR;
+    }
+    HAL_CRC_MspInit(hcrc);
+    if (hcrc->Init.DefaultPolynomialUse == DEFAULT_POLYNOMIAL_ENABLE) {
+        hcrc->Instance->POL = DEFAULT_CRC32_POLY;
+        MODIFY_REG(hcrc->Instance->CR, CRC_CR_POLYSIZE, CRC_POLYLENGTH_32B);
+    } else {
+        hcrc->Instance->POL = hcrc->Init.GeneratingPolynomial;
+        MODIFY_REG(hcrc->Instance->CR, CRC_CR_POLYSIZE, hcrc->Init.CRCLength);
+    }
+    hcrc->Instance->INIT = hcrc->Init.DefaultInitValueUse == DEFAULT_INIT_VALUE_ENABLE ? DEFAULT_CRC_INITVALUE
+                                                                                       : hcrc->Init.InitValue;
+    hcrc->State = HAL_CRC_STATE_READY;
+    return HAL_OK;
+}
+
+uint32_t HAL_CRC_Calculate(CRC_HandleTypeDef *hcrc, uint32_t pBuffer[], uint32_t BufferLength) {
+    hcrc->Instance->DR = hcrc->Instance->INIT;
+    for (uint32_t i = 0; i < BufferLength; i++) {
+        if (hcrc->InputDataFormat == CRC_INPUTDATA_FORMAT_BYTES) {
+            Sim_CrcFeed(hcrc->Instance, ((const uint8_t *) pBuffer)[i], 8);
+        } else if (hcrc->InputDataFormat == CRC_INPUTDATA_FORMAT_HALFWORDS) {
+            Sim_CrcFeed(hcrc->Instance, ((const uint16_t *) pBuffer)[i], 16);
+        } else {
+            Sim_CrcFeed(hcrc->Instance, pBuffer[i], 32);
+        }
+    }
+    return hcrc->Instance->DR;
+}
+
+// --- Flash ------------------------------------------------------------------
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void) {
+    FLASH->CR &= ~FLASH_CR_LOCK;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void) {
+    FLASH->CR |= FLASH_CR_LOCK;
+    return HAL_OK;
+}
+
+// A doubleword can only be programmed once after an erase, or to zero
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data) {
+    if ((FLASH->CR & FLASH_CR_LOCK) || TypeProgram != FLASH_TYPEPROGRAM_DOUBLEWORD || (Address & 7U) != 0 ||
+        Address < FLASH_BASE || Address >= FLASH_BASE + FLASH_SIZE) {
+        return HAL_ERROR;
+    }
+    Sim_Enter();
+    Sim_Stall(SIM_FLASH_PROGRAM_US);
+    uint64_t *target = (uint64_t *) (uintptr_t) Address;
+    HAL_StatusTypeDef status = HAL_OK;
+    if (*target == UINT64_MAX || Data == 0) {
+        *target = Data;
+    } else {
+        FLASH->SR |= FLASH_SR_PROGERR;
+        pFlash.ErrorCode |= HAL_FLASH_ERROR_PROG;
+        status = HAL_ERROR;
+    }
+    Sim_Leave();
+    return status;
+}
+
+// Erases one page, or reports the injected failure
+static bool SimFlash_ErasePage(uint32_t page) {
+    Sim_Stall(SIM_FLASH_ERASE_US);
+    if (flashFailNext) {
+        flashFailNext = false;
+        FLASH->SR |= FLASH_SR_PGSERR;
+        return false;
+    }
+    memset((void *) (uintptr_t) (FLASH_BASE + page * FLASH_PAGE_SIZE), 0xFF, FLASH_PAGE_SIZE);
+    return true;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *PageError) {
+    if (FLASH->CR & FLASH_CR_LOCK) {
+        return HAL_ERROR;
+    }
+    Sim_Enter();
+    HAL_StatusTypeDef status = HAL_OK;
+    *PageError = 0xFFFFFFFFU;
+    for (uint32_t page = pEraseInit->Page; page < pEraseInit->Page + pEraseInit->NbPages; page++) {
+        if (!SimFlash_ErasePage(page)) {
+            *PageError = page;
+            status = HAL_ERROR;
+            break;
+        }
+    }
+    Sim_Leave();
+    return status;
+}
+
+// The core stalls for the first page here, the others follow from the IRQ
+HAL_StatusTypeDef HAL_FLASHEx_Erase_IT(FLASH_EraseInitTypeDef *pEraseInit) {
+    if (FLASH->CR & FLASH_CR_LOCK) {
+        return HAL_ERROR;
+    }
+    Sim_Enter();
+    pFlash.ErrorCode = HAL_FLASH_ERROR_NONE;
+    pFlash.ProcedureOnGoing = FLASH_TYPEERASE_PAGES;
+    pFlash.Page = pEraseInit->Page;
+    pFlash.NbPagesToErase = pEraseInit->NbPages;
+    if (SimFlash_ErasePage(pFlash.Page)) {
+        FLASH->SR |= FLASH_SR_EOP;
+    }
+    flashIrq = true;
+    Sim_Leave();
+    return HAL_OK;
+}
+
+void HAL_FLASH_IRQHandler(void) {
+    Sim_Enter();
+    flashIrq = false;
+    uint32_t error = FLASH->SR & FLASH_FLAG_SR_ERRORS;
+    if (error != 0U) {
+        pFlash.ErrorCode |= error;
+        FLASH->SR &= ~error;
+        pFlash.ProcedureOnGoing = FLASH_TYPENONE;
+        HAL_FLASH_OperationErrorCallback(pFlash.Page);
+    }
+    if (FLASH->SR & FLASH_SR_EOP) {
+        FLASH->SR &= ~FLASH_SR_EOP;
+        uint32_t page = pFlash.Page;
+        if (--pFlash.NbPagesToErase != 0U) {
+            pFlash.Page++;
+            if (SimFlash_ErasePage(pFlash.Page)) {
+                FLASH->SR |= FLASH_SR_EOP;
+            }
+            flashIrq = true;
+        } else {
+            pFlash.ProcedureOnGoing = FLASH_TYPENONE;
+        }
+        HAL_FLASH_EndOfOperationCallback(page);
+    }
+    Sim_Leave();
+}
+
+void SimFlash_FailNextErase(void) {
+    flashFailNext = true;
+}
+
+bool SimFlash_IrqPending(void) {
+    return flashIrq;
+}
@@ -0,0 +1,559 @@
+/**
+  ******************************************************************************
+  * @file           : sim.c
+  * @brief          : Virtual time, interrupts and event recorder of the host build.
+  ******************************************************************************
+  * The address ranges of the flash, the system memory and the peripherals
+  * are mapped at their addresses on the chip before main() runs, so the
+  * device header's register pointers work as they are. The flash is a
+  * shared mapping that keeps its content across the boots run by
+  * Sim_Boot(), each of which is a forked child of the driver.
+  *
+  * Time only advances in the mocks. The core is awake (cycle counter
+  * running), stalled on flash (cycle counter running, interrupts held) or
+  * waiting in WFI or Stop2 until the next event that raises an enabled
+  * interrupt. Interrupts are delivered at the end of the outermost mock
+  * call, one SysTick per millisecond crossed, except that a flash stall
+  * leaves at most one tick pending like the real NVIC does.
+  */
+
+#include "sim.h"
+#include "stm32wlxx_it.h"
+#include "energy.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern uint8_t __noinit_start[];
+extern uint8_t __noinit_end[];
+
+#define SIM_NEVER UINT64_MAX
+
+typedef enum {
+    SIM_AWAKE,
+    SIM_STALL,
+    SIM_SLEEP,
+    SIM_STOP2,
+} SimMode;
+
+typedef void (*SimHandler)(void);
+
+typedef struct {
+    TIM_TypeDef *tim;
+    IRQn_Type irq;
+    SimHandler handler;
+    bool running;
+    uint64_t periodStartUs;
+    bool capturing;       // input 1 on the LSI
+    uint64_t captureEdge; // of the LSI, counted in prescaled edges since the power-on
+} SimTimer;
+
+static const struct {
+    uintptr_t base;
+    size_t size;
+    bool shared;
+} simRegions[] = {
+    {FLASH_BASE, 0x40000, true},
+    {SYSTEM_FLASH_BASE, 0x10000, false},
+    {PERIPH_BASE, 0x30000, false},       // APB1, APB2, AHB1
+    {AHB2PERIPH_BASE, 0x2000, false},    // GPIO
+    {AHB3PERIPH_BASE, 0x20000, false},   // RCC, PWR, EXTI, FLASH, SUBGHZSPI
+    {0xE0000000UL, 0x100000, false},     // core peripherals
+};
+
+SimHooks simHooks;
+SimShared *simShared;
+uint32_t simLsiHz = 32000;
+
+SimEvent *simEvents;
+uint32_t simEventCount;
+SimTx *simTxs;
+uint32_t simTxCount;
+static uint32_t simEventCapacity;
+static uint32_t simTxCapacity;
+static bool recording;
+
+static uint64_t awakeUs;
+static bool tickRunning;
+static bool tickSuspended;
+static uint32_t pendingTicks;
+static bool irqEnabled[SUBGHZ_Radio_IRQn + 1];
+static uint32_t primask;
+static bool inIrq;
+static uint32_t depth;
+static bool mcuStopped;
+static uint32_t lastLoadUa = UINT32_MAX;
+static bool forked;
+
+static bool lptimRunning;
+static uint64_t lptimStartUs;
+
+static SimTimer timers[] = {
+    {TIM16, TIM16_IRQn, TIM16_IRQHandler},
+    {TIM17, TIM17_IRQn, TIM17_IRQHandler},
+};
+
+static void Sim_ResetRegisters(void) {
+    for (uint8_t i = 0; i < sizeof(simRegions) / sizeof(simRegions[0]); i++) {
+        if (!simRegions[i].shared) {
+            memset((void *) simRegions[i].base, 0, simRegions[i].size);
+        }
+    }
+    RCC->CR = RCC_CR_MSION | RCC_CR_MSIRDY | RCC_CR_HSIRDY | RCC_CR_HSERDY;
+    RCC->CSR = RCC_CSR_LSIRDY;
+    LPTIM1->ISR = LPTIM_ISR_ARROK;
+    CRC->DR = 0xFFFFFFFFU;
+    CRC->INIT = 0xFFFFFFFFU;
+    CRC->POL = 0x04C11DB7U;
+    FLASH->CR = FLASH_CR_LOCK;
+    *(uint16_t *) VREFINT_CAL_ADDR = 1664; // 1.212 V at 3.3 V
+    *(uint32_t *) FLASHSIZE_BASE = 256;    // KB
+}
+
+__attribute__((constructor)) static void Sim_Map(void) {
+    for (uint8_t i = 0; i < sizeof(simRegions) / sizeof(simRegions[0]); i++) {
+        int flags = MAP_FIXED | MAP_ANONYMOUS | (simRegions[i].shared ? MAP_SHARED : MAP_PRIVATE);
+        void *p = mmap((void *) simRegions[i].base, simRegions[i].size, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (p != (void *) simRegions[i].base) {
+            fprintf(stderr, "sim: cannot map %08lx\n", (unsigned long) simRegions[i].base);
+            exit(1);
+        }
+    }
+    memset((void *) FLASH_BASE, 0xFF, simRegions[0].size);
+
+    simShared = mmap(NULL, sizeof(SimShared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (simShared == MAP_FAILED) {
+        exit(1);
+    }
+    memset(simShared, 0, sizeof(SimShared));
+    simShared->endUs = SIM_NEVER;
+
+    Sim_ResetRegisters();
+    SimRadio_Reset();
+}
+
+uint64_t Sim_Now(void) {
+    return simShared->nowUs;
+}
+
+static __NO_RETURN void Sim_Exit(SimBootResult result) {
+    fflush(NULL);
+    if (forked) {
+        _exit(result);
+    }
+    if (result == SIM_BOOT_END) {
+        exit(0);
+    }
+    abort();
+}
+
+// --- Interrupts -------------------------------------------------------------
+
+void Sim_EnableIrqn(IRQn_Type irq, bool enable) {
+    if (irq >= 0 && irq <= SUBGHZ_Radio_IRQn) {
+        irqEnabled[irq] = enable;
+    }
+}
+
+void Sim_SuspendTick(bool suspend) {
+    tickSuspended = suspend;
+    if (!suspend) {
+        tickRunning = true;
+    }
+}
+
+static bool Sim_TimerPending(const SimTimer *t) {
+    return (t->tim->SR & TIM_SR_UIF) && (t->tim->DIER & TIM_DIER_UIE) && irqEnabled[t->irq];
+}
+
+// The interrupt to run next, in the order of the NVIC positions
+static SimHandler Sim_NextHandler(void) {
+    if (SimRadio_IrqPending() && irqEnabled[SUBGHZ_Radio_IRQn]) {
+        return SUBGHZ_Radio_IRQHandler;
+    }
+    for (uint8_t i = 0; i < sizeof(timers) / sizeof(timers[0]); i++) {
+        if (Sim_TimerPending(&timers[i])) {
+            return timers[i].handler;
+        }
+    }
+    if ((LPTIM1->ISR & LPTIM_ISR_ARRM) && (LPTIM1->IER & LPTIM_IER_ARRMIE) && irqEnabled[LPTIM1_IRQn]) {
+        return LPTIM1_IRQHandler;
+    }
+    if (SimFlash_IrqPending() && irqEnabled[FLASH_IRQn]) {
+        return FLASH_IRQHandler;
+    }
+    if (pendingTicks > 0) {
+        return SysTick_Handler;
+    }
+    return NULL;
+}
+
+static uint64_t Sim_TimerPeriodUs(const SimTimer *t) {
+    return (uint64_t) (t->tim->PSC + 1) * (t->tim->ARR + 1);
+}
+
+// Input capture of TIM16 channel 1 with TI1 on the LSI, the only one the
+// firmware uses: CCR1 takes the counter at the last prescaled LSI edge
+static void Sim_TimerCapture(SimTimer *t, uint64_t now) {
+    TIM_TypeDef *tim = t->tim;
+    if (tim != TIM16 || !t->running || (tim->OR1 & TIM16_OR1_TI1_RMP) != TIM16_OR1_TI1_RMP_0 ||
+        (tim->CCMR1 & TIM_CCMR1_CC1S) != TIM_CCMR1_CC1S_0 || !(tim->CCER & TIM_CCER_CC1E)) {
+        t->capturing = false;
+        return;
+    }
+    uint64_t perEdge = 1U << ((tim->CCMR1 & TIM_CCMR1_IC1PSC) >> TIM_CCMR1_IC1PSC_Pos);
+    uint64_t edge = now * simLsiHz / (perEdge * 1000000U);
+    if (!t->capturing) {
+        t->capturing = true;
+        t->captureEdge = edge;
+        return;
+    }
+    if (edge == t->captureEdge) {
+        return;
+    }
+    if ((tim->SR & TIM_SR_CC1IF) || edge > t->captureEdge + 1) {
+        tim->SR |= TIM_SR_CC1OF;
+    }
+    t->captureEdge = edge;
+    int64_t period = (int64_t) Sim_TimerPeriodUs(t);
+    int64_t since = (int64_t) (edge * perEdge * 1000000U / simLsiHz) - (int64_t) t->periodStartUs;
+    tim->CCR1 = (uint32_t) ((((since % period) + period) % period) / (tim->PSC + 1));
+    tim->SR |= TIM_SR_CC1IF;
+}
+
+// Registers the firmware writes directly, looked at on every mock call
+static void Sim_Sync(void) {
+    uint64_t now = Sim_Now();
+
+    if (LPTIM1->ICR) {
+        LPTIM1->ISR &= ~LPTIM1->ICR;
+        LPTIM1->ICR = 0;
+    }
+    // ARR writes cross into the LSI domain instantly here
+    LPTIM1->ISR |= LPTIM_ISR_ARROK;
+    if (!(LPTIM1->CR & LPTIM_CR_ENABLE)) {
+        lptimRunning = false;
+        LPTIM1->CNT = 0;
+    } else if (LPTIM1->CR & LPTIM_CR_SNGSTRT) {
+        LPTIM1->CR &= ~LPTIM_CR_SNGSTRT;
+        lptimRunning = true;
+        lptimStartUs = now;
+    }
+    if (lptimRunning) {
+        uint32_t cnt = (uint32_t) ((now - lptimStartUs) * simLsiHz / 32000000U);
+        LPTIM1->CNT = cnt < LPTIM1->ARR ? cnt : LPTIM1->ARR;
+    }
+
+    for (uint8_t i = 0; i < sizeof(timers) / sizeof(timers[0]); i++) {
+        SimTimer *t = &timers[i];
+        if (!(t->tim->CR1 & TIM_CR1_CEN)) {
+            t->running = false;
+        } else if (!t->running) {
+            t->running = true;
+            t->periodStartUs = now - t->tim->CNT * (t->tim->PSC + 1);
+        }
+        Sim_TimerCapture(t, now);
+    }
+}
+
+static void Sim_Dispatch(void) {
+    SimHandler handler;
+    while (!inIrq && primask == 0 && (handler = Sim_NextHandler()) != NULL) {
+        if (handler == SysTick_Handler) {
+            pendingTicks--;
+        }
+        inIrq = true;
+        handler();
+        inIrq = false;
+        Sim_Sync();
+    }
+}
+
+void Sim_Enter(void) {
+    if (depth++ == 0) {
+        Sim_Sync();
+    }
+}
+
+void Sim_Leave(void) {
+    if (--depth == 0) {
+        Sim_Sync();
+        Sim_Dispatch();
+    }
+}
+
+void Sim_DisableIrq(void) {
+    primask = 1;
+}
+
+void Sim_EnableIrq(void) {
+    primask = 0;
+    Sim_Enter();
+    Sim_Leave();
+}
+
+uint32_t Sim_GetPrimask(void) {
+    return primask;
+}
+
+void Sim_SetPrimask(uint32_t value) {
+    if (value) {
+        Sim_DisableIrq();
+    } else {
+        Sim_EnableIrq();
+    }
+}
+
+// --- Time -------------------------------------------------------------------
+
+static void Sim_AdvanceTo(uint64_t target, SimMode mode) {
+    while (1) {
+        uint64_t now = Sim_Now();
+        uint64_t next = target;
+        uint64_t tick = SIM_NEVER;
+        if (tickRunning && !tickSuspended && mode != SIM_STOP2) {
+            tick = (now / 1000 + 1) * 1000;
+            next = tick < next ? tick : next;
+        }
+        uint64_t lptim = SIM_NEVER;
+        if (lptimRunning) {
+            // LSI / 32
+            lptim = lptimStartUs + ((uint64_t) (LPTIM1->ARR + 1) * 32000000U + simLsiHz - 1) / simLsiHz;
+            next = lptim < next ? lptim : next;
+        }
+        for (uint8_t i = 0; i < sizeof(timers) / sizeof(timers[0]); i++) {
+            if (timers[i].running && mode != SIM_STOP2) {
+                uint64_t t = timers[i].periodStartUs + Sim_TimerPeriodUs(&timers[i]);
+                next = t < next ? t : next;
+            }
+        }
+        uint64_t radio = SimRadio_NextEventUs();
+        next = radio < next ? radio : next;
+        if (next == SIM_NEVER) {
+            fprintf(stderr, "sim: the core sleeps with nothing to wake it up\n");
+            Sim_Exit(SIM_BOOT_ERROR);
+        }
+        if (next > simShared->endUs) {
+            next = simShared->endUs;
+        }
+        if (next < now) {
+            next = now;
+        }
+
+        if (mode == SIM_AWAKE || mode == SIM_STALL) {
+            awakeUs += next - now;
+            DWT->CYCCNT = (uint32_t) awakeUs;
+        }
+        simShared->nowUs = next;
+        if (next >= simShared->endUs) {
+            Sim_Exit(SIM_BOOT_END);
+        }
+
+        if (next == tick) {
+            if (mode != SIM_STALL || pendingTicks == 0) {
+                pendingTicks++;
+            }
+        }
+        if (next == lptim) {
+            lptimRunning = false;
+            LPTIM1->CNT = LPTIM1->ARR;
+            LPTIM1->ISR |= LPTIM_ISR_ARRM;
+        }
+        for (uint8_t i = 0; i < sizeof(timers) / sizeof(timers[0]); i++) {
+            SimTimer *t = &timers[i];
+            if (t->running && mode != SIM_STOP2 && next == t->periodStartUs + Sim_TimerPeriodUs(t)) {
+                t->periodStartUs = next;
+                t->tim->SR |= TIM_SR_UIF;
+            }
+        }
+        if (next == radio) {
+            SimRadio_Update(next);
+        }
+
+        if (next >= target) {
+            return;
+        }
+        if ((mode == SIM_SLEEP || mode == SIM_STOP2) && Sim_NextHandler() != NULL) {
+            return;
+        }
+    }
+}
+
+// The core runs for us microseconds
+void Sim_Awake(uint32_t us) {
+    Sim_AdvanceTo(Sim_Now() + us, SIM_AWAKE);
+}
+
+// The core is stalled on the flash for us microseconds
+void Sim_Stall(uint32_t us) {
+    Sim_AdvanceTo(Sim_Now() + us, SIM_STALL);
+}
+
+void Sim_Wfi(void) {
+    Sim_Enter();
+    if (Sim_NextHandler() == NULL) {
+        Sim_AdvanceTo(SIM_NEVER, SIM_SLEEP);
+    }
+    Sim_Leave();
+}
+
+// Until LPTIM1, the radio or an EXTI line wakes the core up
+void Sim_Stop2(void) {
+    uint64_t start = Sim_Now();
+    mcuStopped = true;
+    Sim_LoadChanged();
+    if (Sim_NextHandler() == NULL) {
+        Sim_AdvanceTo(SIM_NEVER, SIM_STOP2);
+    }
+    mcuStopped = false;
+    Sim_LoadChanged();
+    Sim_RecordEvent(SIM_EVENT_STOP, 0, NULL, 0, (uint32_t) (Sim_Now() - start));
+}
+
+// --- Supply current and recording -------------------------------------------
+
+void Sim_LoadChanged(void) {
+    uint32_t uA = mcuStopped ? energyCurrents.cpuStop : energyCurrents.cpuRun;
+    if (GPIOA->ODR & LED_Pin) {
+        uA += energyCurrents.led;
+    }
+    uA += SimRadio_CurrentUa();
+    if (uA != lastLoadUa) {
+        lastLoadUa = uA;
+        if (simHooks.load) {
+            simHooks.load(Sim_Now(), uA);
+        }
+    }
+}
+
+void Sim_Record(bool on) {
+    recording = on;
+}
+
+void Sim_RecordEvent(SimEventType type, uint8_t opcode, const uint8_t *data, uint16_t size, uint32_t value) {
+    if (type == SIM_EVENT_CMD) {
+        simShared->cmdCount++;
+    }
+    if (!recording) {
+        return;
+    }
+    if (simEventCount == simEventCapacity) {
+        simEventCapacity = simEventCapacity ? simEventCapacity * 2 : 1024;
+        simEvents = realloc(simEvents, simEventCapacity * sizeof(SimEvent));
+    }
+    SimEvent *e = &simEvents[simEventCount++];
+    memset(e, 0, sizeof(*e));
+    e->us = Sim_Now();
+    e->type = type;
+    e->opcode = opcode;
+    e->size = size;
+    if (data) {
+        memcpy(e->data, data, size < SIM_EVENT_DATA ? size : SIM_EVENT_DATA);
+    }
+    e->value = value;
+}
+
+void Sim_RecordTx(const SimTx *tx) {
+    simShared->txCount++;
+    if (simHooks.tx) {
+        simHooks.tx(tx);
+    }
+    if (!recording) {
+        return;
+    }
+    if (simTxCount == simTxCapacity) {
+        simTxCapacity = simTxCapacity ? simTxCapacity * 2 : 64;
+        simTxs = realloc(simTxs, simTxCapacity * sizeof(SimTx));
+    }
+    simTxs[simTxCount++] = *tx;
+}
+
+// --- CRC unit ---------------------------------------------------------------
+
+// Non-reflected CRC of the polynomial size in CR, MSB first, like the unit
+// with no bit reversal
+void Sim_CrcFeed(CRC_TypeDef *CRCx, uint32_t InData, uint8_t bits) {
+    static const uint8_t sizes[4] = {32, 16, 8, 7};
+    uint8_t size = sizes[(CRCx->CR & CRC_CR_POLYSIZE) >> CRC_CR_POLYSIZE_Pos];
+    uint32_t mask = size == 32 ? 0xFFFFFFFFU : (1U << size) - 1;
+    uint32_t crc = CRCx->DR & mask;
+    for (int8_t i = bits - 1; i >= 0; i--) {
+        uint32_t top = (crc >> (size - 1)) & 1U;
+        crc = (crc << 1) & mask;
+        if (top ^ ((InData >> i) & 1U)) {
+            crc ^= CRCx->POL & mask;
+        }
+    }
+    CRCx->DR = crc;
+}
+
+// --- Boots ------------------------------------------------------------------
+
+// Runs entry in a child process from a reset until the time reaches endUs,
+// the firmware resets or fails. The flash and simShared carry over.
+SimBootResult Sim_Boot(int (*entry)(void), uint64_t endUs, bool powerOn, bool brownout) {
+    if (powerOn) {
+        simShared->retainedSize = 0;
+    }
+    simShared->endUs = endUs;
+    fflush(NULL);
+    pid_t pid = fork();
+    if (pid < 0) {
+        return SIM_BOOT_ERROR;
+    }
+    if (pid == 0) {
+        forked = true;
+        simShared->boots++;
+        uint32_t size = __noinit_end - __noinit_start;
+        if (simShared->retainedSize == size && size <= sizeof(simShared->retained)) {
+            memcpy(__noinit_start, simShared->retained, size);
+        } else {
+            // SRAM content after a power loss
+            for (uint32_t i = 0; i < size; i++) {
+                __noinit_start[i] = (uint8_t) (i * 37 + simShared->boots);
+            }
+        }
+        if (powerOn) {
+            RCC->CSR |= RCC_CSR_BORRSTF | RCC_CSR_PINRSTF;
+        } else if (brownout) {
+            RCC->CSR |= RCC_CSR_BORRSTF;
+        } else {
+            RCC->CSR |= RCC_CSR_PINRSTF;
+        }
+        Sim_LoadChanged();
+        simShared->nowUs += SIM_RESET_US;
+        entry();
+        Sim_Exit(SIM_BOOT_END);
+    }
+
+    int status;
+    if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status)) {
+        return SIM_BOOT_ERROR;
+    }
+    switch (WEXITSTATUS(status)) {
+    case SIM_BOOT_END:
+        return SIM_BOOT_END;
+    case SIM_BOOT_RESET:
+        return SIM_BOOT_RESET;
+    default:
+        return SIM_BOOT_ERROR;
+    }
+}
+
+// A reset of the chip, e.g. a brownout: the .noinit section survives
+void Sim_Reset(void) {
+    uint32_t size = __noinit_end - __noinit_start;
+    if (size <= sizeof(simShared->retained)) {
+        memcpy(simShared->retained, __noinit_start, size);
+        simShared->retainedSize = size;
+    }
+    Sim_Exit(SIM_BOOT_RESET);
+}
+
+void Error_Handler(void) {
+    fprintf(stderr, "sim: Error_Handler() at %llu us\n", (unsigned long long) Sim_Now());
+    Sim_Exit(SIM_BOOT_ERROR);
+}
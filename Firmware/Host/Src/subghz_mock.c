@@ -0,0 +1,355 @@
+/**
+  ******************************************************************************
+  * @file           : subghz_mock.c
+  * @brief          : Host SUBGHZ HAL with a model of the radio's states and TX.
+  ******************************************************************************
+  * Commands cost the SPI transfer (one byte per 64 us on the 125 kHz bus)
+  * plus the HAL code around it, and the BUSY time of the state changes the
+  * firmware waits for: the wake-up from Sleep and the crystal start-up.
+  *
+  * A transmission starts when SetTx has been clocked in and ends at its
+  * timeout or, for an FSK packet, after its last bit, in the fallback
+  * state and with the TX done or timeout IRQ. The payload is what the
+  * radio reads from its buffer: a byte written during the transmission is
+  * only sent if it was written before the radio got to it.
+  */
+
+#include "sim.h"
+#include "radio.h"
+#include "energy.h"
+#include <string.h>
+
+#define SIM_NEVER UINT64_MAX
+
+typedef enum {
+    SIM_RADIO_SLEEP,
+    SIM_RADIO_RC,
+    SIM_RADIO_XOSC,
+    SIM_RADIO_FS,
+    SIM_RADIO_TX,
+} SimRadioState;
+
+// Configuration, lost in a cold Sleep
+typedef struct {
+    uint8_t packetType;
+    uint32_t rfFreq;
+    uint8_t pa[4];
+    uint8_t txParams[2];
+    uint32_t bitrateWord;
+    uint16_t preambleBits;
+    uint8_t syncBits;
+    bool variableLength;
+    uint8_t length;
+    uint8_t crcType;
+    uint8_t fallback;
+    uint16_t irqMask;
+    uint8_t txBase;
+} SimRadioConfig;
+
+static const SimRadioConfig simRadioDefaults = {
+    .fallback = 0x20,
+};
+
+static struct {
+    SimRadioState state;
+    SimRadioConfig config;
+    uint16_t irqStatus;
+    uint8_t buffer[256];
+    bool txActive;
+    uint64_t txEndUs;     // SIM_NEVER for CW and the endless preamble
+    bool txPacketEnd;     // txEndUs is the end of the last bit
+    SimTx tx;
+} radio;
+
+void SimRadio_Reset(void) {
+    memset(&radio, 0, sizeof(radio));
+    radio.state = SIM_RADIO_SLEEP;
+    radio.config = simRadioDefaults;
+}
+
+// The output power SetOutputPower() would have sent the PA config for
+static int8_t SimRadio_Dbm(void) {
+    const SimRadioConfig *c = &radio.config;
+    for (int8_t dBm = -21; dBm <= 22; dBm++) {
+        if (c->pa[0] == RADIO_PA_DUTY(dBm) && c->pa[1] == RADIO_PA_HPMAX(dBm) && c->pa[2] == RADIO_PA_LP(dBm) &&
+            (int8_t) c->txParams[0] == RADIO_TX_POWER(dBm)) {
+            return dBm;
+        }
+    }
+    return (int8_t) c->txParams[0];
+}
+
+uint32_t SimRadio_CurrentUa(void) {
+    switch (radio.state) {
+    case SIM_RADIO_SLEEP:
+        return energyCurrents.radio[RADIO_SLEEP];
+    case SIM_RADIO_RC:
+        return energyCurrents.radio[RADIO_STDBY_RC];
+    case SIM_RADIO_TX:
+        return Energy_TxCurrent(radio.tx.dBm);
+    default:
+        return energyCurrents.radio[RADIO_STDBY_XOSC];
+    }
+}
+
+static void SimRadio_SetState(SimRadioState state) {
+    radio.state = state;
+    Sim_LoadChanged();
+}
+
+uint64_t SimRadio_NextEventUs(void) {
+    return radio.txActive ? radio.txEndUs : SIM_NEVER;
+}
+
+bool SimRadio_IrqPending(void) {
+    return (radio.irqStatus & radio.config.irqMask) != 0;
+}
+
+static uint32_t SimRadio_BitNs(void) {
+    // BR = 32 * 32 MHz / bitrate, so a bit is BR / 1024 us
+    return (uint32_t) ((uint64_t) radio.config.bitrateWord * 1000 / 1024);
+}
+
+// Bits before the payload
+static uint32_t SimRadio_HeaderBits(void) {
+    return radio.config.preambleBits + radio.config.syncBits + (radio.config.variableLength ? 8 : 0);
+}
+
+static void SimRadio_EndTx(uint64_t now, bool timedOut, bool irq) {
+    radio.txActive = false;
+    radio.tx.endUs = now;
+    radio.tx.timedOut = timedOut;
+    if (irq) {
+        radio.irqStatus |= timedOut ? SUBGHZ_IT_RX_TX_TIMEOUT : SUBGHZ_IT_TX_CPLT;
+        uint8_t fallback = radio.config.fallback;
+        SimRadio_SetState(fallback == 0x40 ? SIM_RADIO_FS : fallback == 0x30 ? SIM_RADIO_XOSC : SIM_RADIO_RC);
+    }
+    Sim_RecordTx(&radio.tx);
+}
+
+void SimRadio_Update(uint64_t now) {
+    if (radio.txActive && now >= radio.txEndUs) {
+        SimRadio_EndTx(now, !radio.txPacketEnd, true);
+    }
+}
+
+static void SimRadio_StartTx(uint8_t opcode, const uint8_t *params) {
+    uint64_t now = Sim_Now();
+    const SimRadioConfig *c = &radio.config;
+
+    memset(&radio.tx, 0, sizeof(radio.tx));
+    radio.tx.startUs = now;
+    radio.tx.rfFreq = c->rfFreq;
+    radio.tx.dBm = SimRadio_Dbm();
+    radio.tx.bitrateWord = c->bitrateWord;
+    radio.txActive = true;
+    radio.txEndUs = SIM_NEVER;
+    radio.txPacketEnd = false;
+
+    if (opcode == 0x83) {
+        uint32_t timeout = ((uint32_t) params[0] << 16) | (params[1] << 8) | params[2];
+        if (timeout != 0) {
+            // 15.625 us steps
+            radio.txEndUs = now + ((uint64_t) timeout * 15625 + 999) / 1000;
+        }
+        if (c->packetType == 0x00 && c->bitrateWord != 0) {
+            radio.tx.packet = true;
+            radio.tx.preambleBits = c->preambleBits;
+            radio.tx.length = c->length;
+            for (uint16_t p = 0; p < c->length; p++) {
+                radio.tx.payload[p] = radio.buffer[(uint8_t) (c->txBase + p)];
+            }
+            uint32_t crcBits = (c->crcType & 0x01) ? 0 : (c->crcType & 0x02) ? 16 : 8;
+            uint64_t bits = SimRadio_HeaderBits() + c->length * 8U + crcBits;
+            uint64_t end = now + (bits * SimRadio_BitNs() + 999) / 1000;
+            if (end <= radio.txEndUs) {
+                radio.txEndUs = end;
+                radio.txPacketEnd = true;
+            }
+        }
+    }
+    SimRadio_SetState(SIM_RADIO_TX);
+}
+
+// Bytes written into the part of the buffer being sent, at writeUs for
+// the first one
+static void SimRadio_WriteDuringTx(uint8_t offset, const uint8_t *data, uint16_t size, uint64_t writeUs) {
+    const SimRadioConfig *c = &radio.config;
+    for (uint16_t k = 0; k < size; k++) {
+        uint8_t p = (uint8_t) (offset + k - c->txBase);
+        if (p >= radio.tx.length) {
+            continue;
+        }
+        uint64_t readUs = radio.tx.startUs + (uint64_t) (SimRadio_HeaderBits() + 8U * p) * SimRadio_BitNs() / 1000;
+        if (readUs >= writeUs + k * SIM_SPI_BYTE_US) {
+            radio.tx.payload[p] = data[k];
+        }
+    }
+}
+
+// NSS low wakes the radio up from Sleep into STDBY_RC
+static void SimRadio_Select(void) {
+    if (radio.state == SIM_RADIO_SLEEP) {
+        Sim_Awake(SIM_RADIO_WAKE_US);
+        SimRadio_SetState(SIM_RADIO_RC);
+    }
+}
+
+// The crystal starts before anything that needs it
+static void SimRadio_NeedXosc(void) {
+    if (radio.state == SIM_RADIO_RC) {
+        Sim_Awake(SIM_RADIO_XOSC_US);
+        SimRadio_SetState(SIM_RADIO_XOSC);
+    }
+}
+
+static void SimRadio_Command(uint8_t opcode, const uint8_t *p, uint16_t size) {
+    SimRadioConfig *c = &radio.config;
+    switch (opcode) {
+    case 0x80: // SetStandby
+        if (radio.txActive) {
+            SimRadio_EndTx(Sim_Now(), false, false);
+        }
+        if (p[0]) {
+            SimRadio_NeedXosc();
+            SimRadio_SetState(SIM_RADIO_XOSC);
+        } else {
+            SimRadio_SetState(SIM_RADIO_RC);
+        }
+        break;
+    case 0x84: // SetSleep
+        if (radio.txActive) {
+            SimRadio_EndTx(Sim_Now(), false, false);
+        }
+        if (!(p[0] & 0x04)) {
+            *c = simRadioDefaults;
+        }
+        SimRadio_SetState(SIM_RADIO_SLEEP);
+        break;
+    case 0x83: // SetTx
+    case 0xD1: // SetTxContinuousWave
+    case 0xD2: // SetTxInfinitePreamble
+        if (radio.txActive) {
+            SimRadio_EndTx(Sim_Now(), false, false);
+        }
+        SimRadio_NeedXosc();
+        SimRadio_StartTx(opcode, p);
+        break;
+    case 0x8A:
+        c->packetType = p[0];
+        break;
+    case 0x86:
+        c->rfFreq = ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | (p[2] << 8) | p[3];
+        if (radio.txActive) {
+            radio.tx.freqSteps++;
+        }
+        break;
+    case 0x95:
+        memcpy(c->pa, p, sizeof(c->pa));
+        break;
+    case 0x8E:
+        memcpy(c->txParams, p, sizeof(c->txParams));
+        break;
+    case 0x8B:
+        if (c->packetType == 0x00) {
+            c->bitrateWord = ((uint32_t) p[0] << 16) | (p[1] << 8) | p[2];
+        }
+        break;
+    case 0x8C:
+        if (c->packetType == 0x00) {
+            c->preambleBits = (p[0] << 8) | p[1];
+            c->syncBits = p[3];
+            c->variableLength = p[5] != 0;
+            c->length = p[6];
+            c->crcType = p[7];
+        }
+        break;
+    case 0x93:
+        c->fallback = p[0];
+        break;
+    case 0x08:
+        c->irqMask = (p[0] << 8) | p[1];
+        break;
+    case 0x8F:
+        c->txBase = p[0];
+        break;
+    case 0x02: // ClearIrqStatus
+        radio.irqStatus &= ~((p[0] << 8) | p[1]);
+        break;
+    default:
+        break;
+    }
+}
+
+HAL_StatusTypeDef HAL_SUBGHZ_Init(SUBGHZ_HandleTypeDef *hsubghz) {
+    HAL_SUBGHZ_MspInit(hsubghz);
+    hsubghz->State = HAL_SUBGHZ_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SUBGHZ_ExecSetCmd(SUBGHZ_HandleTypeDef *hsubghz, SUBGHZ_RadioSetCmd_t Command, uint8_t *pBuffer,
+                                        uint16_t Size) {
+    Sim_Enter();
+    Sim_RecordEvent(SIM_EVENT_CMD, (uint8_t) Command, pBuffer, Size, 0);
+    SimRadio_Select();
+    Sim_Awake(SIM_SPI_OVERHEAD_US + (1U + Size) * SIM_SPI_BYTE_US);
+    SimRadio_Command((uint8_t) Command, pBuffer, Size);
+    Sim_Leave();
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SUBGHZ_ExecGetCmd(SUBGHZ_HandleTypeDef *hsubghz, SUBGHZ_RadioGetCmd_t Command, uint8_t *pBuffer,
+                                        uint16_t Size) {
+    Sim_Enter();
+    SimRadio_Select();
+    Sim_Awake(SIM_SPI_OVERHEAD_US + (2U + Size) * SIM_SPI_BYTE_US);
+    memset(pBuffer, 0, Size);
+    if (Command == RADIO_GET_IRQSTATUS && Size >= 2) {
+        pBuffer[0] = (uint8_t) (radio.irqStatus >> 8);
+        pBuffer[1] = (uint8_t) radio.irqStatus;
+    }
+    Sim_Leave();
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SUBGHZ_WriteBuffer(SUBGHZ_HandleTypeDef *hsubghz, uint8_t Offset, uint8_t *pBuffer, uint16_t Size) {
+    Sim_Enter();
+    Sim_RecordEvent(SIM_EVENT_WRITE, Offset, pBuffer, Size, 0);
+    SimRadio_Select();
+    // The data bytes follow the opcode and the offset
+    uint64_t writeUs = Sim_Now() + SIM_SPI_OVERHEAD_US / 2 + 3U * SIM_SPI_BYTE_US;
+    if (radio.txActive && radio.tx.packet) {
+        SimRadio_WriteDuringTx(Offset, pBuffer, Size, writeUs);
+    }
+    for (uint16_t k = 0; k < Size; k++) {
+        radio.buffer[(uint8_t) (Offset + k)] = pBuffer[k];
+    }
+    Sim_Awake(SIM_SPI_OVERHEAD_US + (2U + Size) * SIM_SPI_BYTE_US);
+    Sim_Leave();
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SUBGHZ_ReadBuffer(SUBGHZ_HandleTypeDef *hsubghz, uint8_t Offset, uint8_t *pBuffer, uint16_t Size) {
+    Sim_Enter();
+    SimRadio_Select();
+    for (uint16_t k = 0; k < Size; k++) {
+        pBuffer[k] = radio.buffer[(uint8_t) (Offset + k)];
+    }
+    Sim_Awake(SIM_SPI_OVERHEAD_US + (3U + Size) * SIM_SPI_BYTE_US);
+    Sim_Leave();
+    return HAL_OK;
+}
+
+void HAL_SUBGHZ_IRQHandler(SUBGHZ_HandleTypeDef *hsubghz) {
+    uint8_t tmpisr[2] = {0};
+    HAL_SUBGHZ_ExecGetCmd(hsubghz, RADIO_GET_IRQSTATUS, tmpisr, 2);
+    uint16_t itsource = (tmpisr[0] << 8) | tmpisr[1];
+    HAL_SUBGHZ_ExecSetCmd(hsubghz, RADIO_CLR_IRQSTATUS, tmpisr, 2);
+
+    if (itsource & SUBGHZ_IT_TX_CPLT) {
+        HAL_SUBGHZ_TxCpltCallback(hsubghz);
+    }
+    if (itsource & SUBGHZ_IT_RX_TX_TIMEOUT) {
+        HAL_SUBGHZ_RxTxTimeoutCallback(hsubghz);
+    }
+}
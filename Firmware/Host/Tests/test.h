@@ -0,0 +1,36 @@
+/**
+  ******************************************************************************
+  * @file           : test.h
+  * @brief          : Checks of the host tests, one executable per test file.
+  ******************************************************************************
+  */
+
+#ifndef __TEST_H
+#define __TEST_H
+
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static int testFailures;
+
+// Reports and counts a failed check, the test goes on
+#define CHECK(cond, ...)                                                  \
+    do {                                                                  \
+        if (!(cond)) {                                                    \
+            fprintf(stderr, "%s:%d: %s: ", __FILE__, __LINE__, #cond);    \
+            fprintf(stderr, __VA_ARGS__);                                 \
+            fprintf(stderr, "\n");                                        \
+            testFailures++;                                               \
+        }                                                                 \
+    } while (0)
+
+static inline int Test_Result(void) {
+    if (testFailures) {
+        fprintf(stderr, "%d check(s) failed\n", testFailures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+#endif /* __TEST_H */
@@ -0,0 +1,88 @@
+/**
+  ******************************************************************************
+  * @file           : test_audio.c
+  * @brief          : The bytes of the audio clips as the radio sends them.
+  ******************************************************************************
+  * RadioPacket_Stream() writes the next buffer half while the radio is
+  * still sending the packet, behind the byte it reads and ahead of the
+  * byte the SPI writes. The radio model only sends a byte written during
+  * the transmission if the write got there first, so every byte on air has
+  * to be the byte of the clip, in order, with nothing lost or repeated.
+  */
+
+#include "test.h"
+#include "audio.h"
+#include "audioclips.h"
+#include "radio.h"
+#include "radiopacket.h"
+#include "lowpower.h"
+#include <string.h>
+
+extern SUBGHZ_HandleTypeDef hsubghz;
+
+#define TEST_MAX_BYTES 20000
+
+static uint8_t expected[TEST_MAX_BYTES];
+
+// The clip as one bitstream, the repeats unrolled
+static uint32_t Test_Unroll(const AudioClip *clip) {
+    uint32_t bytes = 0;
+    for (uint16_t s = 0; s < clip->count; s++) {
+        const AudioSegment *segment = &clip->segments[s];
+        for (uint16_t r = 0; r < segment->repeat && bytes + segment->bytes <= TEST_MAX_BYTES; r++) {
+            memcpy(expected + bytes, segment->data, segment->bytes);
+            bytes += segment->bytes;
+        }
+    }
+    return bytes;
+}
+
+static void Test_RadioInit(void) {
+    HAL_Init();
+    HAL_SUBGHZ_Init(&hsubghz);
+    LowPower_Init();
+    SetStandbyXOSC();
+    SetPacketTypeFSK();
+    SetRfFreq(ComputeRfFreq(433225000, 0));
+    SetTxRxFallbackMode(0x30);
+    SetDioIrqParams(SUBGHZ_IT_TX_CPLT | SUBGHZ_IT_RX_TX_TIMEOUT, SUBGHZ_IT_TX_CPLT | SUBGHZ_IT_RX_TX_TIMEOUT, 0, 0);
+}
+
+static void Test_Clip(const char *name, const AudioClip *clip) {
+    uint32_t bytes = Test_Unroll(clip);
+
+    simEventCount = 0;
+    simTxCount = 0;
+    Sim_Record(true);
+    Audio_Play(clip, 10);
+    Sim_Record(false);
+
+    uint32_t sent = 0;
+    for (uint32_t j = 0; j < simTxCount; j++) {
+        const SimTx *tx = &simTxs[j];
+        CHECK(tx->packet && !tx->timedOut && tx->bitrateWord == FSK_BITRATE_WORD(clip->bitrate),
+              "%s packet %lu: not an FSK packet ended by its last bit", name, (unsigned long) j);
+        CHECK(tx->preambleBits == RADIOPACKET_PREAMBLE_BITS, "%s packet %lu: %u preamble bits", name,
+              (unsigned long) j, tx->preambleBits);
+        // Only the last packet is short
+        CHECK(tx->length == RADIOPACKET_STREAM_SIZE || j == simTxCount - 1, "%s packet %lu: %u bytes", name,
+              (unsigned long) j, tx->length);
+        for (uint16_t k = 0; k < tx->length; k++, sent++) {
+            if (sent < bytes && tx->payload[k] != expected[sent]) {
+                CHECK(false, "%s packet %lu byte %u (clip byte %lu): 0x%02X, want 0x%02X", name,
+                      (unsigned long) j, k, (unsigned long) sent, tx->payload[k], expected[sent]);
+                return;
+            }
+        }
+    }
+    CHECK(sent == bytes, "%s: %lu bytes sent of %lu", name, (unsigned long) sent, (unsigned long) bytes);
+}
+
+int main(void) {
+    Test_RadioInit();
+    Test_Clip("chord", &audioClipChord);
+    Test_Clip("dtmf", &audioClipDtmf);
+    Test_Clip("sweep", &audioClipSweep);
+    Test_Clip("jingle", &audioClipJingle);
+    return Test_Result();
+}
@@ -0,0 +1,175 @@
+/**
+  ******************************************************************************
+  * @file           : test_beacon.c
+  * @brief          : beaconCycle, and the copy Beacon_Apply() rebuilds in RAM.
+  ******************************************************************************
+  * The loops below are the ones main() ran before the cycle was built at
+  * compile time, with the settings of beacon_config.h, recorded through
+  * the real beep functions into a radio script. beaconCycle has to be the
+  * same script, byte for byte, and so has the cycle Beacon_Apply() builds
+  * from the same words. A power cap only changes the top of the ladders.
+  */
+
+#include "test.h"
+#include "beacon.h"
+#include "radio.h"
+#include "radioscript.h"
+#include <string.h>
+
+// main.c
+void LED_on(void);
+void LED_off(void);
+void FSKBeep(int8_t powerdBm, uint32_t toneHz, uint32_t lengthMs);
+void CWBeep(int8_t powerdBm, uint32_t lengthMs);
+
+static int Test_StepSize(int count) {
+    return count > 1 ? (31 - 22 + BEACON_MAX_POWER) / (count - 1) : 0;
+}
+
+static void Test_RecordOldCycle(void) {
+    int gap = BEACON_PERIOD;
+    if (BEACON_FSK_ENABLED) {
+        gap -= BEACON_FSK_LENGTH * BEACON_FSK_COUNT + BEACON_FSK_GAP * (BEACON_FSK_COUNT - 1);
+    }
+    if (BEACON_CW_ENABLED) {
+        gap -= BEACON_CW_LENGTH * BEACON_CW_COUNT + BEACON_CW_GAP * (BEACON_CW_COUNT - 1);
+    }
+    if (BEACON_CW_ENABLED && BEACON_FSK_ENABLED) {
+        gap /= 2;
+    }
+
+    SetRfFreq(ComputeRfFreq(BEACON_CENTER_FREQ, BEACON_FREQ_CORRECTION));
+    if (BEACON_FSK_ENABLED) {
+        for (int j = 0; j < BEACON_FSK_COUNT; j++) {
+            int step = BEACON_FSK_HIGH2LOW ? j : BEACON_FSK_COUNT - 1 - j;
+            LED_on();
+            FSKBeep(BEACON_MAX_POWER - Test_StepSize(BEACON_FSK_COUNT) * step, 80 * (4 + j % 3) * (1 << (j / 3)),
+                    BEACON_FSK_LENGTH);
+            LED_off();
+            Radio_Delay(BEACON_FSK_GAP);
+        }
+        Radio_Delay(gap);
+    }
+    if (BEACON_CW_ENABLED) {
+        for (int j = 0; j < BEACON_CW_COUNT; j++) {
+            int step = BEACON_CW_HIGH2LOW ? j : BEACON_CW_COUNT - 1 - j;
+            LED_on();
+            SetRfFreq(ComputeRfFreq(BEACON_CENTER_FREQ + BEACON_CW_OFFSET * j, BEACON_FREQ_CORRECTION));
+            CWBeep(BEACON_MAX_POWER - Test_StepSize(BEACON_CW_COUNT) * step, BEACON_CW_LENGTH);
+            LED_off();
+            Radio_Delay(BEACON_CW_GAP);
+        }
+        Radio_Delay(gap);
+    }
+}
+
+// Bytes of a script up to and including RSCRIPT_END
+static uint16_t Script_Length(const uint8_t *steps) {
+    const uint8_t *p = steps;
+    while (*p != RSCRIPT_END) {
+        switch (*p) {
+        case RSCRIPT_CMD:
+            p += 3 + p[2];
+            break;
+        case RSCRIPT_TX:
+        case RSCRIPT_DELAY:
+            p += 3;
+            break;
+        case RSCRIPT_CHIRP:
+            p += 7;
+            break;
+        default:
+            p += 1;
+            break;
+        }
+    }
+    return (uint16_t) (p - steps + 1);
+}
+
+// A frequency correction one step smaller than any frequency word, so the
+// rebuilt cycle has to come out the same as the compiled one
+static int32_t Test_InvisibleCorrection(void) {
+    for (int32_t d = -2; d <= 2; d++) {
+        bool same = RF_FREQ_WORD(BEACON_CENTER_FREQ, BEACON_FREQ_CORRECTION + d) == BEACON_RF_FREQ;
+        for (int32_t i = 0; i < BEACON_CW_ENABLED * BEACON_CW_COUNT; i++) {
+            same = same && RF_FREQ_WORD(BEACON_CENTER_FREQ + BEACON_CW_OFFSET * i, BEACON_FREQ_CORRECTION + d) ==
+                               RF_FREQ_WORD(BEACON_CENTER_FREQ + BEACON_CW_OFFSET * i, BEACON_FREQ_CORRECTION);
+        }
+        if (same && d != 0) {
+            return BEACON_FREQ_CORRECTION + d;
+        }
+    }
+    return BEACON_FREQ_CORRECTION;
+}
+
+static void Test_Apply(void) {
+    // Beacon_SetPowerCap() applies config
+    BeaconConfig cfg = config;
+    uint16_t length = Script_Length(beaconCycle);
+
+    // The defaults run the compiled-in cycle
+    Config_Defaults(&config);
+    Config_Defaults(&cfg);
+    Beacon_Apply(&cfg);
+    CHECK(beacon.cycle == beaconCycle, "defaults rebuilt");
+    CHECK(beacon.rfFreq == BEACON_RF_FREQ && beacon.gap == BEACON_GAP && beacon.loopCounter == BEACON_LOOP_COUNTER,
+          "defaults: %lu %lu %lu", (unsigned long) beacon.rfFreq, (unsigned long) beacon.gap,
+          (unsigned long) beacon.loopCounter);
+    Beacon_SetPowerCap(BEACON_MAX_POWER);
+    CHECK(beacon.cycle == beaconCycle, "cap at BEACON_MAX_POWER rebuilt");
+
+    // A rebuild of the same words is the same script
+    cfg.freqCorrection = Test_InvisibleCorrection();
+    CHECK(cfg.freqCorrection != BEACON_FREQ_CORRECTION, "no correction leaves the words alone");
+    Beacon_Apply(&cfg);
+    CHECK(beacon.cycle != beaconCycle, "not rebuilt");
+    CHECK(Script_Length(beacon.cycle) == length, "%u bytes, beaconCycle has %u", Script_Length(beacon.cycle), length);
+    CHECK(memcmp(beacon.cycle, beaconCycle, length) == 0, "rebuilt cycle differs from beaconCycle");
+
+    // Another period only moves the gaps after the ladders
+    Config_Defaults(&cfg);
+    cfg.period = BEACON_PERIOD + 1000;
+    CHECK(Config_Check(&cfg), "period %lu refused", (unsigned long) cfg.period);
+    Beacon_Apply(&cfg);
+    CHECK(Script_Length(beacon.cycle) == length, "length changed with the period");
+    uint16_t delays = 0;
+    for (uint16_t i = 0; i < length; i++) {
+        if (beacon.cycle[i] != beaconCycle[i]) {
+            // Low byte of a gap of RSCRIPT_STEP_DELAY()
+            uint16_t was = beaconCycle[i] | (beaconCycle[i + 1] << 8);
+            uint16_t now = beacon.cycle[i] | (beacon.cycle[i + 1] << 8);
+            CHECK(beaconCycle[i - 1] == RSCRIPT_DELAY && was == BEACON_GAP && now == beacon.gap,
+                  "byte %u: %02x, was %02x", i, beacon.cycle[i], beaconCycle[i]);
+            delays++;
+            i++;
+        }
+    }
+    CHECK(delays == BEACON_FSK_ENABLED + BEACON_CW_ENABLED, "%u gaps changed", delays);
+
+    // A lower cap takes the top of the ladders down, the rest stays
+    Beacon_SetPowerCap(BEACON_MAX_POWER - 3);
+    CHECK(beacon.cycle != beaconCycle && Script_Length(beacon.cycle) == length, "capped cycle");
+    CHECK(memcmp(beacon.cycle, beaconCycle, length) != 0, "cap had no effect");
+}
+
+int main(void) {
+    static uint8_t buf[1024];
+    RadioScript script;
+    RadioScript_Init(&script, buf, sizeof(buf));
+    RadioScript_Record(&script);
+    Test_RecordOldCycle();
+    RadioScript_Stop();
+
+    CHECK(!script.overflow, "recording overflowed");
+    CHECK(memcmp(script.buf, beaconCycle, script.size + 1) == 0, "beaconCycle differs from the recorded cycle");
+    for (uint16_t i = 0; i <= script.size; i++) {
+        if (script.buf[i] != beaconCycle[i]) {
+            CHECK(false, "byte %u: %02x, recorded %02x", i, beaconCycle[i], script.buf[i]);
+            break;
+        }
+    }
+    CHECK(BEACON_RF_FREQ == ComputeRfFreq(BEACON_CENTER_FREQ, BEACON_FREQ_CORRECTION), "BEACON_RF_FREQ");
+
+    Test_Apply();
+    return Test_Result();
+}
@@ -0,0 +1,154 @@
+/**
+  ******************************************************************************
+  * @file           : test_config.c
+  * @brief          : Loading the settings record, and what makes it fall back.
+  ******************************************************************************
+  * The record is written with the real EEPROM emulation into the simulated
+  * flash, then damaged one way at a time through the same EEPROM variables
+  * config.c uses.
+  */
+
+#include "test.h"
+#include "config.h"
+#include "flashwork.h"
+#include <string.h>
+
+extern CRC_HandleTypeDef hcrc;
+
+// config.c
+#define CONFIG_EE_HEADER 1U
+#define CONFIG_EE_CRC    2U
+#define CONFIG_EE_DATA   3U
+#define CONFIG_MAGIC     0xBEAC0000U
+
+// Independent of the CRC unit: CRC-32/MPEG-2 of the bytes of words
+static uint32_t Test_Crc(const uint32_t *words, uint32_t count) {
+    const uint8_t *bytes = (const uint8_t *) words;
+    uint32_t crc = 0xFFFFFFFFU;
+    for (uint32_t i = 0; i < count * 4; i++) {
+        crc ^= (uint32_t) bytes[i] << 24;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80000000U) ? (crc << 1) ^ 0x04C11DB7U : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static void Test_Write(uint16_t address, uint32_t value) {
+    FlashWork_Unlock();
+    EE_Status status = EE_WriteVariable32bits(address, value);
+    if (status == EE_CLEANUP_REQUIRED) {
+        status = EE_CleanUp();
+    }
+    FlashWork_Lock();
+    CHECK(status == EE_OK, "write of %u: %d", address, status);
+}
+
+// A record of the first count words of cfg as a given version, as an
+// older or newer firmware would have written it
+static void Test_WriteRecord(const BeaconConfig *cfg, uint32_t version, uint32_t count) {
+    uint32_t words[1 + CONFIG_WORDS];
+    words[0] = CONFIG_MAGIC | (version << 8) | count;
+    memcpy(&words[1], cfg, sizeof(*cfg));
+    for (uint32_t i = 0; i < count; i++) {
+        Test_Write(CONFIG_EE_DATA + i, words[1 + i]);
+    }
+    Test_Write(CONFIG_EE_CRC, Test_Crc(words, 1 + count));
+    Test_Write(CONFIG_EE_HEADER, words[0]);
+}
+
+static bool Test_IsDefaults(void) {
+    BeaconConfig defaults;
+    Config_Defaults(&defaults);
+    return memcmp(&config, &defaults, sizeof(defaults)) == 0;
+}
+
+static BeaconConfig Test_Edited(void) {
+    BeaconConfig cfg;
+    Config_Defaults(&cfg);
+    cfg.maxPower = 5;
+    cfg.period = 3000;
+    strcpy(cfg.callsign, "AB1CD");
+    cfg.morseWpm = 25;
+    cfg.morseFarnsworthWpm = 15;
+    return cfg;
+}
+
+int main(void) {
+    HAL_Init();
+    hcrc.Instance = CRC;
+    hcrc.Init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_ENABLE;
+    hcrc.Init.DefaultInitValueUse = DEFAULT_INIT_VALUE_ENABLE;
+    hcrc.Init.InputDataInversionMode = CRC_INPUTDATA_INVERSION_NONE;
+    hcrc.Init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_DISABLE;
+    hcrc.InputDataFormat = CRC_INPUTDATA_FORMAT_BYTES;
+    HAL_CRC_Init(&hcrc);
+    FlashWork_Init();
+
+    // Erased flash
+    CHECK(Config_Load() == CONFIG_BLANK, "blank: %d", configStatus);
+    CHECK(Test_IsDefaults(), "blank: not the defaults");
+
+    // Saved and loaded back, with the CRC over header and words
+    BeaconConfig edited = Test_Edited();
+    config = edited;
+    CHECK(Config_Save(), "save failed");
+    CHECK(Config_Load() == CONFIG_OK, "saved: %d", configStatus);
+    CHECK(memcmp(&config, &edited, sizeof(edited)) == 0, "saved: loaded other settings");
+    uint32_t words[1 + CONFIG_WORDS] = {CONFIG_MAGIC | (CONFIG_VERSION << 8) | CONFIG_WORDS};
+    memcpy(&words[1], &edited, sizeof(edited));
+    uint32_t crc = 0;
+    CHECK(EE_ReadVariable32bits(CONFIG_EE_CRC, &crc) == EE_OK && crc == Test_Crc(words, 1 + CONFIG_WORDS),
+          "stored CRC %08lx", (unsigned long) crc);
+
+    // A word written without its CRC, like a save cut short by a reset
+    Test_Write(CONFIG_EE_DATA, edited.centerFreq + 25000);
+    CHECK(Config_Load() == CONFIG_BAD_CRC, "torn: %d", configStatus);
+    CHECK(Test_IsDefaults(), "torn: not the defaults");
+
+    // A flipped CRC bit
+    Test_WriteRecord(&edited, CONFIG_VERSION, CONFIG_WORDS);
+    CHECK(Config_Load() == CONFIG_OK, "rewritten: %d", configStatus);
+    Test_Write(CONFIG_EE_CRC, crc ^ 0x00010000U);
+    CHECK(Config_Load() == CONFIG_BAD_CRC, "bad CRC: %d", configStatus);
+
+    // Not a settings record
+    Test_Write(CONFIG_EE_HEADER, 0x12340000U | (CONFIG_VERSION << 8) | CONFIG_WORDS);
+    CHECK(Config_Load() == CONFIG_BAD_CRC, "bad magic: %d", configStatus);
+
+    // Newer firmware, more words than this one knows
+    Test_WriteRecord(&edited, CONFIG_VERSION + 1, CONFIG_WORDS);
+    CHECK(Config_Load() == CONFIG_BAD_VERSION, "newer version: %d", configStatus);
+    Test_Write(CONFIG_EE_HEADER, CONFIG_MAGIC | (CONFIG_VERSION << 8) | (CONFIG_WORDS + 1));
+    CHECK(Config_Load() == CONFIG_BAD_VERSION, "more words: %d", configStatus);
+    CHECK(Test_IsDefaults(), "newer version: not the defaults");
+
+    // Version 1 had no morse speeds, they load at their defaults
+    Test_WriteRecord(&edited, 1, CONFIG_WORDS - 2);
+    CHECK(Config_Load() == CONFIG_OK, "version 1: %d", configStatus);
+    CHECK(config.maxPower == edited.maxPower && strcmp(config.callsign, edited.callsign) == 0 &&
+              config.morseWpm == BEACON_MORSE_WPM && config.morseFarnsworthWpm == BEACON_MORSE_FARNSWORTH_WPM,
+          "version 1: power %ld, wpm %lu", (long) config.maxPower, (unsigned long) config.morseWpm);
+
+    // A good CRC over values out of range
+    BeaconConfig bad = edited;
+    bad.maxPower = 23;
+    Test_WriteRecord(&bad, CONFIG_VERSION, CONFIG_WORDS);
+    CHECK(Config_Load() == CONFIG_INVALID, "power 23: %d", configStatus);
+    bad = edited;
+    bad.morseFarnsworthWpm = bad.morseWpm + 1;
+    Test_WriteRecord(&bad, CONFIG_VERSION, CONFIG_WORDS);
+    CHECK(Config_Load() == CONFIG_INVALID, "farnsworth > wpm: %d", configStatus);
+    bad = edited;
+    memset(bad.callsign, 'A', CONFIG_CALLSIGN_SIZE);
+    Test_WriteRecord(&bad, CONFIG_VERSION, CONFIG_WORDS);
+    CHECK(Config_Load() == CONFIG_INVALID, "unterminated callsign: %d", configStatus);
+    CHECK(Test_IsDefaults(), "invalid: not the defaults");
+
+    // Saving again repairs it
+    config = edited;
+    CHECK(Config_Save(), "save failed");
+    CHECK(Config_Load() == CONFIG_OK && memcmp(&config, &edited, sizeof(edited)) == 0, "repaired: %d", configStatus);
+
+    return Test_Result();
+}
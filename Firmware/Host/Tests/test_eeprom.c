@@ -0,0 +1,96 @@
+/**
+  ******************************************************************************
+  * @file           : test_eeprom.c
+  * @brief          : The EEPROM emulation against a reference model.
+  ******************************************************************************
+  * Random writes and reads of the 32 bit variables in the simulated flash,
+  * with the CRC unit in software, checked against a plain array. EE_Init()
+  * runs every few thousand operations like a reboot would, so the RAM index
+  * is rebuilt from the pages many times. Built twice, with the RAM index and
+  * with EE_NO_RAM_INDEX, which have to give the same results.
+  */
+
+#include "test.h"
+#include <string.h>
+
+#define TEST_OPERATIONS 200000U
+#define TEST_INIT_EVERY 5000U
+
+// The last ones are never written and have to stay EE_NO_DATA
+#define TEST_WRITTEN_VARIABLES (NB_OF_VARIABLES - 8U)
+
+static uint32_t model[NB_OF_VARIABLES + 1];
+static bool modelWritten[NB_OF_VARIABLES + 1];
+
+static uint32_t seed = 12345;
+
+static uint32_t Test_Random(void) {
+    seed = seed * 1664525U + 1013904223U;
+    return seed >> 8;
+}
+
+static void Test_Init(void) {
+    HAL_FLASH_Unlock();
+    EE_Status status = EE_Init(EE_CONDITIONAL_ERASE);
+    HAL_FLASH_Lock();
+    CHECK(status == EE_OK, "EE_Init: %d", status);
+}
+
+static bool Test_Read(uint16_t address) {
+    uint32_t value = 0;
+    EE_Status status = EE_ReadVariable32bits(address, &value);
+    if (!modelWritten[address]) {
+        CHECK(status == EE_NO_DATA, "read of unwritten %u: %d", address, status);
+        return status == EE_NO_DATA;
+    }
+    CHECK(status == EE_OK && value == model[address], "read of %u: %d, %08lx instead of %08lx", address, status,
+          (unsigned long) value, (unsigned long) model[address]);
+    return status == EE_OK && value == model[address];
+}
+
+int main(void) {
+    uint32_t transfers = 0;
+    uint32_t inits = 0;
+    uint32_t reads = 0;
+
+    HAL_Init();
+    Test_Init();
+    for (uint16_t address = 1; address <= NB_OF_VARIABLES; address++) {
+        Test_Read(address);
+    }
+
+    for (uint32_t op = 1; op <= TEST_OPERATIONS && testFailures < 10; op++) {
+        uint16_t address = 1 + Test_Random() % NB_OF_VARIABLES;
+        if (Test_Random() % 2 == 0 && address <= TEST_WRITTEN_VARIABLES) {
+            // Small values too, the flash lines of 0 are special
+            uint32_t value = Test_Random() % 4 == 0 ? Test_Random() % 3 : Test_Random() * 251U;
+            HAL_FLASH_Unlock();
+            EE_Status status = EE_WriteVariable32bits(address, value);
+            if (status == EE_CLEANUP_REQUIRED) {
+                transfers++;
+                status = EE_CleanUp();
+            }
+            HAL_FLASH_Lock();
+            CHECK(status == EE_OK, "write of %u: %d", address, status);
+            model[address] = value;
+            modelWritten[address] = true;
+        } else {
+            Test_Read(address);
+            reads++;
+        }
+
+        if (op % TEST_INIT_EVERY == 0) {
+            Test_Init();
+            inits++;
+            for (uint16_t a = 1; a <= NB_OF_VARIABLES; a++) {
+                Test_Read(a);
+            }
+        }
+    }
+
+    printf("%lu operations (%lu reads), %lu page transfers, %lu EE_Init()\n", (unsigned long) TEST_OPERATIONS,
+           (unsigned long) reads, (unsigned long) transfers, (unsigned long) inits);
+    // Enough writes to wrap the pages many times over
+    CHECK(transfers >= 100, "only %lu page transfers", (unsigned long) transfers);
+    return Test_Result();
+}
@@ -0,0 +1,179 @@
+/**
+  ******************************************************************************
+  * @file           : test_host.c
+  * @brief          : The mocks themselves, and a first minute of the firmware.
+  ******************************************************************************
+  */
+
+#include "test.h"
+#include "beacon.h"
+#include "radio.h"
+#include "radioscript.h"
+#include <string.h>
+#include <sys/mman.h>
+
+extern CRC_HandleTypeDef hcrc;
+extern SUBGHZ_HandleTypeDef hsubghz;
+
+static void Test_Crc(void) {
+    static const uint8_t check[] = "123456789";
+    LL_CRC_ResetCRCCalculationUnit(CRC);
+    for (uint8_t i = 0; i < 9; i++) {
+        LL_CRC_FeedData8(CRC, check[i]);
+    }
+    // CRC-32/MPEG-2, the unit's defaults
+    CHECK(LL_CRC_ReadData32(CRC) == 0x0376E6E7U, "CRC %08lx", (unsigned long) LL_CRC_ReadData32(CRC));
+}
+
+static void Test_Radio(void) {
+    uint8_t standby = 0x01;
+    uint8_t timeout[3] = {0x00, 0x06, 0x40}; // 25 ms
+    uint8_t irq[8] = {0x02, 0x01, 0x02, 0x01, 0, 0, 0, 0};
+
+    Sim_Record(true);
+    uint64_t start = Sim_Now();
+    HAL_SUBGHZ_ExecSetCmd(&hsubghz, RADIO_SET_STANDBY, &standby, 1);
+    CHECK(simEventCount == 1 && simEvents[0].type == SIM_EVENT_CMD && simEvents[0].opcode == RADIO_SET_STANDBY &&
+              simEvents[0].size == 1 && simEvents[0].data[0] == 0x01 && simEvents[0].us == start,
+          "SetStandby not recorded");
+    // Wake-up from Sleep, crystal start-up and the transfer
+    CHECK(Sim_Now() - start == SIM_RADIO_WAKE_US + SIM_RADIO_XOSC_US + SIM_SPI_OVERHEAD_US + 2 * SIM_SPI_BYTE_US,
+          "SetStandby took %llu us", (unsigned long long) (Sim_Now() - start));
+
+    HAL_SUBGHZ_ExecSetCmd(&hsubghz, RADIO_CFG_DIOIRQ, irq, sizeof(irq));
+    HAL_SUBGHZ_ExecSetCmd(&hsubghz, RADIO_SET_TX, timeout, sizeof(timeout));
+    uint64_t txStart = Sim_Now();
+    CHECK(SimRadio_NextEventUs() == txStart + 25000, "TX ends at %llu", (unsigned long long) SimRadio_NextEventUs());
+    SimRadio_Update(txStart + 25000);
+    CHECK(simTxCount == 1 && simTxs[0].timedOut && simTxs[0].endUs - simTxs[0].startUs == 25000, "TX not recorded");
+    CHECK(SimRadio_IrqPending(), "no timeout IRQ");
+
+    uint8_t status[2];
+    HAL_SUBGHZ_ExecGetCmd(&hsubghz, RADIO_GET_IRQSTATUS, status, 2);
+    CHECK(status[0] == 0x02 && status[1] == 0x00, "IRQ status %02x%02x", status[0], status[1]);
+    HAL_SUBGHZ_ExecSetCmd(&hsubghz, RADIO_CLR_IRQSTATUS, status, 2);
+    CHECK(!SimRadio_IrqPending(), "IRQ not cleared");
+    Sim_Record(false);
+}
+
+// A transmission of beaconCycle, from the start of the cycle
+typedef struct {
+    uint32_t startMs;
+    uint32_t lengthMs;
+    int8_t dBm;
+} TestTx;
+
+#define TEST_MAX_TX 256
+
+// The boot is a forked child, it hands its transmissions back through this
+static SimTx *firmwareTxs;
+static uint32_t *firmwareTxCount;
+
+static void Test_RecordTx(const SimTx *tx) {
+    if (*firmwareTxCount < TEST_MAX_TX) {
+        firmwareTxs[*firmwareTxCount] = *tx;
+    }
+    (*firmwareTxCount)++;
+}
+
+// The output power of the PA config and SetTxParams power of the cycle
+static int8_t Test_Dbm(const uint8_t *pa, int8_t power) {
+    for (int8_t dBm = -21; dBm <= 22; dBm++) {
+        if (pa[0] == RADIO_PA_DUTY(dBm) && pa[1] == RADIO_PA_HPMAX(dBm) && pa[2] == RADIO_PA_LP(dBm) &&
+            power == RADIO_TX_POWER(dBm)) {
+            return dBm;
+        }
+    }
+    return power;
+}
+
+// The transmissions of beaconCycle and the length of the cycle in ms
+static uint32_t Test_CycleTxs(TestTx *txs, uint32_t *count) {
+    uint8_t pa[4] = {0};
+    int8_t power = 0;
+    uint32_t ms = 0;
+    *count = 0;
+    for (const uint8_t *p = beaconCycle; *p != RSCRIPT_END;) {
+        switch (*p) {
+        case RSCRIPT_CMD:
+            if (p[1] == RADIO_SET_PACONFIG) {
+                memcpy(pa, &p[3], sizeof(pa));
+            } else if (p[1] == RADIO_SET_TXPARAMS) {
+                power = (int8_t) p[3];
+            }
+            p += 3 + p[2];
+            break;
+        case RSCRIPT_TX:
+        case RSCRIPT_CHIRP: {
+            const uint8_t *length = *p == RSCRIPT_TX ? &p[1] : &p[5];
+            txs[*count].startMs = ms;
+            txs[*count].lengthMs = length[0] | (length[1] << 8);
+            txs[*count].dBm = Test_Dbm(pa, power);
+            ms += txs[(*count)++].lengthMs;
+            p += *p == RSCRIPT_TX ? 3 : 7;
+            break;
+        }
+        case RSCRIPT_DELAY:
+            ms += p[1] | (p[2] << 8);
+            p += 3;
+            break;
+        default:
+            p++;
+            break;
+        }
+    }
+    return ms;
+}
+
+// The first minute against beaconCycle: every transmission as long and as
+// strong as the cycle says, and as far after the one before it. Radio
+// commands, wake-ups and the ms tick the delays count from may add up to
+// TEST_SLIP_US to each of these steps.
+#define TEST_SLIP_US 2000U
+
+static void Test_Tx(uint32_t count) {
+    TestTx cycle[TEST_MAX_TX];
+    uint32_t cycleCount;
+    uint32_t cycleMs = Test_CycleTxs(cycle, &cycleCount);
+    CHECK(count > cycleCount && count <= TEST_MAX_TX && cycleCount > 0, "%lu transmissions, %lu in the cycle",
+          (unsigned long) count, (unsigned long) cycleCount);
+    if (cycleCount == 0 || count > TEST_MAX_TX) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        const SimTx *tx = &firmwareTxs[i];
+        const TestTx *want = &cycle[i % cycleCount];
+        if (i > 0) {
+            const TestTx *before = &cycle[(i - 1) % cycleCount];
+            uint64_t step = (uint64_t) (want->startMs + (i % cycleCount == 0 ? cycleMs : 0) - before->startMs) * 1000U;
+            uint64_t after = tx->startUs - firmwareTxs[i - 1].startUs;
+            CHECK(after >= step && after < step + TEST_SLIP_US, "TX %lu starts %llu us after TX %lu, want %llu",
+                  (unsigned long) i, (unsigned long long) after, (unsigned long) (i - 1), (unsigned long long) step);
+        }
+        CHECK(tx->endUs - tx->startUs == (uint64_t) want->lengthMs * 1000U, "TX %lu lasts %llu us, want %lu ms",
+              (unsigned long) i, (unsigned long long) (tx->endUs - tx->startUs), (unsigned long) want->lengthMs);
+        CHECK(tx->dBm == want->dBm, "TX %lu at %d dBm, want %d", (unsigned long) i, tx->dBm, want->dBm);
+    }
+}
+
+static void Test_Firmware(void) {
+    firmwareTxs = mmap(NULL, TEST_MAX_TX * sizeof(SimTx) + sizeof(uint32_t), PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    firmwareTxCount = (uint32_t *) &firmwareTxs[TEST_MAX_TX];
+    simHooks.tx = Test_RecordTx;
+
+    SimBootResult result = Sim_Boot(Firmware_Main, 60000000U, true, false);
+    CHECK(result == SIM_BOOT_END, "boot ended with %d", result);
+    CHECK(simShared->boots == 1, "%lu boots", (unsigned long) simShared->boots);
+    CHECK(simShared->cmdCount > 10, "%lu radio commands", (unsigned long) simShared->cmdCount);
+    Test_Tx(*firmwareTxCount);
+}
+
+int main(void) {
+    Test_Crc();
+    Test_Radio();
+    SimRadio_Reset();
+    Test_Firmware();
+    return Test_Result();
+}
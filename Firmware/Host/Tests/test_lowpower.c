@@ -0,0 +1,66 @@
+/**
+  ******************************************************************************
+  * @file           : test_lowpower.c
+  * @brief          : Stop2 delays on an LSI off its nominal 32 kHz.
+  ******************************************************************************
+  * The LSI of a chip is anywhere in 31..33 kHz. Uncalibrated, LPTIM1 delays
+  * are off by as much; after LowPower_CalibrateLsi() they keep to the
+  * crystal, also over many short delays in a row.
+  */
+
+#include "test.h"
+#include "lowpower.h"
+#include "chirp.h"
+#include "clock.h"
+
+// Virtual time a LowPower_Delay() of ms takes, in us
+static uint64_t Test_DelayUs(uint32_t ms, uint32_t count) {
+    uint64_t start = Sim_Now();
+    for (uint32_t i = 0; i < count; i++) {
+        LowPower_Delay(ms);
+    }
+    return Sim_Now() - start;
+}
+
+static void Test_Lsi(uint32_t hz) {
+    simLsiHz = hz;
+    CHECK(LowPower_CalibrateLsi(), "%lu Hz: calibration failed", (unsigned long) hz);
+    CHECK(LowPower_LsiHz() + 2 >= hz && LowPower_LsiHz() <= hz + 2, "%lu Hz: measured %lu Hz", (unsigned long) hz,
+          (unsigned long) LowPower_LsiHz());
+
+    // A tick is at most a ms late
+    uint64_t us = Test_DelayUs(1000, 1);
+    CHECK(us >= 999000U && us <= 1001000U, "%lu Hz: 1000 ms took %llu us", (unsigned long) hz,
+          (unsigned long long) us);
+    // The rounding of each delay is carried into the next one
+    us = Test_DelayUs(70, 100);
+    CHECK(us >= 6999000U && us <= 7001000U, "%lu Hz: 100 x 70 ms took %llu us", (unsigned long) hz,
+          (unsigned long long) us);
+
+    // TIM16 is left as Chirp_Init() set it up
+    CHECK(TIM16->CR1 == TIM_CR1_URS && TIM16->DIER == TIM_DIER_UIE && TIM16->CCER == 0 && TIM16->OR1 == 0,
+          "%lu Hz: TIM16 CR1 %lx DIER %lx", (unsigned long) hz, (unsigned long) TIM16->CR1,
+          (unsigned long) TIM16->DIER);
+}
+
+int main(void) {
+    HAL_Init();
+    LowPower_Init();
+    Chirp_Init();
+    Clock_Init();
+
+    // Uncalibrated, 3 % slow
+    simLsiHz = 31000;
+    uint64_t us = Test_DelayUs(1000, 1);
+    CHECK(us > 1030000U, "uncalibrated 1000 ms at 31 kHz took %llu us", (unsigned long long) us);
+
+    Test_Lsi(31000);
+    Test_Lsi(32960);
+    Test_Lsi(32000);
+
+    // No LSI edges in range, the last calibration stays
+    simLsiHz = 20000;
+    CHECK(!LowPower_CalibrateLsi(), "20 kHz accepted");
+    CHECK(LowPower_LsiHz() == 32000, "20 kHz: %lu Hz kept", (unsigned long) LowPower_LsiHz());
+    return Test_Result();
+}
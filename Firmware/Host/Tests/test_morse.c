@@ -0,0 +1,141 @@
+/**
+  ******************************************************************************
+  * @file           : test_morse.c
+  * @brief          : The bit timeline of the callsign sent as FSK packets.
+  ******************************************************************************
+  * Every bit the radio sends in Morse_PlayPacket() has to be the bit of the
+  * compiled stream at that time: the tone (alternating bits, the preamble
+  * included) over every dit and dah, zeros in the gaps inside a packet, and
+  * no carrier at all in the gaps between packets.
+  */
+
+#include "test.h"
+#include "morse.h"
+#include "radio.h"
+#include "lowpower.h"
+#include <string.h>
+
+extern SUBGHZ_HandleTypeDef hsubghz;
+
+#define TEST_BITRATE 800 // two bits per period of the 400 Hz tone
+#define TEST_BIT_US (1000000 / TEST_BITRATE)
+#define TEST_MAX_BITS 20000
+
+static uint8_t expected[TEST_MAX_BITS]; // 0/1, 2 for silence
+static uint8_t covered[TEST_MAX_BITS];
+
+// The message as bits, counted from its start like morse.c does
+static uint32_t Test_Render(const uint8_t *stream, const MorseTiming *timing) {
+    uint32_t ms = 0;
+    uint32_t bits = 0;
+    for (const uint8_t *p = stream; *p != MORSE_END; p++) {
+        uint32_t units = *p & MORSE_UNITS_MASK;
+        bool tone = (*p & MORSE_KIND_MASK) == MORSE_KEY_DOWN;
+        ms += units * ((*p & MORSE_KIND_MASK) == MORSE_SPACE ? timing->spaceMs : timing->ditMs);
+        uint32_t end = ms * TEST_BITRATE / 1000;
+        for (uint32_t i = 0; bits + i < end && bits + i < TEST_MAX_BITS; i++) {
+            expected[bits + i] = tone ? (i & 1) : 2;
+        }
+        bits = end;
+    }
+    return bits;
+}
+
+// Start of the tone nearest to bit
+static uint32_t Test_NearestTone(uint32_t bit) {
+    for (int32_t d = 0; d < TEST_MAX_BITS; d++) {
+        for (int32_t b = (int32_t) bit - d; b <= (int32_t) bit + d; b += 2 * d + (d == 0)) {
+            if (b >= 0 && b < TEST_MAX_BITS && expected[b] != 2 && (b == 0 || expected[b - 1] == 2)) {
+                return (uint32_t) b;
+            }
+        }
+    }
+    return bit;
+}
+
+static void Test_RadioInit(void) {
+    HAL_Init();
+    HAL_SUBGHZ_Init(&hsubghz);
+    LowPower_Init();
+    SetStandbyXOSC();
+    SetPacketTypeFSK();
+    SetRfFreq(ComputeRfFreq(433225000, 0));
+    SetTxRxFallbackMode(0x30);
+    SetDioIrqParams(SUBGHZ_IT_TX_CPLT | SUBGHZ_IT_RX_TX_TIMEOUT, SUBGHZ_IT_TX_CPLT | SUBGHZ_IT_RX_TX_TIMEOUT, 0, 0);
+}
+
+int main(void) {
+    static uint8_t stream[MORSE_STREAM_SIZE(16)];
+    MorseTiming timing = Morse_Timing(20, 20);
+    CHECK(Morse_Compile("PARIS PARIS PARI", stream, sizeof(stream)), "stream too small");
+    uint32_t messageBits = Test_Render(stream, &timing);
+
+    Test_RadioInit();
+    Sim_Record(true);
+    Morse_PlayPacket(stream, &timing, 10);
+    Sim_Record(false);
+
+    // Set commands, the ClearIrqStatus of the IRQ handler after every
+    // packet included
+    uint32_t commands = 0;
+    uint32_t writes = 0;
+    for (uint32_t i = 0; i < simEventCount; i++) {
+        if (simEvents[i].type == SIM_EVENT_CMD) {
+            commands++;
+        } else if (simEvents[i].type == SIM_EVENT_WRITE) {
+            writes++;
+        }
+    }
+    CHECK(simTxCount == 6, "%lu packets", (unsigned long) simTxCount);
+    CHECK(commands == 28, "%lu radio commands", (unsigned long) commands);
+    CHECK(writes == simTxCount, "%lu buffer writes for %lu packets", (unsigned long) writes,
+          (unsigned long) simTxCount);
+
+    // Every packet starts with a tone, its preamble in place of the first
+    // bits of it. The first one is message bit 0, the others start at the
+    // tone nearest to their start time. The MCU times the gaps between
+    // them on the HAL tick, which loses up to a millisecond whenever the
+    // radio IRQ ends a Stop2 sleep, so each gap may come out up to two bits
+    // long, never short.
+    uint64_t t0 = simTxs[0].startUs;
+    int64_t lastLateUs = 0;
+    for (uint32_t j = 0; j < simTxCount; j++) {
+        const SimTx *tx = &simTxs[j];
+        CHECK(tx->packet && !tx->timedOut && tx->bitrateWord == FSK_BITRATE_WORD(TEST_BITRATE),
+              "packet %lu: not an FSK packet ended by its last bit", (unsigned long) j);
+        CHECK(tx->preambleBits == 8, "packet %lu: %u preamble bits", (unsigned long) j, tx->preambleBits);
+        uint32_t start = Test_NearestTone((uint32_t) ((tx->startUs - t0) / TEST_BIT_US));
+        int64_t lateUs = (int64_t) (tx->startUs - t0) - (int64_t) start * TEST_BIT_US;
+        CHECK(lateUs >= lastLateUs && lateUs - lastLateUs < 2 * TEST_BIT_US, "packet %lu: gap %lld us long",
+              (unsigned long) j, (long long) (lateUs - lastLateUs));
+        lastLateUs = lateUs;
+
+        uint32_t bits = tx->preambleBits + tx->length * 8U;
+        for (uint32_t k = 0; k < bits; k++) {
+            uint32_t b = start + k;
+            uint8_t sent = k < tx->preambleBits ? (k & 1) : (tx->payload[(k - 8) >> 3] >> (7 - ((k - 8) & 7))) & 1;
+            uint8_t want = b < messageBits ? expected[b] : 2;
+            // Silence inside a packet is a steady carrier, zeros
+            CHECK(sent == (want == 2 ? 0 : want), "packet %lu bit %lu (message bit %lu): %u, want %u",
+                  (unsigned long) j, (unsigned long) k, (unsigned long) b, sent, want);
+            if (b < TEST_MAX_BITS) {
+                covered[b] = 1;
+            }
+            if (testFailures > 10) {
+                return Test_Result();
+            }
+        }
+        CHECK(tx->endUs - tx->startUs == ((uint64_t) bits * FSK_BITRATE_WORD(TEST_BITRATE) * 1000 / 1024 + 999) / 1000,
+              "packet %lu: %llu us on air for %lu bits", (unsigned long) j,
+              (unsigned long long) (tx->endUs - tx->startUs), (unsigned long) bits);
+    }
+
+    // Every bit of every dit and dah went out
+    for (uint32_t b = 0; b < messageBits; b++) {
+        CHECK(expected[b] == 2 || covered[b], "message bit %lu not sent", (unsigned long) b);
+        if (testFailures > 10) {
+            break;
+        }
+    }
+    return Test_Result();
+}
@@ -0,0 +1,90 @@
+/**
+  ******************************************************************************
+  * @file           : test_rfmath.c
+  * @brief          : The integer radio words against the double math they replaced.
+  ******************************************************************************
+  * The old firmware computed the words in double, which is what the radio
+  * was tuned with, so the integer versions have to give the same bits.
+  */
+
+#include "test.h"
+#include "rfmath.h"
+#include "beacon_config.h"
+
+// main.c, in Hz
+extern const uint32_t LPD433[69];
+extern const uint32_t PMR446[16];
+extern const uint32_t FRS[22];
+
+// The channel tables of the old main.c, in MHz
+static const double LPD433_MHZ[69] = {
+    433.075, 433.100, 433.125, 433.150, 433.175, 433.200, 433.225, 433.250, 433.275, 433.300, // 1-10
+    433.325, 433.350, 433.375, 433.400, 433.425, 433.450, 433.475, 433.500, 433.525, 433.550, // 11-20
+    433.575, 433.600, 433.625, 433.650, 433.675, 433.700, 433.725, 433.750, 433.775, 433.800, // 21-30
+    433.825, 433.850, 433.875, 433.900, 433.925, 433.950, 433.975, 434.000, 434.025, 434.050, // 31-40
+    434.075, 434.100, 434.125, 434.150, 434.175, 434.200, 434.225, 434.250, 434.275, 434.300, // 41-50
+    434.325, 434.350, 434.375, 434.400, 434.425, 434.450, 434.475, 434.500, 434.525, 434.550, // 51-60
+    434.575, 434.600, 434.625, 434.650, 434.675, 434.700, 434.725, 434.750, 434.775           // 61-69
+};
+
+static const double PMR446_MHZ[16] = {
+    446.00625, 446.01875, 446.03125, 446.04375, 446.05625, // 1-5
+    446.06875, 446.08125, 446.09375, 446.10625, 446.11875, // 6-10
+    446.13125, 446.14375, 446.15625, 446.16875, 446.18125, // 11-15
+    446.19375 // 16
+};
+
+static const double FRS_MHZ[22] = {
+    462.5625, 462.5875, 462.6125, 462.6375, 462.6625, 462.6875, 462.7125, 467.5625, 467.5875, 467.6125, // 1-10
+    467.6375, 467.6625, 467.6875, 467.7125, 462.5500, 462.5750, 462.6000, 462.6250, 462.6500, 462.6750, // 11-20
+    462.7000, 462.7250 // 21-22
+};
+
+// The old conversions. long double is double on the Cortex-M4, so the
+// Fdev factor is a double here too.
+static uint32_t Old_RfFreq(double frequencyMhz) {
+    return (uint32_t) (frequencyMhz * 1048576L);
+}
+
+static uint32_t Old_Bitrate(uint32_t bitrate) {
+    return (uint32_t) (32 * 32e6 / bitrate);
+}
+
+static uint32_t Old_Fdev(uint32_t freqDev) {
+    return (uint32_t) (freqDev * (double) 1.048576L);
+}
+
+static void Test_Channels(const char *name, const uint32_t *hz, const double *mhz, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        uint32_t word = ComputeRfFreq(hz[i], 0);
+        CHECK(word == Old_RfFreq(mhz[i]), "%s[%u]: %lu, was %lu", name, i, (unsigned long) word,
+              (unsigned long) Old_RfFreq(mhz[i]));
+        CHECK(word == RF_FREQ_WORD(hz[i], 0), "%s[%u]: the macro differs", name, i);
+    }
+}
+
+int main(void) {
+    Test_Channels("LPD433", LPD433, LPD433_MHZ, 69);
+    Test_Channels("PMR446", PMR446, PMR446_MHZ, 16);
+    Test_Channels("FRS", FRS, FRS_MHZ, 22);
+
+    for (uint32_t bitrate = 100; bitrate <= 20000; bitrate++) {
+        CHECK(ComputeFSKBitrate(bitrate) == Old_Bitrate(bitrate), "BR of %lu bit/s: %lu, was %lu",
+              (unsigned long) bitrate, (unsigned long) ComputeFSKBitrate(bitrate),
+              (unsigned long) Old_Bitrate(bitrate));
+    }
+    for (uint32_t dev = 0; dev <= 100000; dev++) {
+        CHECK(ComputeFSKFdev(dev) == Old_Fdev(dev), "Fdev of %lu Hz: %lu, was %lu", (unsigned long) dev,
+              (unsigned long) ComputeFSKFdev(dev), (unsigned long) Old_Fdev(dev));
+    }
+
+    // The old correction factor 0.99999539941 became -4601 ppb, within one step
+    for (uint8_t i = 0; i < 69; i++) {
+        int64_t diff = (int64_t) ComputeRfFreq(LPD433[i], -4601) - Old_RfFreq(LPD433_MHZ[i] * 0.99999539941);
+        CHECK(diff >= -1 && diff <= 1, "LPD433[%u] corrected: %lld steps off", i, (long long) diff);
+    }
+    CHECK(ComputeRfFreq(BEACON_CENTER_FREQ, BEACON_FREQ_CORRECTION) ==
+              RF_FREQ_WORD(BEACON_CENTER_FREQ, BEACON_FREQ_CORRECTION), "BEACON_CENTER_FREQ");
+
+    return Test_Result();
+}
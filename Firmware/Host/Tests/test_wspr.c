@@ -0,0 +1,106 @@
+/**
+  ******************************************************************************
+  * @file           : test_wspr.c
+  * @brief          : The timing of a WSPR transmission and its frequency words.
+  ******************************************************************************
+  * The radio sends a continuous wave until SetStandby, so the length of the
+  * transmission is the TIM17 timing alone: 162 symbols of 8192 / 12 ms, in
+  * WSPR_SUBSTEPS steps of 42666 or 42667 us, 2592 substeps and their words
+  * from 2591 interrupts and the one that ends it.
+  */
+
+#include "test.h"
+#include "wspr.h"
+#include "wsprmessage.h"
+#include "radio.h"
+#include "clock.h"
+#include "lowpower.h"
+
+extern SUBGHZ_HandleTypeDef hsubghz;
+
+#define TEST_RF_FREQ ComputeRfFreq(432301500, 0)
+#define TEST_STEPS (WSPR_SYMBOLS * WSPR_SUBSTEPS)
+
+static void Test_RadioInit(void) {
+    HAL_Init();
+    HAL_SUBGHZ_Init(&hsubghz);
+    LowPower_Init();
+    Wspr_Init();
+    Clock_Init();
+    SetStandbyXOSC();
+    SetPacketTypeFSK();
+    // What main() leaves the radio with, the packet would end after 32.8 s
+    SetPacketParamsFSK(0xFFFF, 0);
+    SetTxRxFallbackMode(0x30);
+    SetDioIrqParams(SUBGHZ_IT_TX_CPLT | SUBGHZ_IT_RX_TX_TIMEOUT, SUBGHZ_IT_TX_CPLT | SUBGHZ_IT_RX_TX_TIMEOUT, 0, 0);
+}
+
+static uint32_t Test_Word(const SimEvent *event) {
+    return ((uint32_t) event->data[0] << 24) | (event->data[1] << 16) | (event->data[2] << 8) | event->data[3];
+}
+
+// Start of substep k from the first: k steps of 42666 or 42667 us
+static uint64_t Test_GridUs(uint32_t k) {
+    return (uint64_t) k * 8192000U / (12U * WSPR_SUBSTEPS);
+}
+
+int main(void) {
+    Test_RadioInit();
+
+    simEventCount = 0;
+    simTxCount = 0;
+    Sim_Record(true);
+    uint64_t start = Sim_Now();
+    Wspr_Send(&wsprMessage, TEST_RF_FREQ);
+    uint64_t end = Sim_Now();
+    Sim_Record(false);
+
+    CHECK(simTxCount == 1, "%lu transmissions", (unsigned long) simTxCount);
+    const SimTx *tx = &simTxs[0];
+    CHECK(!tx->packet && !tx->timedOut, "not a continuous wave ended by SetStandby");
+    CHECK(tx->dBm == wsprMessage.powerdBm, "%d dBm, the message reports %d", tx->dBm, wsprMessage.powerdBm);
+    CHECK(tx->rfFreq == TEST_RF_FREQ + wsprMessage.words[0], "starts at %lu", (unsigned long) tx->rfFreq);
+    CHECK((tx->endUs - tx->startUs) / 1000U == WSPR_LENGTH_MS && WSPR_LENGTH_MS == 110592,
+          "lasts %llu us", (unsigned long long) (tx->endUs - tx->startUs));
+    CHECK(end - start < (WSPR_LENGTH_MS + 10) * 1000ULL, "Wspr_Send() took %llu us", (unsigned long long) (end - start));
+
+    // The substeps where the word changes, the radio command shadow drops
+    // SetRfFrequency of the word the radio already has
+    uint32_t changes = 0;
+    for (uint32_t k = 1; k < TEST_STEPS; k++) {
+        changes += wsprMessage.words[k] != wsprMessage.words[k - 1];
+    }
+    CHECK(tx->freqSteps == changes, "%lu SetRfFrequency during the transmission, %lu word changes",
+          (unsigned long) tx->freqSteps, (unsigned long) changes);
+
+    // Every change at the start of its substep, on the grid of 42666 and
+    // 42667 us steps that keeps to the 8192 / 12 ms symbols
+    uint32_t k = 0;
+    uint64_t firstUs = 0;
+    for (uint32_t i = 0; i < simEventCount; i++) {
+        const SimEvent *event = &simEvents[i];
+        if (event->type != SIM_EVENT_CMD || event->opcode != RADIO_SET_RFFREQUENCY || event->us < tx->startUs ||
+            event->us >= tx->endUs) {
+            continue;
+        }
+        do {
+            k++;
+        } while (k < TEST_STEPS && wsprMessage.words[k] == wsprMessage.words[k - 1]);
+        if (k >= TEST_STEPS) {
+            CHECK(false, "SetRfFrequency after the last change");
+            break;
+        }
+        CHECK(Test_Word(event) == TEST_RF_FREQ + wsprMessage.words[k], "step %lu: word %lu, want %lu",
+              (unsigned long) k, (unsigned long) Test_Word(event),
+              (unsigned long) (TEST_RF_FREQ + wsprMessage.words[k]));
+        if (firstUs == 0) {
+            firstUs = event->us - Test_GridUs(k);
+        }
+        CHECK(event->us - firstUs == Test_GridUs(k), "step %lu: %lld us off the grid", (unsigned long) k,
+              (long long) (event->us - firstUs - Test_GridUs(k)));
+    }
+    // The last substep, ended by SetStandby
+    CHECK(tx->endUs - firstUs >= Test_GridUs(TEST_STEPS) && tx->endUs - firstUs < Test_GridUs(TEST_STEPS) + 1000U,
+          "ends %lld us after the last substep", (long long) (tx->endUs - firstUs - Test_GridUs(TEST_STEPS)));
+    return Test_Result();
+}
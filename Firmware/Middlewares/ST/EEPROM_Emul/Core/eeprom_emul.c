@@ -139,6 +139,20 @@ __IO uint32_t AddressRead = 0;
 /* Flag equal to 1 when the cleanup phase is in progress, 0 if not */
 __IO uint8_t CleanupPhase = 0;
 
+#ifdef EE_RAM_INDEX
+#if defined (FLASH_LINES_128B)
+#error "EE_RAM_INDEX supports 64-bit flash lines only"
+#endif
+#if (PAGES_NUMBER * PAGE_SIZE) > 0xFFFFU
+#error "EE_RAM_INDEX offsets are 16 bits, too many pages"
+#endif
+#define EE_INDEX_NONE           0xFFFFU  /*!< Variable has no element in flash */
+/* Offset from START_PAGE_ADDRESS of the latest element of each variable, indexed by virtual address */
+static uint16_t uhElementIndex[NB_OF_VARIABLES + 1U];
+/* Flag equal to 1 once the index has been built by EE_Init or EE_Format */
+static uint8_t ubIndexReady = 0U;
+#endif
+
 /**
   * @}
   */
@@ -171,6 +185,11 @@ static EE_Status VerifyPagesFullWriteVariable(uint16_t VirtAddress, EE_DATA_TYPE
 static EE_Status SetPageState(uint32_t Page, EE_State_type State);
 static EE_State_type GetPageState(uint32_t Address);
 void ConfigureCrc(void);
+#ifdef EE_RAM_INDEX
+static void IndexBuild(void);
+static void IndexUpdate(uint16_t VirtAddress, uint32_t Address);
+static EE_Status IndexRead(uint16_t VirtAddress, EE_DATA_TYPE* pData);
+#endif
 
 /**
   * @}
@@ -223,6 +242,11 @@ EE_Status EE_Init(EE_Erase_type EraseType)
 
   ConfigureCrc();
 
+#ifdef EE_RAM_INDEX
+  /* Reads during the recovery below search the flash */
+  ubIndexReady = 0U;
+#endif
+
   /***************************************************************************/
   /* Step 1: Read all lines of the flash pages of eeprom emulation to        */
   /*         delete corrupted lines detectable through NMI                   */
@@ -611,6 +635,10 @@ if (recoverytransfer == 0U)
 #endif
   }
 
+#ifdef EE_RAM_INDEX
+  IndexBuild();
+#endif
+
   return EE_OK;
 }
 
@@ -699,6 +727,10 @@ EE_Status EE_Format(EE_Erase_type EraseType)
   ubCurrentActivePage = START_PAGE;
   uwAddressNextWrite = PAGE_HEADER_SIZE; /* Initialize write position just after page header */
 
+#ifdef EE_RAM_INDEX
+  IndexBuild();
+#endif
+
   return EE_OK;
 }
 
@@ -1112,6 +1144,18 @@ static EE_Status ReadVariable(uint16_t VirtAddress, EE_DATA_TYPE* pData)
   uint32_t page = 0U, pageaddress = 0U, counter = 0U, crc = 0U;
   EE_State_type pagestate = STATE_PAGE_INVALID;
 
+#ifdef EE_RAM_INDEX
+  /* Search the flash only if the indexed element is no longer there */
+  if (ubIndexReady != 0U)
+  {
+    EE_Status status = IndexRead(VirtAddress, pData);
+    if (status != EE_INVALID_ELEMENT)
+    {
+      return status;
+    }
+  }
+#endif
+
   /* Get active Page for read operation */
   page = FindPage(FIND_READ_PAGE);
 
@@ -1151,6 +1195,9 @@ static EE_Status ReadVariable(uint16_t VirtAddress, EE_DATA_TYPE* pData)
             /* Get content of variable value */
             *pData = EE_DATA_VALUE(addressvalue);
 
+#ifdef EE_RAM_INDEX
+            IndexUpdate(VirtAddress, pageaddress + counter);
+#endif
             return EE_OK;
           }
         }
@@ -1188,6 +1235,10 @@ static EE_Status ReadVariable(uint16_t VirtAddress, EE_DATA_TYPE* pData)
     pagestate = GetPageState(pageaddress);
   }
 
+#ifdef EE_RAM_INDEX
+  IndexUpdate(VirtAddress, EE_NO_PAGE_FOUND);
+#endif
+
   /* Variable is not found */
   return EE_NO_DATA;
 }
@@ -1767,6 +1818,10 @@ static EE_Status VerifyPagesFullWriteVariable(uint16_t VirtAddress, EE_DATA_TYPE
   }
 #endif
 
+#ifdef EE_RAM_INDEX
+  IndexUpdate(VirtAddress, activepageaddress + uwAddressNextWrite);
+#endif
+
   /* Increment global variables relative to write operation done*/
   uwAddressNextWrite += EE_ELEMENT_SIZE;
   uhNbWrittenElements++;
@@ -2087,6 +2142,110 @@ void ConfigureCrc(void)
   /* LL_CRC_SetOutputDataReverseMode(CRC, LL_CRC_OUTDATA_REVERSE_NONE); */
 }
 
+#ifdef EE_RAM_INDEX
+/**
+  * @brief  Builds the RAM index in one pass over the elements, newest first,
+  *         following the same page sequence as ReadVariable.
+  * @retval None
+  */
+static void IndexBuild(void)
+{
+  EE_ELEMENT_TYPE addressvalue = 0U;
+  uint32_t page = 0U, pageaddress = 0U, counter = 0U, nbpages = 0U;
+  uint16_t virtaddress = 0U, nbfound = 0U;
+  EE_State_type pagestate = STATE_PAGE_INVALID;
+
+  for (virtaddress = 0U; virtaddress <= NB_OF_VARIABLES; virtaddress++)
+  {
+    uhElementIndex[virtaddress] = EE_INDEX_NONE;
+  }
+
+  page = FindPage(FIND_READ_PAGE);
+  if (page != EE_NO_PAGE_FOUND)
+  {
+    pageaddress = PAGE_ADDRESS(page);
+    pagestate = GetPageState(pageaddress);
+
+    while (((pagestate == STATE_PAGE_ACTIVE) || (pagestate == STATE_PAGE_VALID) || (pagestate == STATE_PAGE_ERASING))
+           && (nbfound < NB_OF_VARIABLES) && (nbpages < PAGES_NUMBER))
+    {
+      for (counter = PAGE_SIZE - EE_ELEMENT_SIZE; counter >= PAGE_HEADER_SIZE; counter -= EE_ELEMENT_SIZE)
+      {
+        addressvalue = (*(__IO EE_ELEMENT_TYPE*)(pageaddress + counter));
+        if (addressvalue != EE_PAGESTAT_ERASED)
+        {
+          virtaddress = EE_VIRTUALADDRESS_VALUE(addressvalue);
+
+          /* Only the newest element with a good crc counts */
+          if ((virtaddress != 0U) && (virtaddress <= NB_OF_VARIABLES)
+              && (uhElementIndex[virtaddress] == EE_INDEX_NONE)
+              && (CalculateCrc(EE_DATA_VALUE(addressvalue), virtaddress) == EE_CRC_VALUE(addressvalue)))
+          {
+            uhElementIndex[virtaddress] = (uint16_t)(pageaddress + counter - START_PAGE_ADDRESS);
+            nbfound++;
+          }
+        }
+      }
+
+      page = PREVIOUS_PAGE(page);
+      pageaddress = PAGE_ADDRESS(page);
+      pagestate = GetPageState(pageaddress);
+      nbpages++;
+    }
+  }
+
+  ubIndexReady = 1U;
+}
+
+/**
+  * @brief  Records the flash address of the latest element of a variable.
+  * @param  VirtAddress Variable virtual address
+  * @param  Address Element address, EE_NO_PAGE_FOUND if the variable has none
+  * @retval None
+  */
+static void IndexUpdate(uint16_t VirtAddress, uint32_t Address)
+{
+  if ((VirtAddress != 0U) && (VirtAddress <= NB_OF_VARIABLES))
+  {
+    uhElementIndex[VirtAddress] = (Address == EE_NO_PAGE_FOUND) ? EE_INDEX_NONE : (uint16_t)(Address - START_PAGE_ADDRESS);
+  }
+}
+
+/**
+  * @brief  Reads a variable through the RAM index.
+  * @param  VirtAddress Variable virtual address
+  * @param  pData Variable containing the EE_DATA_TYPE read variable value
+  * @retval EE_Status
+  *           - EE_OK: if variable was found
+  *           - EE_NO_DATA: if variable has no element
+  *           - EE_INVALID_ELEMENT: if the indexed element no longer holds the
+  *             variable (moved by a page transfer), the flash must be searched
+  */
+static EE_Status IndexRead(uint16_t VirtAddress, EE_DATA_TYPE* pData)
+{
+  EE_ELEMENT_TYPE addressvalue = 0U;
+
+  if (VirtAddress > NB_OF_VARIABLES)
+  {
+    return EE_INVALID_ELEMENT;
+  }
+  if (uhElementIndex[VirtAddress] == EE_INDEX_NONE)
+  {
+    return EE_NO_DATA;
+  }
+
+  addressvalue = (*(__IO EE_ELEMENT_TYPE*)(START_PAGE_ADDRESS + uhElementIndex[VirtAddress]));
+  if ((addressvalue == EE_PAGESTAT_ERASED) || (EE_VIRTUALADDRESS_VALUE(addressvalue) != VirtAddress)
+      || (CalculateCrc(EE_DATA_VALUE(addressvalue), VirtAddress) != EE_CRC_VALUE(addressvalue)))
+  {
+    return EE_INVALID_ELEMENT;
+  }
+
+  *pData = EE_DATA_VALUE(addressvalue);
+  return EE_OK;
+}
+#endif
+
 /**
   * @brief  This function performs CRC calculation on Data and Virtual Address.
   * @param  Data value of  the eeprom variable.
@@ -41,7 +41,9 @@
   */
 
 /* Configuration of eeprom emulation in flash, can be custom */
-#define START_PAGE_ADDRESS      0x08080000U /*!< Start address of the 1st page in flash, for EEPROM emulation */
+#define START_PAGE_ADDRESS      0x0801E000U /*!< Start address of the 1st page in flash, for EEPROM emulation.
+                                        Last 8K of the 128K of the STM32WLE5xB, EEPROM_EMUL in
+                                        STM32WLE5CBUX_FLASH.ld. Also valid on the 256K STM32WLE5xC */
 #define CYCLES_NUMBER           1U   /*!< Number of 10Kcycles requested, minimum 1 for 10Kcycles (default),
                                         for instance 10 to reach 100Kcycles. This factor will increase
                                         pages number */
@@ -51,6 +53,13 @@
 #define CRC_POLYNOMIAL_LENGTH   LL_CRC_POLYLENGTH_16B /* CRC polynomial lenght 16 bits */
 #define CRC_POLYNOMIAL_VALUE    0x8005U /* Polynomial to use for CRC calculation */
 
+/* Keep the flash address of the latest element of each variable in RAM
+   (2 bytes per variable), so reads do not search the pages. EE_NO_RAM_INDEX
+   builds the plain page search, for comparing the two */
+#ifndef EE_NO_RAM_INDEX
+#define EE_RAM_INDEX
+#endif
+
 /**
   * @}
   */
@@ -68,7 +77,7 @@
 /** @defgroup Exported_Configuration_Constants Exported Configuration Constants
   * @{
   */
-#define NB_OF_VARIABLES         1000U  /*!< Number of variables to handle in eeprom */
+#define NB_OF_VARIABLES         64U  /*!< Number of variables to handle in eeprom, 4 pages */
 
 /**
   * @}
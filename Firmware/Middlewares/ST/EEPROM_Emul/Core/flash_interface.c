@@ -20,7 +20,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "eeprom_emul.h"
 #include "flash_interface.h"
-#include "stm32wlxx_nucleo.h"
+#include "main.h"
 
 /** @addtogroup EEPROM_Emulation
   * @{
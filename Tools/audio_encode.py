@@ -0,0 +1,446 @@
+#!/usr/bin/env python3
+"""Audio clips for FM receivers, encoded into FSK bitstreams.
+
+The radio sends a packet's bits as frequency shifts of +-2500 Hz. An FM
+receiver turns those back into a voltage and low-passes it to the audio
+band, so a bitstream whose average follows a waveform plays that
+waveform: a delta-sigma modulator at the bitrate, like a 1-bit DAC. The
+encoding runs here, the firmware only streams the bytes out of flash
+(audio.c, through radiopacket.c).
+
+A clip is a list of segments. Tones, chords, DTMF digits and vowels are
+periodic, so only one loop of their bitstream is stored and the firmware
+repeats it; the loop length is chosen so that every tone fits it a whole
+number of times within --tolerance. Sweeps are stored as they are.
+Identical loops (silence) are stored once.
+
+    python3 Tools/audio_encode.py                  SNR of every clip
+    python3 Tools/audio_encode.py --wav out        also the demodulated audio as WAV files
+    python3 Tools/audio_encode.py --write          regenerate Firmware/Core/Src/audioclips.c
+
+The check demodulates the bitstream as an NBFM receiver would: FSK with the
+radio's Gaussian filter, a 12.5 kHz channel filter, an FM discriminator
+and a 300..3000 Hz audio filter, then compares it with the intended
+waveform through the same audio filter. The firmware streams the clip as
+packets of the whole 255 byte radio buffer, with a short break in the
+carrier between them (about 0.5 ms at the 1 MHz system clock, mostly the
+SetTx command); the receiver hears its own noise there, a click every
+43 ms at 48 kbps. The SNR is given with and without these breaks; the
+breaks limit it, a higher bitrate only improves the part without them.
+"""
+
+import argparse
+import cmath
+import math
+import os
+import random
+import struct
+import sys
+import wave
+
+FIRMWARE = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'Firmware', 'Core')
+CLIPS_C = os.path.join(FIRMWARE, 'Src', 'audioclips.c')
+CLIPS_H = os.path.join(FIRMWARE, 'Inc', 'audioclips.h')
+
+# radiopacket.c
+DEVIATION_HZ = 2500
+PACKET_BITS = 255 * 8
+PREAMBLE_BITS = 8
+MAX_BITRATE = 80000
+
+BITRATE = 48000
+AMPLITUDE = 0.6  # peak, of the +-1 full deviation; a 2nd order modulator stays stable below ~0.7
+GAP_US = 500
+OVERSAMPLE = 2  # demodulator samples per bit
+CHANNEL_HZ = 6000
+AUDIO_LOW_HZ = 300
+AUDIO_HIGH_HZ = 3000
+
+DTMF_ROWS = (697, 770, 852, 941)
+DTMF_COLS = (1209, 1336, 1477, 1633)
+DTMF_KEYS = '123A456B789C*0#D'
+
+# Formants F1..F3 in Hz
+VOWELS = {'a': (730, 1090, 2440), 'e': (530, 1840, 2480), 'i': (270, 2290, 3010),
+          'o': (570, 840, 2410), 'u': (300, 870, 2240)}
+
+
+def dtmf(keys, ms=120, pause_ms=80):
+    segments = []
+    for key in keys:
+        index = DTMF_KEYS.index(key)
+        segments.append(('tones', (DTMF_ROWS[index // 4], DTMF_COLS[index % 4]), ms))
+        segments.append(('silence', (), pause_ms))
+    return segments
+
+
+# Segments: ('tones', frequencies, ms), ('vowel', (vowel, pitch), ms),
+# ('sweep', (from, to), ms), ('silence', (), ms)
+CLIPS = {
+    'chord': [('tones', (523.25, 659.25, 783.99), 400), ('tones', (587.33, 739.99, 880.0), 400),
+              ('tones', (659.25, 830.61, 987.77), 600)],
+    'dtmf': dtmf('73'),
+    'sweep': [('sweep', (500, 2500), 250), ('sweep', (2500, 500), 250)],
+    'jingle': [('vowel', ('o', 196.0), 200), ('vowel', ('e', 220.0), 200), ('vowel', ('a', 261.63), 350),
+               ('silence', (), 100), ('vowel', ('i', 293.66), 150), ('vowel', ('o', 196.0), 300)],
+}
+
+
+def loop_bits(freqs, bitrate, tolerance, max_bits):
+    """Shortest whole-byte loop with all frequencies within tolerance, else the best one"""
+    best = None
+    for bits in range(8, max_bits + 1, 8):
+        error = max((abs(round(f * bits / bitrate) * bitrate / bits - f) / f for f in freqs), default=0)
+        if error <= tolerance:
+            return bits
+        if best is None or error < best[0]:
+            best = (error, bits)
+    return best[1]
+
+
+def schroeder(count):
+    """Phases that keep the peak of a sum of harmonics low"""
+    return [math.pi * k * k / count for k in range(count)]
+
+
+def tones_wave(freqs, bitrate, bits):
+    cycles = [round(f * bits / bitrate) for f in freqs]
+    phases = schroeder(len(cycles))
+    return [sum(math.sin(2 * math.pi * c * n / bits + p) for c, p in zip(cycles, phases)) for n in range(bits)]
+
+
+def vowel_wave(vowel, pitch, bitrate, bits):
+    # Harmonics of the pitch with a falling source spectrum through formant resonances
+    periods = round(pitch * bits / bitrate)
+    harmonics = []
+    k = 1
+    while k * periods * bitrate / bits < AUDIO_HIGH_HZ + 400:
+        f = k * periods * bitrate / bits
+        gain = 1 / k
+        for formant in VOWELS[vowel]:
+            bandwidth = 60 + formant * 0.05
+            gain *= formant * formant / math.hypot(formant * formant - f * f, bandwidth * f)
+        harmonics.append((k * periods, gain))
+        k += 1
+    phases = schroeder(len(harmonics))
+    return [sum(g * math.sin(2 * math.pi * c * n / bits + p) for (c, g), p in zip(harmonics, phases))
+            for n in range(bits)]
+
+
+def sweep_wave(start, end, bitrate, bits):
+    samples = []
+    phase = 0
+    for n in range(bits):
+        samples.append(math.sin(phase))
+        phase += 2 * math.pi * (start + (end - start) * n / bits) / bitrate
+    return samples
+
+
+def normalize(samples):
+    peak = max((abs(s) for s in samples), default=0)
+    return [s * AMPLITUDE / peak for s in samples] if peak else samples
+
+
+class DeltaSigma:
+    """2nd order, noise transfer function (1 - z^-1)^2"""
+
+    def __init__(self):
+        self.e1 = 0.0
+        self.e2 = 0.0
+
+    def encode(self, samples):
+        bits = []
+        e1, e2 = self.e1, self.e2
+        for x in samples:
+            y = x + 2 * e1 - e2
+            v = 1.0 if y >= 0 else -1.0
+            e1, e2 = y - v, e1
+            bits.append(1 if v > 0 else 0)
+        self.e1, self.e2 = e1, e2
+        return bits
+
+
+def encode_clip(segments, bitrate, tolerance, max_loop_bits):
+    """[(bits of one loop, repeats, intended waveform of one loop)]"""
+    modulator = DeltaSigma()
+    encoded = []
+    for kind, params, ms in segments:
+        total = round(ms * bitrate / 1000)
+        if kind == 'sweep':
+            bits = -(-total // 8) * 8
+            samples = normalize(sweep_wave(params[0], params[1], bitrate, bits))
+            encoded.append((modulator.encode(samples), 1, samples))
+            continue
+        if kind == 'silence':
+            # Long enough that the firmware copies it in a few pieces
+            bits = 128
+            samples = [0.0] * bits
+        elif kind == 'tones':
+            bits = loop_bits(params, bitrate, tolerance, max_loop_bits)
+            samples = normalize(tones_wave(params, bitrate, bits))
+        elif kind == 'vowel':
+            bits = loop_bits([params[1]], bitrate, tolerance, max_loop_bits)
+            samples = normalize(vowel_wave(params[0], params[1], bitrate, bits))
+        else:
+            raise ValueError('unknown segment kind %s' % kind)
+        # Settle into the loop first, so that it joins up with itself
+        modulator.encode(samples)
+        modulator.encode(samples)
+        encoded.append((modulator.encode(samples), max(1, round(total / bits)), samples))
+    return encoded
+
+
+def pack(bits):
+    data = bytearray(len(bits) // 8)
+    for i, bit in enumerate(bits):
+        if bit:
+            data[i >> 3] |= 0x80 >> (i & 7)
+    return bytes(data)
+
+
+def butterworth(order, cutoff, fs, highpass=False):
+    """Biquad sections (b0, b1, b2, a1, a2)"""
+    sections = []
+    w = 2 * math.pi * cutoff / fs
+    for k in range(order // 2):
+        q = 1 / (2 * math.cos(math.pi * (2 * k + 1) / (2 * order)))
+        alpha = math.sin(w) / (2 * q)
+        cos_w = math.cos(w)
+        a0 = 1 + alpha
+        if highpass:
+            b = ((1 + cos_w) / 2, -(1 + cos_w), (1 + cos_w) / 2)
+        else:
+            b = ((1 - cos_w) / 2, 1 - cos_w, (1 - cos_w) / 2)
+        sections.append((b[0] / a0, b[1] / a0, b[2] / a0, -2 * cos_w / a0, (1 - alpha) / a0))
+    return sections
+
+
+def filtered(samples, sections):
+    for b0, b1, b2, a1, a2 in sections:
+        out = []
+        x1 = x2 = y1 = y2 = 0
+        for x in samples:
+            y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2
+            x1, x2, y1, y2 = x, x1, y, y1
+            out.append(y)
+        samples = out
+    return samples
+
+
+def on_air(stream, reference, gap_bits):
+    """Bits and intended waveform as sent in packets: a break (None), the preamble and up to 255 bytes each"""
+    bits = []
+    intended = []
+    for start in range(0, len(stream), PACKET_BITS):
+        if start:
+            bits += [None] * gap_bits
+            intended += [0.0] * gap_bits
+        bits += [i & 1 for i in range(PREAMBLE_BITS)]
+        intended += [0.0] * PREAMBLE_BITS
+        bits += stream[start:start + PACKET_BITS]
+        intended += reference[start:start + PACKET_BITS]
+    return bits, intended
+
+
+def demodulate(bits, bitrate):
+    """NBFM receiver output, +-1 at full deviation, at bitrate * OVERSAMPLE"""
+    fs = bitrate * OVERSAMPLE
+    # Gaussian filter BT 0.5 on the frequency, in samples
+    sigma = math.sqrt(math.log(2)) / (2 * math.pi * 0.5) * OVERSAMPLE
+    taps = [math.exp(-0.5 * (n / sigma) ** 2) for n in range(-3 * OVERSAMPLE, 3 * OVERSAMPLE + 1)]
+    taps = [t / sum(taps) for t in taps]
+
+    rng = random.Random(1)
+    freq = []
+    for bit in bits:
+        freq += [0.0 if bit is None else (1.0 if bit else -1.0)] * OVERSAMPLE
+    gaps = [bit is None for bit in bits for _ in range(OVERSAMPLE)]
+    half = len(taps) // 2
+    padded = [0.0] * half + freq + [0.0] * half
+    shaped = [sum(t * padded[n + i] for i, t in enumerate(taps)) for n in range(len(freq))]
+
+    phase = 0.0
+    i_samples = []
+    q_samples = []
+    step = 2 * math.pi * DEVIATION_HZ / fs
+    for f, gap in zip(shaped, gaps):
+        phase += f * step
+        if gap:
+            # No carrier: the receiver hears its own noise
+            z = complex(rng.gauss(0, 1), rng.gauss(0, 1))
+        else:
+            z = cmath.exp(1j * phase)
+        i_samples.append(z.real)
+        q_samples.append(z.imag)
+    channel = butterworth(4, CHANNEL_HZ, fs)
+    i_samples = filtered(i_samples, channel)
+    q_samples = filtered(q_samples, channel)
+
+    audio = [0.0]
+    previous = complex(i_samples[0], q_samples[0])
+    for i, q in zip(i_samples[1:], q_samples[1:]):
+        z = complex(i, q)
+        audio.append(cmath.phase(z * previous.conjugate()) / step)
+        previous = z
+    return audio
+
+
+def audio_filter(samples, fs):
+    return filtered(samples, butterworth(2, AUDIO_LOW_HZ, fs, True) + butterworth(4, AUDIO_HIGH_HZ, fs))
+
+
+def snr_db(audio, reference):
+    """With the best gain and delay of audio"""
+    best = None
+    for lag in range(0, 4 * OVERSAMPLE):
+        a = audio[lag:]
+        r = reference[:len(a)]
+        power = sum(x * x for x in r)
+        gain = sum(x * y for x, y in zip(a, r)) / max(sum(x * x for x in a), 1e-12)
+        noise = sum((gain * x - y) ** 2 for x, y in zip(a, r))
+        snr = 10 * math.log10(power / max(noise, 1e-12))
+        if best is None or snr > best[0]:
+            best = (snr, lag, gain)
+    return best
+
+
+def check(encoded, bitrate, gap_us):
+    """SNR in dB of the demodulated clip, and its audio at bitrate * OVERSAMPLE"""
+    stream = []
+    reference = []
+    for bits, repeats, samples in encoded:
+        stream += bits * repeats
+        reference += samples * repeats
+    fs = bitrate * OVERSAMPLE
+    bits, intended = on_air(stream, reference, round(gap_us * bitrate / 1e6))
+    audio = audio_filter(demodulate(bits, bitrate), fs)
+    ref = audio_filter([x for x in intended for _ in range(OVERSAMPLE)], fs)
+    snr, lag, gain = snr_db(audio, ref)
+    return snr, [gain * x for x in audio[lag:]]
+
+
+def write_wav(path, audio, fs, rate=8000):
+    step = fs // rate
+    frames = b''.join(struct.pack('<h', max(-32767, min(32767, int(x * 32767))))
+                      for x in audio[::step])
+    with wave.open(path, 'wb') as out:
+        out.setnchannels(1)
+        out.setsampwidth(2)
+        out.setframerate(fs // step)
+        out.writeframes(frames)
+
+
+def c_name(name):
+    return 'audioClip' + name[0].upper() + name[1:]
+
+
+def write_c(clips, bitrate, stats):
+    data = {}
+    for encoded in clips.values():
+        for bits, _, _ in encoded:
+            data.setdefault(pack(bits), 'audioData%d' % len(data))
+
+    out = ['/**',
+           '  ******************************************************************************',
+           '  * @file           : audioclips.c',
+           '  * @brief          : Audio clips as delta-sigma FSK bitstreams.',
+           '  ******************************************************************************',
+           '  * Generated by Tools/audio_encode.py, do not edit. Regenerate with',
+           '  *     python3 Tools/audio_encode.py --write',
+           '  */',
+           '',
+           '#include "audioclips.h"',
+           '']
+    for block, label in data.items():
+        out.append('static const uint8_t %s[%d] = {' % (label, len(block)))
+        for i in range(0, len(block), 16):
+            out.append('    ' + ' '.join('0x%02X,' % b for b in block[i:i + 16]))
+        out.append('};')
+        out.append('')
+    for name, encoded in clips.items():
+        seconds, size, snr, clean = stats[name]
+        out.append('// %.2f s, %d bytes, %.1f dB SNR (%.1f dB without the packet breaks)' % (seconds, size, snr, clean))
+        out.append('static const AudioSegment %sSegments[] = {' % c_name(name))
+        for bits, repeats, _ in encoded:
+            out.append('    {%s, %d, %d},' % (data[pack(bits)], len(bits) // 8, repeats))
+        out.append('};')
+        out.append('const AudioClip %s = {%sSegments, %d, AUDIOCLIPS_BITRATE};' % (c_name(name), c_name(name), len(encoded)))
+        out.append('')
+    with open(CLIPS_C, 'w') as f:
+        f.write('\n'.join(out))
+
+    header = ['/**',
+              '  ******************************************************************************',
+              '  * @file           : audioclips.h',
+              '  * @brief          : Audio clips as delta-sigma FSK bitstreams.',
+              '  ******************************************************************************',
+              '  * Generated by Tools/audio_encode.py, do not edit.',
+              '  */',
+              '',
+              '#ifndef __AUDIOCLIPS_H',
+              '#define __AUDIOCLIPS_H',
+              '',
+              '#ifdef __cplusplus',
+              'extern "C" {',
+              '#endif',
+              '',
+              '#include "audio.h"',
+              '',
+              '// Bitrate all the clips were encoded at',
+              '#define AUDIOCLIPS_BITRATE %d' % bitrate,
+              '']
+    header += ['extern const AudioClip %s;' % c_name(name) for name in clips]
+    header += ['',
+               '#ifdef __cplusplus',
+               '}',
+               '#endif',
+               '',
+               '#endif /* __AUDIOCLIPS_H */',
+               '']
+    with open(CLIPS_H, 'w') as f:
+        f.write('\n'.join(header))
+    return sum(len(block) for block in data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('clips', nargs='*', help='clips to encode (default all: %s)' % ', '.join(CLIPS))
+    parser.add_argument('--bitrate', type=int, default=BITRATE, help='bits per second (default %d)' % BITRATE)
+    parser.add_argument('--tolerance', type=float, default=0.003,
+                        help='largest relative error of a tone in a loop (default 0.003, 5 cents)')
+    parser.add_argument('--max-loop', type=int, default=512, help='longest loop in bytes (default 512)')
+    parser.add_argument('--gap-us', type=float, default=GAP_US,
+                        help='carrier break between packets (default %d)' % GAP_US)
+    parser.add_argument('--wav', metavar='PREFIX', help='write the demodulated audio to PREFIX-<clip>.wav')
+    parser.add_argument('--write', action='store_true', help='write audioclips.c and audioclips.h')
+    args = parser.parse_args()
+
+    if args.bitrate > MAX_BITRATE:
+        sys.exit('the firmware streams at most %d bps' % MAX_BITRATE)
+    names = args.clips or list(CLIPS)
+    for name in names:
+        if name not in CLIPS:
+            sys.exit('unknown clip %s' % name)
+
+    clips = {}
+    stats = {}
+    print('clip\tseconds\tbytes\tSNR dB\twithout breaks')
+    for name in names:
+        encoded = encode_clip(CLIPS[name], args.bitrate, args.tolerance, args.max_loop * 8)
+        seconds = sum(len(bits) * repeats for bits, repeats, _ in encoded) / args.bitrate
+        size = sum(len(block) for block in {pack(bits) for bits, _, _ in encoded})
+        snr, audio = check(encoded, args.bitrate, args.gap_us)
+        clean, _ = check(encoded, args.bitrate, 0)
+        clips[name] = encoded
+        stats[name] = (seconds, size, snr, clean)
+        print('%s\t%.2f\t%d\t%.1f\t%.1f' % (name, seconds, size, snr, clean))
+        if args.wav:
+            write_wav('%s-%s.wav' % (args.wav, name), audio, args.bitrate * OVERSAMPLE)
+
+    if args.write:
+        size = write_c(clips, args.bitrate, stats)
+        print('wrote %s and %s, %d bytes of bitstreams' % (os.path.relpath(CLIPS_C), os.path.relpath(CLIPS_H), size))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,300 @@
+#!/usr/bin/env python3
+"""Power simulation of the beacon firmware.
+
+Builds the firmware for the host (Firmware/Host, the real main loop, radio
+scripts, morse, audio, WSPR, chirps and power cap against the mock HAL)
+with the given settings, runs it for a virtual flight and reports airtime,
+duty cycle, charge and projected battery life, plus the worst-case wait for
+a listener until the next beep at or above a detection threshold.
+
+The currents are those of the firmware's energy ledger (energy.c), the
+mock reports every change of them. Only the battery is modelled here: an
+open-circuit voltage behind an internal resistance, which can rise to
+batteryRPeak halfway through the flight and fall back (a cell getting cold
+and warming up again). The firmware's ADC conversions read the supply under
+the load of the moment, and a load that pulls it below borMv is a brownout
+reset of the firmware:
+
+    python3 Tools/beacon_sim.py --set maxPower=20 --set batteryRPeak=30 --sweep SagLowMv=0,2100
+
+Settings not given with --set or --sweep are those of beacon_config.h.
+Sweeps run in parallel on all cores and the Pareto front (average current
+vs worst-case gap) is marked.
+
+    python3 Tools/beacon_sim.py
+    python3 Tools/beacon_sim.py --set maxPower=14 --hours 12
+    python3 Tools/beacon_sim.py --sweep Period=1000,2000,4000 --sweep maxPower=0,10,14 --detect-dbm 0
+"""
+
+import argparse
+import hashlib
+import itertools
+import multiprocessing
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+HOST = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'Firmware', 'Host')
+
+BATTERIES_MAH = {'CR2032': 225, 'LiPo 300 mAh': 300}
+
+# Simulator setting names and their beacon_config.h macros
+SETTINGS = {
+    'maxPower': 'BEACON_MAX_POWER',
+    'CallsignTF': 'BEACON_CALLSIGN_ENABLED',
+    'callsign': 'BEACON_CALLSIGN',
+    'CallsignPeriod': 'BEACON_CALLSIGN_PERIOD',
+    'morseWpm': 'BEACON_MORSE_WPM',
+    'morseFarnsworthWpm': 'BEACON_MORSE_FARNSWORTH_WPM',
+    'morsePacket': 'BEACON_MORSE_PACKET',
+    'AudioTF': 'BEACON_AUDIO_ENABLED',
+    'AudioClip': 'BEACON_AUDIO_CLIP',
+    'WsprTF': 'BEACON_WSPR_ENABLED',
+    'CWbeep': 'BEACON_CW_ENABLED',
+    'CWbeepcount': 'BEACON_CW_COUNT',
+    'CWHigh2Low': 'BEACON_CW_HIGH2LOW',
+    'CWbeepIndLength': 'BEACON_CW_LENGTH',
+    'CWbeepGapLength': 'BEACON_CW_GAP',
+    'CWchirpSpan': 'BEACON_CW_CHIRP_SPAN',
+    'CWchirpStepUs': 'BEACON_CW_CHIRP_STEP_US',
+    'FSKbeep': 'BEACON_FSK_ENABLED',
+    'FSKbeepcount': 'BEACON_FSK_COUNT',
+    'FSKHigh2Low': 'BEACON_FSK_HIGH2LOW',
+    'FSKbeepIndLength': 'BEACON_FSK_LENGTH',
+    'FSKbeepGapLength': 'BEACON_FSK_GAP',
+    'Period': 'BEACON_PERIOD',
+    'SagLowMv': 'BEACON_SAG_LOW_MV',
+    'SagHighMv': 'BEACON_SAG_HIGH_MV',
+}
+
+# Simulator-only settings, also accepted by --set and --sweep
+SIM_SETTINGS = {
+    'batteryMv': 3000,    # open-circuit voltage
+    'batteryR': 15,       # internal resistance in ohm, a CR2032 at room temperature
+    'batteryRPeak': 15,   # resistance halfway through the flight
+    'borMv': 1800,        # supply at which the beacon resets
+}
+
+
+def parse_value(text):
+    text = text.strip()
+    try:
+        return int(text, 0)
+    except ValueError:
+        return text
+
+
+def macro_value(name, value):
+    """The text of a setting in beacon_config.h"""
+    if value in ('true', 'false'):
+        return '1' if value == 'true' else '0'
+    if name == 'callsign' and not str(value).startswith('"'):
+        return '"%s"' % value
+    return str(value)
+
+
+def override_header(settings):
+    """Header included at the end of beacon_config.h"""
+    lines = ['// Generated by Tools/beacon_sim.py']
+    for name in sorted(settings):
+        if name in SETTINGS:
+            lines.append('#undef %s' % SETTINGS[name])
+            lines.append('#define %s %s' % (SETTINGS[name], macro_value(name, settings[name])))
+    return '\n'.join(lines) + '\n'
+
+
+def build(job):
+    """Builds beacon_host with a header of settings, returns its path or the first compiler error"""
+    header, build_root = job
+    directory = os.path.join(build_root, hashlib.sha1(header.encode()).hexdigest()[:12])
+    os.makedirs(directory, exist_ok=True)
+    path = os.path.join(directory, 'beacon_config_override.h')
+    if not os.path.exists(path) or open(path).read() != header:
+        with open(path, 'w') as f:
+            f.write(header)
+    for command in (['cmake', '-S', HOST, '-B', directory, '-DBEACON_CONFIG_OVERRIDE=' + path],
+                    ['cmake', '--build', directory, '--target', 'beacon_host']):
+        run = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+        if run.returncode:
+            errors = re.findall(r'error: (.*)', run.stdout)
+            return None, errors[0] if errors else run.stdout.strip().splitlines()[-1]
+    return os.path.join(directory, 'beacon_host'), None
+
+
+def battery_r(s, t, end):
+    """Internal resistance at time t, rising linearly to batteryRPeak at end / 2 and back"""
+    x = 1 - abs(2 * t / end - 1)
+    return s['batteryR'] + (s['batteryRPeak'] - s['batteryR']) * x
+
+
+def simulate(binary, s, hours, detect_dbm):
+    end = int(hours * 3600 * 1000000)
+    host = subprocess.Popen([binary, str(int(hours * 3600))], stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                            text=True, bufsize=1)
+
+    def supply_mv(t, load_ua):
+        return s['batteryMv'] - battery_r(s, t, end) * load_ua / 1000
+
+    def reply(value):
+        host.stdin.write('%d\n' % value)
+        host.stdin.flush()
+
+    period = None
+    t = 0
+    load_ua = 0
+    charge = 0  # uA * us
+    airtime = 0
+    hour_airtime = [0] * (int(hours) + 1)
+    last_detect_end = None
+    worst_gap = 0
+    brownouts = 0
+    top = {}  # strongest beep of every period
+
+    for line in host.stdout:
+        fields = line.split()
+        if fields[0] == 'I':
+            us, ua = int(fields[1]), int(fields[2])
+            held = ua <= load_ua or supply_mv(us, ua) >= s['borMv']
+            reply(1 if held else 0)
+            if not held:
+                brownouts += 1
+                continue
+            charge += load_ua * (us - t)
+            t, load_ua = us, ua
+        elif fields[0] == 'V':
+            reply(int(supply_mv(int(fields[1]), load_ua)))
+        elif fields[0] == 'TX':
+            start, length, dbm = int(fields[1]), int(fields[2]), int(fields[3])
+            airtime += length
+            hour_airtime[min(start // 3600000000, len(hour_airtime) - 1)] += length
+            if dbm >= detect_dbm:
+                if last_detect_end is not None:
+                    worst_gap = max(worst_gap, start - last_detect_end)
+                last_detect_end = start + length
+            index = start // (period * 1000)
+            top[index] = max(top.get(index, dbm), dbm)
+        elif fields[0] == 'PERIOD':
+            period = int(fields[1])
+        elif fields[0] == 'END':
+            us = int(fields[1])
+            charge += load_ua * (us - t)
+            t = us
+    if host.wait():
+        raise ValueError('firmware stopped at %.1f s' % (t / 1e6))
+    if airtime == 0:
+        raise ValueError('no transmissions')
+
+    average_ua = charge / t
+    return {
+        'airtime_s': airtime / 1e6,
+        'duty_max_pct': 100 * max(hour_airtime[:max(1, int(hours))]) / 3600e6,
+        'duty_pct': 100 * airtime / t,
+        'average_ua': average_ua,
+        'period_uah': average_ua * period / 3600000,
+        'life_h': {name: mah * 1000 / average_ua for name, mah in BATTERIES_MAH.items()},
+        'worst_gap_ms': None if last_detect_end is None else worst_gap // 1000,
+        'brownouts': brownouts,
+        'top_dbm': sum(top.values()) / len(top),
+    }
+
+
+def run_one(job):
+    settings, binary, error, hours, detect_dbm = job
+    if error:
+        return settings, None, error
+    try:
+        return settings, simulate(binary, settings, hours, detect_dbm), None
+    except ValueError as e:
+        return settings, None, str(e)
+
+
+def pareto(results):
+    """Indices not beaten on both average current and worst-case gap"""
+    front = set()
+    for i, (_, a, _) in enumerate(results):
+        if a is None or a['worst_gap_ms'] is None:
+            continue
+        dominated = False
+        for j, (_, b, _) in enumerate(results):
+            if i == j or b is None or b['worst_gap_ms'] is None:
+                continue
+            if (b['average_ua'] <= a['average_ua'] and b['worst_gap_ms'] <= a['worst_gap_ms'] and
+                    (b['average_ua'] < a['average_ua'] or b['worst_gap_ms'] < a['worst_gap_ms'])):
+                dominated = True
+                break
+        if not dominated:
+            front.add(i)
+    return front
+
+
+def parse_assignment(text):
+    name, _, value = text.partition('=')
+    if name not in SETTINGS and name not in SIM_SETTINGS:
+        sys.exit('unknown setting %s, one of: %s' % (name, ', '.join(list(SETTINGS) + list(SIM_SETTINGS))))
+    return name, value
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--set', action='append', default=[], metavar='NAME=VALUE', help='override a beacon_config.h setting')
+    parser.add_argument('--sweep', action='append', default=[], metavar='NAME=V1,V2,...', help='sweep a setting')
+    parser.add_argument('--hours', type=float, default=24, help='virtual flight time (default 24)')
+    parser.add_argument('--detect-dbm', type=int, default=-9,
+                        help='weakest beep a listener can hear, for the worst-case gap (default -9)')
+    parser.add_argument('--jobs', type=int, default=os.cpu_count(), help='parallel simulations')
+    parser.add_argument('--build-dir', default=os.path.join(tempfile.gettempdir(), 'beacon_sim'),
+                        help='host builds, one per set of firmware settings, kept for the next run')
+    args = parser.parse_args()
+
+    base = dict(SIM_SETTINGS)
+    for text in args.set:
+        name, value = parse_assignment(text)
+        base[name] = parse_value(value)
+
+    sweeps = []
+    for text in args.sweep:
+        name, values = parse_assignment(text)
+        sweeps.append([(name, parse_value(v)) for v in values.split(',')])
+
+    combos = []
+    for combo in itertools.product(*sweeps):
+        settings = dict(base)
+        settings.update(combo)
+        combos.append(settings)
+
+    # One build per set of firmware settings, then one run per combination
+    headers = [override_header(settings) for settings in combos]
+    unique = sorted(set(headers))
+    with multiprocessing.Pool(min(args.jobs, len(unique))) as pool:
+        builds = dict(zip(unique, pool.map(build, [(header, args.build_dir) for header in unique])))
+    jobs = [(settings,) + builds[header] + (args.hours, args.detect_dbm) for settings, header in zip(combos, headers)]
+    with multiprocessing.Pool(min(args.jobs, len(jobs))) as pool:
+        results = pool.map(run_one, jobs)
+    front = pareto(results)
+
+    swept = [sweep[0][0] for sweep in sweeps]
+    header = swept + ['airtime s', 'duty %', 'max duty/h %', 'avg uA', 'uAh/period'] + \
+        ['%s h' % name for name in BATTERIES_MAH] + ['worst gap ms', 'brownouts', 'avg top dBm']
+    if sweeps:
+        header.append('pareto')
+    print('\t'.join(header))
+    for i, (settings, r, error) in enumerate(results):
+        row = [str(settings[name]) for name in swept]
+        if error:
+            print('\t'.join(row + ['invalid: ' + error]))
+            continue
+        row += ['%.1f' % r['airtime_s'], '%.2f' % r['duty_pct'], '%.2f' % r['duty_max_pct'],
+                '%.0f' % r['average_ua'], '%.2f' % r['period_uah']]
+        row += ['%.0f' % r['life_h'][name] for name in BATTERIES_MAH]
+        row.append('-' if r['worst_gap_ms'] is None else str(r['worst_gap_ms']))
+        row.append(str(r['brownouts']))
+        row.append('%.1f' % r['top_dbm'])
+        if sweeps:
+            row.append('*' if i in front else '')
+        print('\t'.join(row))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+"""Decoder for the flight log printed by the console 'l' command.
+
+Capture the console output to a file (or pipe it in) and run
+
+    python3 Tools/flightlog_decode.py capture.txt
+
+Every 'L' line is one 64-bit record, see Firmware/Core/Src/flightlog.c. The
+records are printed per boot with the time since that boot, followed by a
+summary of each boot: how long it ran, the beacon cycle count, the
+supply voltage range and how it ended, as far as the reset flags of the
+following boot tell.
+"""
+
+import argparse
+import re
+import sys
+
+# FlightLogType in Firmware/Core/Inc/flightlog.h
+PAGE, BOOT, RESET, CONFIG, CYCLES, SUPPLY, LATE, DROPPED, STARTUP, FIRST_BEEP, RESUME, POWER_CAP = range(1, 13)
+
+# RCC_CSR bits 31..24, as stored in RESET records
+RESET_FLAGS = [(0x80, 'low power'), (0x40, 'window watchdog'), (0x20, 'watchdog'),
+               (0x10, 'software'), (0x08, 'brownout'), (0x04, 'reset pin'),
+               (0x02, 'option bytes'), (0x01, 'radio illegal access')]
+
+# ConfigStatus in Firmware/Core/Inc/config.h
+CONFIG_STATUS = ['ok', 'no eeprom', 'blank', 'bad version', 'bad crc', 'invalid']
+
+RECORD = re.compile(r'^L ([0-9a-fA-F]{16})\s*$')
+
+
+def crc8(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def unpack(record):
+    """(type, seconds, value), or None if the record is damaged"""
+    kind = record & 0xFF
+    if kind in (0x00, 0xFF):
+        return None
+    check = (record >> 8) & 0xFF
+    if crc8((record & ~(0xFF << 8)).to_bytes(8, 'little')) != check:
+        return None
+    return kind, (record >> 16) & 0xFFFFFF, record >> 40
+
+
+def reset_text(flags):
+    names = [name for bit, name in RESET_FLAGS if flags & bit]
+    return ', '.join(names) if names else 'none'
+
+
+def describe(kind, value):
+    if kind == BOOT:
+        return 'boot %d' % value
+    if kind == RESET:
+        return 'reset cause: %s' % reset_text(value)
+    if kind == CONFIG:
+        status = CONFIG_STATUS[value] if value < len(CONFIG_STATUS) else str(value)
+        return 'config: %s' % status
+    if kind == CYCLES:
+        return '%d beacon cycles since power-on' % value
+    if kind == SUPPLY:
+        return 'supply %d mV' % value if value else 'supply not measured'
+    if kind == LATE:
+        return 'worst beep start delay %d ms' % value
+    if kind == DROPPED:
+        return '%d records lost, RAM buffer full' % value
+    if kind == STARTUP:
+        return 'waited %d ms for the supply' % value
+    if kind == FIRST_BEEP:
+        return 'first beep %d ms after reset' % value
+    if kind == POWER_CAP:
+        return 'power ladder capped at %d dBm' % (value - 256 if value >= 128 else value)
+    if kind == RESUME:
+        return 'resumed at cycle %d' % value if value else 'resumed at the callsign'
+    return 'unknown record type %d, value %d' % (kind, value)
+
+
+def read_records(lines):
+    records = []
+    damaged = 0
+    for line in lines:
+        m = RECORD.match(line.strip())
+        if not m:
+            continue
+        fields = unpack(int(m.group(1), 16))
+        if fields is None:
+            damaged += 1
+        elif fields[0] != PAGE:
+            records.append(fields)
+    return records, damaged
+
+
+def split_boots(records):
+    boots = []
+    for kind, seconds, value in records:
+        if kind == BOOT:
+            boots.append({'number': value, 'records': []})
+        elif not boots:
+            # The start of this boot was already overwritten
+            boots.append({'number': None, 'records': []})
+        boots[-1]['records'].append((kind, seconds, value))
+    return boots
+
+
+def summary(boot, next_boot):
+    records = boot['records']
+    seconds = max((s for _, s, _ in records), default=0)
+    cycles = max((v for k, _, v in records if k == CYCLES), default=0)
+    supply = [v for k, _, v in records if k == SUPPLY and v]
+    late = max((v for k, _, v in records if k == LATE), default=0)
+    first_beep = next((v for k, _, v in records if k == FIRST_BEEP), None)
+    text = 'ran at least %d s, %d cycles since power-on' % (seconds, cycles)
+    if first_beep is not None:
+        resumed = any(k == RESUME for k, _, _ in records)
+        text += ', first beep after %d ms%s' % (first_beep, ' (resumed)' if resumed else '')
+    if supply:
+        text += ', supply %d..%d mV' % (min(supply), max(supply))
+    if late:
+        text += ', beeps up to %d ms late' % late
+    if next_boot is not None:
+        flags = next((v for k, _, v in next_boot['records'] if k == RESET), None)
+        if flags is not None:
+            text += ', ended by: %s' % reset_text(flags)
+    else:
+        text += ', last boot'
+    return text
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('capture', nargs='?', help='console capture (default stdin)')
+    parser.add_argument('--summary', action='store_true', help='only the per-boot summary')
+    args = parser.parse_args()
+
+    lines = open(args.capture).readlines() if args.capture else sys.stdin.readlines()
+    records, damaged = read_records(lines)
+    if not records:
+        sys.exit('no flight log records found')
+    boots = split_boots(records)
+
+    for i, boot in enumerate(boots):
+        name = 'boot %d' % boot['number'] if boot['number'] is not None else 'boot ? (start overwritten)'
+        next_boot = boots[i + 1] if i + 1 < len(boots) else None
+        print('%s: %s' % (name, summary(boot, next_boot)))
+        if args.summary:
+            continue
+        for kind, seconds, value in boot['records']:
+            if kind != BOOT:
+                print('  %7d s  %s' % (seconds, describe(kind, value)))
+
+    if damaged:
+        print('%d damaged records skipped (power lost while writing)' % damaged)
+
+
+if __name__ == '__main__':
+    main()
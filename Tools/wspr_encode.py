@@ -0,0 +1,399 @@
+#!/usr/bin/env python3
+"""WSPR messages encoded into a table of radio frequency words.
+
+A WSPR message (callsign, 4 character locator, power in dBm) is packed
+into 50 bits, convolutionally encoded (K=32, r=1/2) into 162 bits,
+interleaved and merged with the sync vector into 162 4-FSK symbols of
+8192/12000 s at 12000/8192 Hz (1.46 Hz) spacing, 110.6 s in all.
+
+All of that runs here. The firmware (wspr.c) only adds the entries of
+the generated table to the frequency word of the signal center and sends
+one every step from a timer interrupt. The radio's frequency step is
+32 MHz / 2^25 = 0.95 Hz, coarser than the tone spacing, so every symbol
+is WSPR_SUBSTEPS words that alternate between the two nearest steps
+(first order noise shaping, the error carries on into the next word);
+their average is the exact tone, and the alternation is far outside the
+decoder's 6 Hz.
+
+    python3 Tools/wspr_encode.py K1ABC FN42 37            print the symbols
+    python3 Tools/wspr_encode.py --write K1ABC FN42 10    regenerate Firmware/Core/Src/wsprmessage.c
+    python3 Tools/wspr_encode.py --test                   check the encoder
+    python3 Tools/wspr_encode.py --test --vectors FILE    also against reference symbols
+
+--test checks every stage against a second, independent implementation
+(the convolutional code as a GF(2) polynomial product, the interleaver
+as the explicit bit-reversal permutation), decodes the symbols back to
+the message, checks the generated words and compares the published
+symbols of K1ABC FN42 37. --vectors takes more lines of
+'<message>: <162 symbols>', e.g. from WSJT-X's wsprcode, and compares.
+
+Only type 1 messages (plain callsign up to 6 characters, 4 character
+locator) are encoded.
+"""
+
+import argparse
+import os
+import sys
+
+FIRMWARE = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'Firmware', 'Core')
+MESSAGE_C = os.path.join(FIRMWARE, 'Src', 'wsprmessage.c')
+MESSAGE_H = os.path.join(FIRMWARE, 'Inc', 'wsprmessage.h')
+
+# wspr.h
+SYMBOLS = 162
+SUBSTEPS = 16
+
+TONE_SPACING_HZ = 12000 / 8192
+FREQ_STEP_HZ = 32e6 / 2 ** 25
+
+POLY = (0xF2D05351, 0xE4613C47)
+
+SYNC = (
+    1, 1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1, 1, 0, 0, 0, 1, 0, 0, 1, 0, 1, 1, 1, 1, 0, 0, 0, 0, 0,
+    0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 0, 1, 1, 0, 1, 0,
+    0, 0, 0, 1, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 0, 1, 0, 0, 1, 0, 1, 1, 0, 0, 0, 1, 1, 0, 1, 0, 1, 0,
+    0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0, 1, 1, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0, 0, 0, 1, 1, 1,
+    0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 0, 0, 1, 1, 0,
+    0, 0,
+)
+
+# Powers a WSPR decoder reports, in dBm
+POWERS = (0, 3, 7, 10, 13, 17, 20, 23, 27, 30, 33, 37, 40, 43, 47, 50, 53, 57, 60)
+
+ALPHABET = '0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ '
+
+
+def normalize_call(call):
+    """Callsign as 6 characters with the digit in the third place"""
+    call = call.upper()
+    if len(call) >= 2 and call[1].isdigit() and not (len(call) >= 3 and call[2].isdigit()):
+        call = ' ' + call
+    if len(call) > 6 or len(call) < 3 or not call[2].isdigit():
+        raise ValueError('%s is not a plain callsign (the 2nd or 3rd character must be a digit)' % call.strip())
+    call = call.ljust(6)
+    if not all(c in ALPHABET for c in call[:2]) or not all(c.isalpha() or c == ' ' for c in call[3:]) or \
+            call[1] == ' ':
+        raise ValueError('%s is not a plain callsign' % call.strip())
+    return call
+
+
+def pack_call(call):
+    call = normalize_call(call)
+    n = ALPHABET.index(call[0])
+    n = n * 36 + ALPHABET.index(call[1])
+    n = n * 10 + ALPHABET.index(call[2])
+    for c in call[3:]:
+        n = n * 27 + (26 if c == ' ' else ord(c) - ord('A'))
+    return n
+
+
+def pack_grid_power(grid, dbm):
+    grid = grid.upper()
+    if len(grid) != 4 or not ('A' <= grid[0] <= 'R' and 'A' <= grid[1] <= 'R' and
+                              grid[2].isdigit() and grid[3].isdigit()):
+        raise ValueError('%s is not a 4 character locator' % grid)
+    if dbm not in POWERS:
+        raise ValueError('WSPR powers are %s dBm' % ', '.join(map(str, POWERS)))
+    lon = ord(grid[0]) - ord('A')
+    lat = ord(grid[1]) - ord('A')
+    m = (179 - 10 * lon - int(grid[2])) * 180 + 10 * lat + int(grid[3])
+    return m * 128 + dbm + 64
+
+
+def source_bits(call, grid, dbm):
+    """The 50 message bits, MSB first"""
+    value = pack_call(call) << 22 | pack_grid_power(grid, dbm)
+    return [(value >> (49 - i)) & 1 for i in range(50)]
+
+
+def parity(x):
+    return bin(x).count('1') & 1
+
+
+def convolve(bits):
+    """Rate 1/2 code over the message and 31 zero tail bits, 162 bits"""
+    out = []
+    reg = 0
+    for bit in bits + [0] * 31:
+        reg = (reg << 1 | bit) & 0xFFFFFFFF
+        out += [parity(reg & POLY[0]), parity(reg & POLY[1])]
+    return out
+
+
+def bit_reverse8(i):
+    return int('{:08b}'.format(i)[::-1], 2)
+
+
+def interleave(bits):
+    out = [0] * SYMBOLS
+    p = 0
+    for i in range(256):
+        j = bit_reverse8(i)
+        if j < SYMBOLS:
+            out[j] = bits[p]
+            p += 1
+    return out
+
+
+def encode(call, grid, dbm):
+    data = interleave(convolve(source_bits(call, grid, dbm)))
+    return [SYNC[i] + 2 * data[i] for i in range(SYMBOLS)]
+
+
+def words(symbols):
+    """Frequency word offsets from the signal center, SUBSTEPS per symbol"""
+    out = []
+    error = 0.0
+    for symbol in symbols:
+        target = (symbol - 1.5) * TONE_SPACING_HZ / FREQ_STEP_HZ
+        for _ in range(SUBSTEPS):
+            word = round(target + error)
+            error += target - word
+            out.append(word)
+    return out
+
+
+# --- Checks ---
+
+def reference_convolve(bits):
+    """The code as the product of the message and the generator polynomials
+    over GF(2): output j is the sum of bits[j - k] for every tap k"""
+    taps = [[k for k in range(32) if poly >> k & 1] for poly in POLY]
+    bits = bits + [0] * 31
+    out = []
+    for j in range(len(bits)):
+        for t in taps:
+            out.append(sum(bits[j - k] for k in t if j - k >= 0) & 1)
+    return out
+
+
+def reference_interleave(bits):
+    """Slot j holds the bit numbered by how many of the 8 bit indices below
+    bit_reverse8(j) land in a slot (bit_reverse8(i) < 162)"""
+    out = []
+    for j in range(SYMBOLS):
+        rank = sum(1 for i in range(bit_reverse8(j)) if bit_reverse8(i) < SYMBOLS)
+        out.append(bits[rank])
+    return out
+
+
+def decode(symbols):
+    """Message back from noiseless symbols: undo the sync, the interleaver
+    and the code (each bit is the one that reproduces the first output of
+    its step), then unpack"""
+    for i, s in enumerate(symbols):
+        if s & 1 != SYNC[i]:
+            raise ValueError('symbol %d does not match the sync vector' % i)
+    data = [s >> 1 for s in symbols]
+    coded = []
+    for i in range(256):
+        j = bit_reverse8(i)
+        if j < SYMBOLS:
+            coded.append(data[j])
+    bits = []
+    reg = 0
+    for step in range(81):
+        reg = (reg << 1) & 0xFFFFFFFF
+        if parity(reg & POLY[0]) != coded[2 * step]:
+            reg |= 1
+        if parity(reg & POLY[1]) != coded[2 * step + 1]:
+            raise ValueError('not a code word at bit %d' % step)
+        bits.append(reg & 1)
+    if any(bits[50:]):
+        raise ValueError('tail bits are not zero')
+    value = 0
+    for bit in bits[:50]:
+        value = value << 1 | bit
+    n, m = value >> 22, value & 0x3FFFFF
+    letters = []
+    for _ in range(3):
+        n, c = divmod(n, 27)
+        letters.append(' ' if c == 26 else chr(ord('A') + c))
+    n, digit = divmod(n, 10)
+    c0, c1 = divmod(n, 36)
+    call = (ALPHABET[c0] + ALPHABET[c1] + str(digit) + ''.join(reversed(letters))).strip()
+    grid_value, power = divmod(m, 128)
+    a, b = divmod(grid_value, 180)
+    lon, lon_digit = divmod(179 - a, 10)
+    lat, lat_digit = divmod(b, 10)
+    grid = chr(ord('A') + lon) + chr(ord('A') + lat) + str(lon_digit) + str(lat_digit)
+    return call, grid, power - 64
+
+
+TEST_MESSAGES = (
+    ('K1ABC', 'FN42', 37),
+    ('G4JNT', 'IO90', 30),
+    ('DL1ABC', 'JO62', 20),
+    ('PA3FWM', 'JO22', 0),
+    ('VK2ZZZ', 'QF56', 60),
+    ('Q1A', 'RR99', 3),
+)
+
+# Channel symbols published for the WSPR protocol example message, as printed
+# by wsprcode from the WSJT-X sources
+PUBLISHED_VECTORS = (
+    (('K1ABC', 'FN42', 37), (
+        3, 3, 0, 0, 2, 0, 0, 0, 1, 0, 2, 0, 1, 3, 1, 2, 2, 2, 1, 0, 0, 3, 2, 3, 1, 3, 3, 2, 2, 0, 2, 0,
+        0, 0, 3, 2, 0, 1, 2, 3, 2, 2, 0, 0, 2, 2, 3, 2, 1, 1, 0, 2, 3, 3, 2, 1, 0, 2, 2, 1, 3, 2, 1, 2,
+        2, 2, 0, 3, 3, 0, 3, 0, 3, 0, 1, 2, 1, 0, 2, 1, 2, 0, 3, 2, 1, 3, 2, 0, 0, 3, 3, 2, 3, 0, 3, 2,
+        2, 0, 3, 0, 2, 0, 2, 0, 1, 0, 2, 3, 0, 2, 1, 1, 1, 2, 3, 3, 0, 2, 3, 1, 2, 1, 2, 2, 2, 1, 3, 3,
+        2, 0, 0, 0, 0, 1, 0, 3, 2, 0, 1, 3, 2, 2, 2, 2, 2, 0, 2, 3, 3, 2, 3, 2, 3, 3, 2, 0, 0, 3, 1, 2,
+        2, 2,
+    )),
+)
+
+
+def run_tests(vectors):
+    failed = 0
+
+    def check(ok, what):
+        nonlocal failed
+        if not ok:
+            failed += 1
+            print('FAIL', what)
+
+    check(len(SYNC) == SYMBOLS, 'sync vector length %d' % len(SYNC))
+    check(sorted(bit_reverse8(i) for i in range(256)) == list(range(256)), 'bit reversal is a permutation')
+    check(sum(1 for i in range(256) if bit_reverse8(i) < SYMBOLS) == SYMBOLS, '162 interleaver slots')
+
+    # Packing, worked by hand from the protocol: ' K1ABC' is
+    # ((((36 * 36 + 20) * 10 + 1) * 27 + 0) * 27 + 1) * 27 + 2, FN42 is
+    # (179 - 10 * 5 - 4) * 180 + 10 * 13 + 2
+    check(pack_call('K1ABC') == 259047992, 'K1ABC packs to %d' % pack_call('K1ABC'))
+    check(pack_grid_power('FN42', 37) == 22632 * 128 + 37 + 64, 'FN42 37 packs to %d' % pack_grid_power('FN42', 37))
+    check(pack_call('K1ABC') == pack_call('k1abc') == pack_call(' K1ABC'), 'callsign case and padding')
+
+    for call, grid, dbm in TEST_MESSAGES:
+        text = '%s %s %d' % (call, grid, dbm)
+        bits = source_bits(call, grid, dbm)
+        coded = convolve(bits)
+        check(coded == reference_convolve(bits), text + ': convolutional code')
+        check(interleave(coded) == reference_interleave(coded), text + ': interleaver')
+        symbols = encode(call, grid, dbm)
+        check(all(0 <= s <= 3 for s in symbols) and len(symbols) == SYMBOLS, text + ': symbol range')
+        try:
+            decoded = decode(symbols)
+        except ValueError as e:
+            decoded = str(e)
+        check(decoded == (call, grid, dbm), text + ': decodes to %s' % (decoded,))
+
+        w = words(symbols)
+        for i, s in enumerate(symbols):
+            step = w[i * SUBSTEPS:(i + 1) * SUBSTEPS]
+            hz = sum(step) / SUBSTEPS * FREQ_STEP_HZ
+            if abs(hz - (s - 1.5) * TONE_SPACING_HZ) > FREQ_STEP_HZ / SUBSTEPS + 1e-9 or max(step) - min(step) > 1:
+                check(False, text + ': words of symbol %d average %.3f Hz' % (i, hz))
+                break
+        check(all(-128 <= x <= 127 for x in w), text + ': words fit int8_t')
+
+    for (call, grid, dbm), expected in PUBLISHED_VECTORS:
+        check(encode(call, grid, dbm) == list(expected), '%s %s %d: published symbols' % (call, grid, dbm))
+
+    for bad in (('ABC', 'FN42', 10), ('K1ABCD', 'FN42', 10), ('K1ABC', 'FN4', 10),
+                ('K1ABC', 'SN42', 10), ('K1ABC', 'FN42', 11)):
+        try:
+            encode(*bad)
+            check(False, '%s %s %d is refused' % bad)
+        except ValueError:
+            pass
+
+    if vectors:
+        count = 0
+        with open(vectors) as f:
+            for line in f:
+                if ':' not in line:
+                    continue
+                message, symbols = line.split(':', 1)
+                call, grid, dbm = message.split()
+                expected = [int(s) for s in symbols.replace(',', ' ').split()]
+                check(encode(call, grid, int(dbm)) == expected, message.strip() + ': reference symbols')
+                count += 1
+        print('%d reference vectors' % count)
+
+    print('%d checks failed' % failed if failed else 'all checks passed')
+    return failed == 0
+
+
+def write_c(call, grid, dbm, symbols):
+    w = words(symbols)
+    text = '%s %s %d' % (normalize_call(call).strip(), grid.upper(), dbm)
+    out = ['/**',
+           '  ******************************************************************************',
+           '  * @file           : wsprmessage.c',
+           '  * @brief          : WSPR message as radio frequency words.',
+           '  ******************************************************************************',
+           '  * Generated by Tools/wspr_encode.py, do not edit. Regenerate with',
+           '  *     python3 Tools/wspr_encode.py --write %s' % text,
+           '  */',
+           '',
+           '#include "wsprmessage.h"',
+           '',
+           '// Symbols: ' + ''.join(map(str, symbols[:81])),
+           '//          ' + ''.join(map(str, symbols[81:])),
+           'static const int8_t wsprMessageWords[WSPR_SYMBOLS * WSPR_SUBSTEPS] = {']
+    for i in range(SYMBOLS):
+        out.append('    ' + ' '.join('%d,' % x for x in w[i * SUBSTEPS:(i + 1) * SUBSTEPS]))
+    out += ['};',
+            '',
+            'const WsprMessage wsprMessage = {"%s", wsprMessageWords, %d};' % (text, dbm),
+            '']
+    with open(MESSAGE_C, 'w') as f:
+        f.write('\n'.join(out))
+
+    header = ['/**',
+              '  ******************************************************************************',
+              '  * @file           : wsprmessage.h',
+              '  * @brief          : WSPR message as radio frequency words.',
+              '  ******************************************************************************',
+              '  * Generated by Tools/wspr_encode.py, do not edit.',
+              '  */',
+              '',
+              '#ifndef __WSPRMESSAGE_H',
+              '#define __WSPRMESSAGE_H',
+              '',
+              '#ifdef __cplusplus',
+              'extern "C" {',
+              '#endif',
+              '',
+              '#include "wspr.h"',
+              '',
+              'extern const WsprMessage wsprMessage;',
+              '',
+              '#ifdef __cplusplus',
+              '}',
+              '#endif',
+              '',
+              '#endif /* __WSPRMESSAGE_H */',
+              '']
+    with open(MESSAGE_H, 'w') as f:
+        f.write('\n'.join(header))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('message', nargs='*', help='callsign, locator and power in dBm, e.g. K1ABC FN42 10')
+    parser.add_argument('--write', action='store_true', help='write wsprmessage.c and wsprmessage.h')
+    parser.add_argument('--test', action='store_true', help='check the encoder')
+    parser.add_argument('--vectors', metavar='FILE', help="with --test, lines of '<message>: <symbols>' to compare")
+    args = parser.parse_args()
+
+    if args.test:
+        sys.exit(0 if run_tests(args.vectors) else 1)
+    if len(args.message) != 3:
+        parser.error('give a callsign, a locator and a power, e.g. K1ABC FN42 10')
+    call, grid, dbm = args.message[0], args.message[1], int(args.message[2])
+    try:
+        symbols = encode(call, grid, dbm)
+    except ValueError as e:
+        sys.exit(e)
+    if dbm > 22:
+        print('warning: the radio sends at most 22 dBm, the message says %d' % dbm)
+    print(' '.join(map(str, symbols)))
+
+    if args.write:
+        write_c(call, grid, dbm, symbols)
+        print('wrote %s and %s' % (os.path.relpath(MESSAGE_C), os.path.relpath(MESSAGE_H)))
+
+
+if __name__ == '__main__':
+    main()